@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CAPABILITY_PAGE_READER_H
+#define CAPABILITY_PAGE_READER_H
+
+#include <memory>
+#include <mutex>
+
+#include "ashmem.h"
+#include "nocopyable.h"
+
+#include "capability_page.h"
+#include "i_miscdevice_service.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Client view of the capability page. The parsed snapshot is kept until the page
+ * generation moves, so repeated queries only compare the generation and skip IPC.
+ */
+class CapabilityPageReader {
+public:
+    CapabilityPageReader() = default;
+    ~CapabilityPageReader();
+    int32_t Map(const sptr<IMiscdeviceService> &proxy);
+    void Unmap();
+    std::shared_ptr<const CapabilitySnapshot> GetSnapshot();
+
+private:
+    DISALLOW_COPY_AND_MOVE(CapabilityPageReader);
+    void UnmapLocked();
+    std::mutex pageMutex_;
+    sptr<Ashmem> ashmem_ = nullptr;
+    const CapabilityPageLayout *page_ = nullptr;
+    std::shared_ptr<const CapabilitySnapshot> snapshot_ = nullptr;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // CAPABILITY_PAGE_READER_H
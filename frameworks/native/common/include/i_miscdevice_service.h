@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "ashmem.h"
 #include "iremote_broker.h"
 
 #include "light_agent_type.h"
@@ -55,6 +56,10 @@ public:
     virtual int32_t PlayPrimitiveEffect(int32_t vibratorId, const std::string &effect, int32_t intensity,
         int32_t usage) = 0;
     virtual int32_t GetVibratorCapacity(VibratorCapacity &capacity) = 0;
+    virtual int32_t RegisterEffect(const VibratePackage &package, int32_t &handle) = 0;
+    virtual int32_t PlayEffectHandle(int32_t handle, int32_t usage, const VibrateParameter &parameter) = 0;
+    virtual int32_t ReleaseEffect(int32_t handle) = 0;
+    virtual int32_t GetCapabilityPage(sptr<Ashmem> &ashmem) = 0;
 };
 }  // namespace Sensors
 }  // namespace OHOS
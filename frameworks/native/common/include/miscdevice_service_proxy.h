@@ -47,6 +47,10 @@ public:
     virtual int32_t PlayPrimitiveEffect(int32_t vibratorId, const std::string &effect, int32_t intensity,
         int32_t usage) override;
     virtual int32_t GetVibratorCapacity(VibratorCapacity &capacity) override;
+    virtual int32_t RegisterEffect(const VibratePackage &package, int32_t &handle) override;
+    virtual int32_t PlayEffectHandle(int32_t handle, int32_t usage, const VibrateParameter &parameter) override;
+    virtual int32_t ReleaseEffect(int32_t handle) override;
+    virtual int32_t GetCapabilityPage(sptr<Ashmem> &ashmem) override;
 
 private:
     DISALLOW_COPY_AND_MOVE(MiscdeviceServiceProxy);
@@ -36,6 +36,10 @@ enum class MiscdeviceInterfaceCode {
     TRANSFER_CLIENT_REMOTE_OBJECT,
     PLAY_PRIMITIVE_EFFECT,
     GET_VIBRATOR_CAPACITY,
+    REGISTER_EFFECT,
+    PLAY_EFFECT_HANDLE,
+    RELEASE_EFFECT,
+    GET_CAPABILITY_PAGE,
 };
 }  // namespace Sensors
 }  // namespace OHOS
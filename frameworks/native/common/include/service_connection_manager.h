@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERVICE_CONNECTION_MANAGER_H
+#define SERVICE_CONNECTION_MANAGER_H
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "iremote_object.h"
+#include "nocopyable.h"
+#include "system_ability_status_change_stub.h"
+
+#include "i_miscdevice_service.h"
+
+namespace OHOS {
+namespace Sensors {
+using ServiceRequest = std::function<int32_t(const sptr<IMiscdeviceService> &proxy)>;
+
+enum class PendingRequestPolicy {
+    DROP = 0,
+    FLUSH = 1,
+};
+
+class IServiceConnectionListener {
+public:
+    IServiceConnectionListener() = default;
+    virtual ~IServiceConnectionListener() = default;
+    virtual void OnServiceConnected(const sptr<IMiscdeviceService> &proxy) = 0;
+    virtual void OnServiceDisconnected() = 0;
+};
+
+/*
+ * Connection to the miscdevice service shared by the vibrator and light clients. It never
+ * sleeps waiting for the service: when the service is down, calls fail fast and the
+ * connection is re-established from the system-ability-added notification.
+ */
+class ServiceConnectionManager {
+public:
+    // Queued requests older than this are dropped on reconnect instead of being replayed.
+    static constexpr int64_t PENDING_REQUEST_TIMEOUT_MS = 3000;
+    static constexpr size_t MAX_PENDING_REQUEST_COUNT = 16;
+    // Function-local instance, so it outlives every client singleton that registered with it.
+    static ServiceConnectionManager &GetInstance();
+    virtual ~ServiceConnectionManager();
+    int32_t Connect();
+    sptr<IMiscdeviceService> GetProxy() const;
+    void AddListener(IServiceConnectionListener *listener);
+    void RemoveListener(IServiceConnectionListener *listener);
+    // Returns MISC_NATIVE_REQUEST_DEFERRED when the request was queued for the next connection.
+    int32_t PostRequest(ServiceRequest request);
+    void SetPendingRequestPolicy(PendingRequestPolicy policy);
+    void ProcessDeathObserver(const wptr<IRemoteObject> &object);
+
+protected:
+    ServiceConnectionManager() = default;
+    virtual int32_t SubscribeLocked();
+    virtual sptr<IRemoteObject> CheckService();
+
+private:
+    DISALLOW_COPY_AND_MOVE(ServiceConnectionManager);
+    class SystemAbilityListener : public SystemAbilityStatusChangeStub {
+    public:
+        SystemAbilityListener() = default;
+        ~SystemAbilityListener() override = default;
+        void OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
+        void OnRemoveSystemAbility(int32_t systemAbilityId, const std::string &deviceId) override;
+    };
+    struct ServiceHandle {
+        sptr<IMiscdeviceService> proxy = nullptr;
+    };
+    struct PendingRequest {
+        ServiceRequest request;
+        std::chrono::steady_clock::time_point postTime;
+    };
+    void Disconnect(const sptr<IRemoteObject> &remoteObject);
+    void NotifyConnected(const sptr<IMiscdeviceService> &proxy);
+    void NotifyDisconnected();
+    int32_t QueueRequestLocked(ServiceRequest request);
+    void FlushPendingRequestsLocked(const sptr<IMiscdeviceService> &proxy);
+    // Published with atomic_store once connected, so the connected path never takes a lock.
+    // Published under pendingMutex_ as well, right after the queued requests are replayed.
+    std::shared_ptr<const ServiceHandle> handle_ = nullptr;
+    std::mutex connectMutex_;
+    sptr<SystemAbilityListener> saListener_ = nullptr;
+    sptr<IRemoteObject::DeathRecipient> serviceDeathObserver_ = nullptr;
+    std::mutex listenerMutex_;
+    std::vector<IServiceConnectionListener *> listeners_;
+    std::mutex pendingMutex_;
+    std::deque<PendingRequest> pendingRequests_;
+    std::atomic<PendingRequestPolicy> pendingPolicy_ = PendingRequestPolicy::FLUSH;
+};
+#define ServiceConnection ServiceConnectionManager::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // SERVICE_CONNECTION_MANAGER_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "capability_page_reader.h"
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "CapabilityPageReader"
+
+namespace OHOS {
+namespace Sensors {
+CapabilityPageReader::~CapabilityPageReader()
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    UnmapLocked();
+}
+
+int32_t CapabilityPageReader::Map(const sptr<IMiscdeviceService> &proxy)
+{
+    CHKPR(proxy, ERROR);
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    UnmapLocked();
+    sptr<Ashmem> ashmem = nullptr;
+    int32_t ret = proxy->GetCapabilityPage(ashmem);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("GetCapabilityPage failed, ret:%{public}d", ret);
+        return ret;
+    }
+    CHKPR(ashmem, ERROR);
+    if (ashmem->GetAshmemSize() < static_cast<int32_t>(sizeof(CapabilityPageLayout))) {
+        MISC_HILOGE("Capability page too small, size:%{public}d", ashmem->GetAshmemSize());
+        ashmem->CloseAshmem();
+        return ERROR;
+    }
+    if (!ashmem->MapReadOnlyAshmem()) {
+        MISC_HILOGE("Map capability page failed");
+        ashmem->CloseAshmem();
+        return ERROR;
+    }
+    const void *addr = ashmem->ReadFromAshmem(sizeof(CapabilityPageLayout), 0);
+    if (addr == nullptr) {
+        MISC_HILOGE("Read capability page failed");
+        ashmem->UnmapAshmem();
+        ashmem->CloseAshmem();
+        return ERROR;
+    }
+    ashmem_ = ashmem;
+    page_ = static_cast<const CapabilityPageLayout *>(addr);
+    return ERR_OK;
+}
+
+void CapabilityPageReader::Unmap()
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    UnmapLocked();
+}
+
+void CapabilityPageReader::UnmapLocked()
+{
+    page_ = nullptr;
+    snapshot_ = nullptr;
+    if (ashmem_ != nullptr) {
+        ashmem_->UnmapAshmem();
+        ashmem_->CloseAshmem();
+        ashmem_ = nullptr;
+    }
+}
+
+std::shared_ptr<const CapabilitySnapshot> CapabilityPageReader::GetSnapshot()
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    if (page_ == nullptr) {
+        return nullptr;
+    }
+    if ((snapshot_ != nullptr) && (snapshot_->generation == GetCapabilityPageGeneration(*page_))) {
+        return snapshot_;
+    }
+    std::optional<CapabilitySnapshot> snapshot = ReadCapabilityPage(*page_);
+    if (!snapshot.has_value()) {
+        return nullptr;
+    }
+    snapshot_ = std::make_shared<const CapabilitySnapshot>(std::move(snapshot.value()));
+    return snapshot_;
+}
+}  // namespace Sensors
+}  // namespace OHOS
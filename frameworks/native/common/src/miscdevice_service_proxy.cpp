@@ -366,8 +366,15 @@ int32_t MiscdeviceServiceProxy::PlayPattern(const VibratePattern &pattern, int32
         MISC_HILOGE("Write descriptor failed");
         return WRITE_MSG_ERR;
     }
-    if (!pattern.Marshalling(data)) {
-        MISC_HILOGE("Marshalling failed");
+    std::vector<uint8_t> buffer;
+    if (!pattern.Encode(buffer)) {
+        MISC_HILOGE("Encode pattern failed");
+        return WRITE_MSG_ERR;
+    }
+    // WriteRawData keeps small patterns inline and moves large ones to ashmem.
+    if ((!data.WriteUint32(static_cast<uint32_t>(buffer.size()))) ||
+        (!data.WriteRawData(buffer.data(), buffer.size()))) {
+        MISC_HILOGE("Write pattern failed");
         return WRITE_MSG_ERR;
     }
     if (!data.WriteInt32(usage)) {
@@ -482,5 +489,120 @@ int32_t MiscdeviceServiceProxy::GetVibratorCapacity(VibratorCapacity &capacity)
     capacity = vibratorCapacity.value();
     return ret;
 }
+
+int32_t MiscdeviceServiceProxy::RegisterEffect(const VibratePackage &package, int32_t &handle)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(MiscdeviceServiceProxy::GetDescriptor())) {
+        MISC_HILOGE("Write descriptor failed");
+        return WRITE_MSG_ERR;
+    }
+    if (!package.Marshalling(data)) {
+        MISC_HILOGE("Marshalling package failed");
+        return WRITE_MSG_ERR;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    CHKPR(remote, ERROR);
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(static_cast<uint32_t>(MiscdeviceInterfaceCode::REGISTER_EFFECT),
+        data, reply, option);
+    if (ret != NO_ERROR) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_IPC_EXCEPTION",
+            HiSysEvent::EventType::FAULT, "PKG_NAME", "RegisterEffect", "ERROR_CODE", ret);
+        MISC_HILOGE("SendRequest failed, ret:%{public}d", ret);
+        return ret;
+    }
+    if (!reply.ReadInt32(handle)) {
+        MISC_HILOGE("Parcel read handle failed");
+        return ERROR;
+    }
+    return ret;
+}
+
+int32_t MiscdeviceServiceProxy::PlayEffectHandle(int32_t handle, int32_t usage, const VibrateParameter &parameter)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(MiscdeviceServiceProxy::GetDescriptor())) {
+        MISC_HILOGE("Write descriptor failed");
+        return WRITE_MSG_ERR;
+    }
+    if (!data.WriteInt32(handle)) {
+        MISC_HILOGE("WriteInt32 handle failed");
+        return WRITE_MSG_ERR;
+    }
+    if (!data.WriteInt32(usage)) {
+        MISC_HILOGE("WriteInt32 usage failed");
+        return WRITE_MSG_ERR;
+    }
+    if (!parameter.Marshalling(data)) {
+        MISC_HILOGE("Write adjust parameter failed");
+        return WRITE_MSG_ERR;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    CHKPR(remote, ERROR);
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(static_cast<uint32_t>(MiscdeviceInterfaceCode::PLAY_EFFECT_HANDLE),
+        data, reply, option);
+    if (ret != NO_ERROR) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_IPC_EXCEPTION",
+            HiSysEvent::EventType::FAULT, "PKG_NAME", "PlayEffectHandle", "ERROR_CODE", ret);
+        MISC_HILOGE("SendRequest failed, ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t MiscdeviceServiceProxy::ReleaseEffect(int32_t handle)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(MiscdeviceServiceProxy::GetDescriptor())) {
+        MISC_HILOGE("Write descriptor failed");
+        return WRITE_MSG_ERR;
+    }
+    if (!data.WriteInt32(handle)) {
+        MISC_HILOGE("WriteInt32 handle failed");
+        return WRITE_MSG_ERR;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    CHKPR(remote, ERROR);
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(static_cast<uint32_t>(MiscdeviceInterfaceCode::RELEASE_EFFECT),
+        data, reply, option);
+    if (ret != NO_ERROR) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_IPC_EXCEPTION",
+            HiSysEvent::EventType::FAULT, "PKG_NAME", "ReleaseEffect", "ERROR_CODE", ret);
+        MISC_HILOGE("SendRequest failed, ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t MiscdeviceServiceProxy::GetCapabilityPage(sptr<Ashmem> &ashmem)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(MiscdeviceServiceProxy::GetDescriptor())) {
+        MISC_HILOGE("Write descriptor failed");
+        return WRITE_MSG_ERR;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    CHKPR(remote, ERROR);
+    MessageParcel reply;
+    MessageOption option;
+    int32_t ret = remote->SendRequest(static_cast<uint32_t>(MiscdeviceInterfaceCode::GET_CAPABILITY_PAGE),
+        data, reply, option);
+    if (ret != NO_ERROR) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_IPC_EXCEPTION",
+            HiSysEvent::EventType::FAULT, "PKG_NAME", "GetCapabilityPage", "ERROR_CODE", ret);
+        MISC_HILOGE("SendRequest failed, ret:%{public}d", ret);
+        return ret;
+    }
+    ashmem = reply.ReadAshmem();
+    if (ashmem == nullptr) {
+        MISC_HILOGE("Parcel read ashmem failed");
+        return READ_MSG_ERR;
+    }
+    return NO_ERROR;
+}
 }  // namespace Sensors
 }  // namespace OHOS
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "service_connection_manager.h"
+
+#include <algorithm>
+
+#include "hisysevent.h"
+#include "iservice_registry.h"
+#include "system_ability_definition.h"
+
+#include "death_recipient_template.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "ServiceConnectionManager"
+
+namespace OHOS {
+namespace Sensors {
+using namespace OHOS::HiviewDFX;
+
+ServiceConnectionManager &ServiceConnectionManager::GetInstance()
+{
+    static ServiceConnectionManager instance;
+    return instance;
+}
+
+ServiceConnectionManager::~ServiceConnectionManager()
+{
+    std::shared_ptr<const ServiceHandle> handle = std::atomic_load(&handle_);
+    if ((handle != nullptr) && (handle->proxy != nullptr) && (serviceDeathObserver_ != nullptr)) {
+        auto remoteObject = handle->proxy->AsObject();
+        if (remoteObject != nullptr) {
+            remoteObject->RemoveDeathRecipient(serviceDeathObserver_);
+        }
+    }
+}
+
+int32_t ServiceConnectionManager::Connect()
+{
+    if (std::atomic_load(&handle_) != nullptr) {
+        return ERR_OK;
+    }
+    sptr<IMiscdeviceService> proxy = nullptr;
+    {
+        std::lock_guard<std::mutex> connectLock(connectMutex_);
+        if (std::atomic_load(&handle_) != nullptr) {
+            return ERR_OK;
+        }
+        int32_t ret = SubscribeLocked();
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        sptr<IRemoteObject> remoteObject = CheckService();
+        if (remoteObject == nullptr) {
+            MISC_HILOGW("Miscdevice service is not available yet");
+            return MISC_NATIVE_SERVICE_UNAVAILABLE_ERR;
+        }
+        proxy = iface_cast<IMiscdeviceService>(remoteObject);
+        CHKPR(proxy, MISC_NATIVE_GET_SERVICE_ERR);
+        if (serviceDeathObserver_ == nullptr) {
+            serviceDeathObserver_ =
+                new (std::nothrow) DeathRecipientTemplate(*const_cast<ServiceConnectionManager *>(this));
+            CHKPR(serviceDeathObserver_, MISC_NATIVE_GET_SERVICE_ERR);
+        }
+        remoteObject->AddDeathRecipient(serviceDeathObserver_);
+        // PostRequest checks the handle under pendingMutex_ before it queues. Replaying and publishing
+        // under the same lock means no request is queued after the replay, and none posted later
+        // overtakes a queued one.
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        FlushPendingRequestsLocked(proxy);
+        auto handle = std::make_shared<ServiceHandle>();
+        handle->proxy = proxy;
+        std::atomic_store(&handle_, std::shared_ptr<const ServiceHandle>(std::move(handle)));
+    }
+    MISC_HILOGI("Miscdevice service connected");
+    NotifyConnected(proxy);
+    return ERR_OK;
+}
+
+sptr<IMiscdeviceService> ServiceConnectionManager::GetProxy() const
+{
+    std::shared_ptr<const ServiceHandle> handle = std::atomic_load(&handle_);
+    return (handle == nullptr) ? nullptr : handle->proxy;
+}
+
+void ServiceConnectionManager::AddListener(IServiceConnectionListener *listener)
+{
+    CHKPV(listener);
+    std::lock_guard<std::mutex> listenerLock(listenerMutex_);
+    if (std::find(listeners_.begin(), listeners_.end(), listener) == listeners_.end()) {
+        listeners_.push_back(listener);
+    }
+}
+
+void ServiceConnectionManager::RemoveListener(IServiceConnectionListener *listener)
+{
+    std::lock_guard<std::mutex> listenerLock(listenerMutex_);
+    listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener), listeners_.end());
+}
+
+int32_t ServiceConnectionManager::PostRequest(ServiceRequest request)
+{
+    CHKPR(request, ERROR);
+    int32_t ret = Connect();
+    if (ret != ERR_OK) {
+        MISC_HILOGD("Connect service failed, ret:%{public}d", ret);
+    }
+    sptr<IMiscdeviceService> proxy = GetProxy();
+    if (proxy == nullptr) {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        proxy = GetProxy();
+        if (proxy == nullptr) {
+            return QueueRequestLocked(std::move(request));
+        }
+    }
+    return request(proxy);
+}
+
+void ServiceConnectionManager::SetPendingRequestPolicy(PendingRequestPolicy policy)
+{
+    pendingPolicy_.store(policy);
+    if (policy == PendingRequestPolicy::DROP) {
+        std::lock_guard<std::mutex> pendingLock(pendingMutex_);
+        pendingRequests_.clear();
+    }
+}
+
+void ServiceConnectionManager::ProcessDeathObserver(const wptr<IRemoteObject> &object)
+{
+    CALL_LOG_ENTER;
+    Disconnect(object.promote());
+}
+
+sptr<IRemoteObject> ServiceConnectionManager::CheckService()
+{
+    auto systemManager = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    CHKPP(systemManager);
+    // CheckSystemAbility does not wait for the service to start, unlike GetSystemAbility.
+    return systemManager->CheckSystemAbility(MISCDEVICE_SERVICE_ABILITY_ID);
+}
+
+int32_t ServiceConnectionManager::SubscribeLocked()
+{
+    if (saListener_ != nullptr) {
+        return ERR_OK;
+    }
+    auto systemManager = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    CHKPR(systemManager, MISC_NATIVE_SAM_ERR);
+    sptr<SystemAbilityListener> saListener = new (std::nothrow) SystemAbilityListener();
+    CHKPR(saListener, MISC_NATIVE_SAM_ERR);
+    int32_t ret = systemManager->SubscribeSystemAbility(MISCDEVICE_SERVICE_ABILITY_ID, saListener);
+    if (ret != ERR_OK) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_EXCEPTION",
+            HiSysEvent::EventType::FAULT, "PKG_NAME", "SubscribeSystemAbility", "ERROR_CODE", ret);
+        MISC_HILOGE("SubscribeSystemAbility failed, ret:%{public}d", ret);
+        return MISC_NATIVE_SAM_ERR;
+    }
+    saListener_ = saListener;
+    return ERR_OK;
+}
+
+void ServiceConnectionManager::Disconnect(const sptr<IRemoteObject> &remoteObject)
+{
+    {
+        std::lock_guard<std::mutex> connectLock(connectMutex_);
+        std::shared_ptr<const ServiceHandle> handle = std::atomic_load(&handle_);
+        if (handle == nullptr) {
+            return;
+        }
+        if ((remoteObject != nullptr) && (serviceDeathObserver_ != nullptr)) {
+            remoteObject->RemoveDeathRecipient(serviceDeathObserver_);
+        }
+        std::atomic_store(&handle_, std::shared_ptr<const ServiceHandle>());
+    }
+    MISC_HILOGW("Miscdevice service disconnected");
+    NotifyDisconnected();
+}
+
+void ServiceConnectionManager::NotifyConnected(const sptr<IMiscdeviceService> &proxy)
+{
+    std::vector<IServiceConnectionListener *> listeners;
+    {
+        std::lock_guard<std::mutex> listenerLock(listenerMutex_);
+        listeners = listeners_;
+    }
+    for (auto listener : listeners) {
+        listener->OnServiceConnected(proxy);
+    }
+}
+
+void ServiceConnectionManager::NotifyDisconnected()
+{
+    std::vector<IServiceConnectionListener *> listeners;
+    {
+        std::lock_guard<std::mutex> listenerLock(listenerMutex_);
+        listeners = listeners_;
+    }
+    for (auto listener : listeners) {
+        listener->OnServiceDisconnected();
+    }
+}
+
+int32_t ServiceConnectionManager::QueueRequestLocked(ServiceRequest request)
+{
+    if (pendingPolicy_.load() == PendingRequestPolicy::DROP) {
+        MISC_HILOGW("Service unavailable, request dropped");
+        return MISC_NATIVE_SERVICE_UNAVAILABLE_ERR;
+    }
+    if (pendingRequests_.size() >= MAX_PENDING_REQUEST_COUNT) {
+        MISC_HILOGW("Too many pending requests, drop the oldest one");
+        pendingRequests_.pop_front();
+    }
+    pendingRequests_.push_back({ .request = std::move(request), .postTime = std::chrono::steady_clock::now() });
+    MISC_HILOGI("Service unavailable, request queued, pending:%{public}zu", pendingRequests_.size());
+    return MISC_NATIVE_REQUEST_DEFERRED;
+}
+
+void ServiceConnectionManager::FlushPendingRequestsLocked(const sptr<IMiscdeviceService> &proxy)
+{
+    auto now = std::chrono::steady_clock::now();
+    for (auto &pending : pendingRequests_) {
+        if (now - pending.postTime > std::chrono::milliseconds(PENDING_REQUEST_TIMEOUT_MS)) {
+            MISC_HILOGW("Pending request expired, dropped");
+            continue;
+        }
+        int32_t ret = pending.request(proxy);
+        if (ret != ERR_OK) {
+            MISC_HILOGW("Pending request failed, ret:%{public}d", ret);
+        }
+    }
+    pendingRequests_.clear();
+}
+
+void ServiceConnectionManager::SystemAbilityListener::OnAddSystemAbility(int32_t systemAbilityId,
+    const std::string &deviceId)
+{
+    (void)deviceId;
+    if (systemAbilityId != MISCDEVICE_SERVICE_ABILITY_ID) {
+        return;
+    }
+    int32_t ret = ServiceConnection.Connect();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("Connect service failed, ret:%{public}d", ret);
+    }
+}
+
+void ServiceConnectionManager::SystemAbilityListener::OnRemoveSystemAbility(int32_t systemAbilityId,
+    const std::string &deviceId)
+{
+    (void)deviceId;
+    if (systemAbilityId != MISCDEVICE_SERVICE_ABILITY_ID) {
+        return;
+    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    ServiceConnection.Disconnect((proxy == nullptr) ? nullptr : proxy->AsObject());
+}
+}  // namespace Sensors
+}  // namespace OHOS
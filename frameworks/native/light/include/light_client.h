@@ -16,35 +16,45 @@
 #ifndef LIGHT_CLIENT_H
 #define LIGHT_CLIENT_H
 
+#include <atomic>
 #include <mutex>
 
 #include "iremote_object.h"
-#include "miscdevice_service_proxy.h"
 #include "singleton.h"
 
+#include "capability_page_reader.h"
+#include "miscdevice_service_proxy.h"
+#include "service_connection_manager.h"
+
 namespace OHOS {
 namespace Sensors {
-class LightClient : public Singleton<LightClient> {
+class LightClient : public Singleton<LightClient>, public IServiceConnectionListener {
 public:
     ~LightClient() override;
     int32_t GetLightList(LightInfo **lightInfo, int32_t &count);
     int32_t TurnOn(int32_t lightId, const LightColor &color, const LightAnimation &animation);
     int32_t TurnOff(int32_t lightId);
-    void ProcessDeathObserver(wptr<IRemoteObject> object);
+    void OnServiceConnected(const sptr<IMiscdeviceService> &proxy) override;
+    void OnServiceDisconnected() override;
 
 private:
     bool IsValid(int32_t lightId);
     void ClearLightInfos();
     int32_t ConvertLightInfos();
     int32_t InitLightClient();
+    void SetupServiceLocked(const sptr<IMiscdeviceService> &proxy);
+    void UpdateLightInfoListLocked();
     bool IsLightAnimationValid(const LightAnimation &animation);
     bool IsLightIdValid(int32_t lightId);
     std::mutex lightInfosMutex_;
     LightInfo *lightInfos_ {nullptr};
     int32_t lightInfoCount_ {-1};
-    sptr<IRemoteObject::DeathRecipient> serviceDeathObserver_ = nullptr;
-    sptr<IMiscdeviceService> miscdeviceProxy_ = nullptr;
+    std::atomic<bool> serviceReady_ = false;
+    // Guards lightInfoList_, which OnServiceConnected rewrites on a binder thread.
+    std::mutex lightInfoListMutex_;
     std::vector<LightInfoIPC> lightInfoList_;
+    uint32_t lightInfoListGeneration_ = 0;
+    CapabilityPageReader capabilityPage_;
     std::mutex clientMutex_;
 };
 }  // namespace Sensors
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIGHT_ERR_CODE_H
+#define LIGHT_ERR_CODE_H
+
+#include <cstdint>
+
+#include "sensors_errors.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Maps a client result to the codes the light APIs document. A deferred request is sent once
+ * the service is back, so it succeeds; every other failure, an unavailable service included,
+ * is ERROR.
+ */
+inline int32_t NormalizeLightErrCode(int32_t code)
+{
+    switch (code) {
+        case MISC_NATIVE_REQUEST_DEFERRED: {
+            return SUCCESS;
+        }
+        default: {
+            return ERROR;
+        }
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // LIGHT_ERR_CODE_H
@@ -15,6 +15,7 @@
 #include "light_agent.h"
 
 #include "light_client.h"
+#include "light_err_code.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -45,7 +46,7 @@ int32_t TurnOn(int32_t lightId, const LightColor &color, const LightAnimation &a
     int32_t ret = client.TurnOn(lightId, color, animation);
     if (ret != ERR_OK) {
         MISC_HILOGE("TurnOn failed, lightId:%{public}d, ret:%{public}d ", lightId, ret);
-        return ERROR;
+        return NormalizeLightErrCode(ret);
     }
     return SUCCESS;
 }
@@ -60,7 +61,7 @@ int32_t TurnOff(int32_t lightId)
     int32_t ret = client.TurnOff(lightId);
     if (ret != ERR_OK) {
         MISC_HILOGE("TurnOff failed, lightId:%{public}d, ret:%{public}d", lightId, ret);
-        return ERROR;
+        return NormalizeLightErrCode(ret);
     }
     return SUCCESS;
 }
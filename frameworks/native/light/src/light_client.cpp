@@ -16,13 +16,8 @@
 #include "light_client.h"
 
 #include <securec.h>
-#include <thread>
 
-#include "death_recipient_template.h"
-#include "hisysevent.h"
-#include "iservice_registry.h"
 #include "sensors_errors.h"
-#include "system_ability_definition.h"
 
 #undef LOG_TAG
 #define LOG_TAG "LightClient"
@@ -31,55 +26,72 @@ namespace OHOS {
 namespace Sensors {
 
 namespace {
-constexpr int32_t GET_SERVICE_MAX_COUNT = 30;
 constexpr uint32_t MAX_LIGHT_LIST_SIZE = 0X00ff;
-constexpr uint32_t WAIT_MS = 200;
 }  // namespace
 
 LightClient::~LightClient()
 {
     CALL_LOG_ENTER;
-    if (miscdeviceProxy_ != nullptr && serviceDeathObserver_ != nullptr) {
-        auto remoteObject = miscdeviceProxy_->AsObject();
-        if (remoteObject != nullptr) {
-            remoteObject->RemoveDeathRecipient(serviceDeathObserver_);
-        }
-    }
+    ServiceConnection.RemoveListener(this);
 }
 
 int32_t LightClient::InitLightClient()
 {
-    CALL_LOG_ENTER;
-    std::lock_guard<std::mutex> clientLock(clientMutex_);
-    if (miscdeviceProxy_ != nullptr) {
-        MISC_HILOGD("miscdeviceProxy_ already init");
+    if (serviceReady_.load(std::memory_order_acquire)) {
         return ERR_OK;
     }
-    auto systemManager = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-    CHKPR(systemManager, MISC_NATIVE_SAM_ERR);
-    int32_t retry = 0;
-    while (retry < GET_SERVICE_MAX_COUNT) {
-        miscdeviceProxy_ = iface_cast<IMiscdeviceService>(systemManager->GetSystemAbility(
-            MISCDEVICE_SERVICE_ABILITY_ID));
-        if (miscdeviceProxy_ != nullptr) {
-            MISC_HILOGD("miscdeviceProxy_ get service success, retry:%{public}d", retry);
-            serviceDeathObserver_ = new (std::nothrow) DeathRecipientTemplate(*const_cast<LightClient *>(this));
-            CHKPR(serviceDeathObserver_, MISC_NATIVE_GET_SERVICE_ERR);
-            auto remoteObject = miscdeviceProxy_->AsObject();
-            CHKPR(remoteObject, MISC_NATIVE_GET_SERVICE_ERR);
-            remoteObject->AddDeathRecipient(serviceDeathObserver_);
-            lightInfoList_ = miscdeviceProxy_->GetLightList();
-            return ERR_OK;
-        }
-        MISC_HILOGW("Get service failed, retry:%{public}d", retry);
-        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS));
-        retry++;
-    }
-    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_EXCEPTION",
-        HiviewDFX::HiSysEvent::EventType::FAULT, "PKG_NAME", "InitLightClient", "ERROR_CODE",
-        MISC_NATIVE_GET_SERVICE_ERR);
-    MISC_HILOGE("Get service failed");
-    return MISC_NATIVE_GET_SERVICE_ERR;
+    ServiceConnection.AddListener(this);
+    int32_t ret = ServiceConnection.Connect();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("Connect service failed, ret:%{public}d", ret);
+        return ret;
+    }
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    SetupServiceLocked(ServiceConnection.GetProxy());
+    return serviceReady_.load() ? ERR_OK : MISC_NATIVE_GET_SERVICE_ERR;
+}
+
+void LightClient::SetupServiceLocked(const sptr<IMiscdeviceService> &proxy)
+{
+    if (serviceReady_.load()) {
+        return;
+    }
+    CHKPV(proxy);
+    if (capabilityPage_.Map(proxy) != ERR_OK) {
+        MISC_HILOGW("Capability page unavailable, query light list from the service");
+    }
+    auto snapshot = capabilityPage_.GetSnapshot();
+    std::vector<LightInfoIPC> lightInfoList = (snapshot != nullptr) ? snapshot->lights : proxy->GetLightList();
+    {
+        std::lock_guard<std::mutex> lightInfoListLock(lightInfoListMutex_);
+        lightInfoList_ = std::move(lightInfoList);
+        lightInfoListGeneration_ = (snapshot != nullptr) ? snapshot->generation : 0;
+    }
+    serviceReady_.store(true, std::memory_order_release);
+}
+
+void LightClient::UpdateLightInfoListLocked()
+{
+    // An HDI reconnect republishes the page under a new generation.
+    auto snapshot = capabilityPage_.GetSnapshot();
+    if ((snapshot != nullptr) && (snapshot->generation != lightInfoListGeneration_)) {
+        lightInfoList_ = snapshot->lights;
+        lightInfoListGeneration_ = snapshot->generation;
+    }
+}
+
+void LightClient::OnServiceConnected(const sptr<IMiscdeviceService> &proxy)
+{
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    SetupServiceLocked(proxy);
+}
+
+void LightClient::OnServiceDisconnected()
+{
+    CALL_LOG_ENTER;
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    serviceReady_.store(false);
+    capabilityPage_.Unmap();
 }
 
 bool LightClient::IsLightIdValid(int32_t lightId)
@@ -90,6 +102,8 @@ bool LightClient::IsLightIdValid(int32_t lightId)
         MISC_HILOGE("InitLightClient failed, ret:%{public}d", ret);
         return false;
     }
+    std::lock_guard<std::mutex> lightInfoListLock(lightInfoListMutex_);
+    UpdateLightInfoListLocked();
     for (const auto &item : lightInfoList_) {
         if (lightId == item.GetLightId()) {
             return true;
@@ -139,6 +153,11 @@ bool LightClient::IsLightAnimationValid(const LightAnimation &animation)
 int32_t LightClient::TurnOn(int32_t lightId, const LightColor &color, const LightAnimation &animation)
 {
     CALL_LOG_ENTER;
+    int32_t ret = InitLightClient();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("InitLightClient failed, ret:%{public}d", ret);
+        return ret;
+    }
     if (!IsLightIdValid(lightId)) {
         MISC_HILOGE("lightId is invalid, lightId:%{public}d", lightId);
         return PARAMETER_ERROR;
@@ -147,35 +166,30 @@ int32_t LightClient::TurnOn(int32_t lightId, const LightColor &color, const Ligh
         MISC_HILOGE("animation is invalid");
         return PARAMETER_ERROR;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     LightAnimationIPC animationIPC;
     animationIPC.SetMode(animation.mode);
     animationIPC.SetOnTime(animation.onTime);
     animationIPC.SetOffTime(animation.offTime);
-    return miscdeviceProxy_->TurnOn(lightId, color, animationIPC);
+    return proxy->TurnOn(lightId, color, animationIPC);
 }
 
 int32_t LightClient::TurnOff(int32_t lightId)
 {
     CALL_LOG_ENTER;
+    if (InitLightClient() == MISC_NATIVE_SERVICE_UNAVAILABLE_ERR) {
+        return ServiceConnection.PostRequest([lightId](const sptr<IMiscdeviceService> &proxy) {
+            return proxy->TurnOff(lightId);
+        });
+    }
     if (!IsLightIdValid(lightId)) {
         MISC_HILOGE("lightId is invalid, lightId:%{public}d", lightId);
         return LIGHT_ID_NOT_SUPPORT;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
-    return miscdeviceProxy_->TurnOff(lightId);
-}
-
-void LightClient::ProcessDeathObserver(wptr<IRemoteObject> object)
-{
-    CALL_LOG_ENTER;
-    (void)object;
-    miscdeviceProxy_ = nullptr;
-    auto ret = InitLightClient();
-    if (ret != ERR_OK) {
-        MISC_HILOGE("InitLightClient failed, ret:%{public}d", ret);
-        return;
-    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+    return proxy->TurnOff(lightId);
 }
 
 void LightClient::ClearLightInfos()
@@ -189,6 +203,8 @@ void LightClient::ClearLightInfos()
 int32_t LightClient::ConvertLightInfos()
 {
     CALL_LOG_ENTER;
+    std::lock_guard<std::mutex> lightInfoListLock(lightInfoListMutex_);
+    UpdateLightInfoListLocked();
     if (lightInfoList_.empty()) {
         MISC_HILOGE("Get light lists failed");
         return ERROR;
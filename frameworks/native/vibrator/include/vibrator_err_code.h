@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATOR_ERR_CODE_H
+#define VIBRATOR_ERR_CODE_H
+
+#include <cstdint>
+
+#include "sensors_errors.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Maps a client result to the codes the vibrator APIs document. The connection codes stay
+ * inside the client: a deferred request is sent once the service is back, so it succeeds,
+ * and an unavailable service is a failed device operation.
+ */
+inline int32_t NormalizeVibratorErrCode(int32_t code)
+{
+    switch (code) {
+        case PERMISSION_DENIED: {
+            return PERMISSION_DENIED;
+        }
+        case PARAMETER_ERROR: {
+            return PARAMETER_ERROR;
+        }
+        case IS_NOT_SUPPORTED: {
+            return IS_NOT_SUPPORTED;
+        }
+        case MISC_NATIVE_REQUEST_DEFERRED: {
+            return SUCCESS;
+        }
+        default: {
+            return DEVICE_OPERATION_FAILED;
+        }
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATOR_ERR_CODE_H
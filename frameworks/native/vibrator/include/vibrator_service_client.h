@@ -16,14 +16,17 @@
 #ifndef VIBRATOR_SERVICE_CLIENT_H
 #define VIBRATOR_SERVICE_CLIENT_H
 
+#include <atomic>
 #include <dlfcn.h>
 #include <mutex>
 
 #include "iremote_object.h"
 #include "singleton.h"
 
+#include "capability_page_reader.h"
 #include "i_vibrator_decoder.h"
 #include "miscdevice_service_proxy.h"
+#include "service_connection_manager.h"
 #include "vibrator_agent_type.h"
 #include "vibrator_client_stub.h"
 
@@ -51,7 +54,7 @@ struct VibratorDecodeHandle {
     }
 };
 
-class VibratorServiceClient : public Singleton<VibratorServiceClient> {
+class VibratorServiceClient : public Singleton<VibratorServiceClient>, public IServiceConnectionListener {
 public:
     ~VibratorServiceClient() override;
     int32_t Vibrate(int32_t vibratorId, int32_t timeOut, int32_t usage);
@@ -64,25 +67,33 @@ public:
     int32_t StopVibrator(int32_t vibratorId);
     bool IsHdHapticSupported();
     int32_t IsSupportEffect(const std::string &effect, bool &state);
-    void ProcessDeathObserver(const wptr<IRemoteObject> &object);
+    void OnServiceConnected(const sptr<IMiscdeviceService> &proxy) override;
+    void OnServiceDisconnected() override;
     int32_t PreProcess(const VibratorFileDescription &fd, VibratorPackage &package);
     int32_t GetDelayTime(int32_t &delayTime);
     int32_t PlayPattern(const VibratorPattern &pattern, int32_t usage, const VibratorParameter &parameter);
     int32_t FreeVibratorPackage(VibratorPackage &package);
+    static int32_t ConvertVibratePackage(const VibratePackage& inPkg, VibratorPackage &outPkg);
     int32_t PlayPrimitiveEffect(int32_t vibratorId, const std::string &effect, int32_t intensity, int32_t usage);
     bool IsSupportVibratorCustom();
+    int32_t RegisterEffect(const VibratorPackage &package, int32_t &handle);
+    int32_t PlayEffectHandle(int32_t handle, int32_t usage, const VibratorParameter &parameter);
+    int32_t ReleaseEffect(int32_t handle);
 
 private:
     int32_t InitServiceClient();
+    int32_t SetupServiceLocked(const sptr<IMiscdeviceService> &proxy);
     int32_t LoadDecoderLibrary(const std::string& path);
-    int32_t ConvertVibratePackage(const VibratePackage& inPkg, VibratorPackage &outPkg);
-    int32_t TransferClientRemoteObject();
-    int32_t GetVibratorCapacity();
-    sptr<IRemoteObject::DeathRecipient> serviceDeathObserver_ = nullptr;
-    sptr<IMiscdeviceService> miscdeviceProxy_ = nullptr;
+    int32_t ConvertVibratorPattern(const VibratorPattern &inPattern, VibratePattern &outPattern);
+    int32_t TransferClientRemoteObject(const sptr<IMiscdeviceService> &proxy);
+    int32_t GetVibratorCapacity(const sptr<IMiscdeviceService> &proxy);
+    VibratorCapacity GetCapacity();
+    std::atomic<bool> serviceReady_ = false;
     sptr<VibratorClientStub> vibratorClient_ = nullptr;
     VibratorDecodeHandle decodeHandle_;
+    std::mutex capacityMutex_;
     VibratorCapacity capacity_;
+    CapabilityPageReader capabilityPage_;
     std::mutex clientMutex_;
     std::mutex decodeMutex_;
 };
@@ -16,14 +16,10 @@
 #include "vibrator_service_client.h"
 
 #include <climits>
-#include <thread>
 
 #include "hisysevent.h"
 #include "hitrace_meter.h"
-#include "iservice_registry.h"
-#include "system_ability_definition.h"
 
-#include "death_recipient_template.h"
 #include "sensors_errors.h"
 #include "vibrator_decoder_creator.h"
 
@@ -35,8 +31,6 @@ namespace Sensors {
 using namespace OHOS::HiviewDFX;
 
 namespace {
-constexpr int32_t GET_SERVICE_MAX_COUNT = 3;
-constexpr uint32_t WAIT_MS = 200;
 #ifdef __aarch64__
     static const std::string DECODER_LIBRARY_PATH = "/system/lib64/platformsdk/libvibrator_decoder.z.so";
 #else
@@ -46,12 +40,7 @@ constexpr uint32_t WAIT_MS = 200;
 
 VibratorServiceClient::~VibratorServiceClient()
 {
-    if (miscdeviceProxy_ != nullptr && serviceDeathObserver_ != nullptr) {
-        auto remoteObject = miscdeviceProxy_->AsObject();
-        if (remoteObject != nullptr) {
-            remoteObject->RemoveDeathRecipient(serviceDeathObserver_);
-        }
-    }
+    ServiceConnection.RemoveListener(this);
     std::lock_guard<std::mutex> decodeLock(decodeMutex_);
     if (decodeHandle_.destroy != nullptr && decodeHandle_.handle != nullptr) {
         decodeHandle_.destroy(decodeHandle_.decoder);
@@ -62,60 +51,69 @@ VibratorServiceClient::~VibratorServiceClient()
 
 int32_t VibratorServiceClient::InitServiceClient()
 {
-    CALL_LOG_ENTER;
+    if (serviceReady_.load(std::memory_order_acquire)) {
+        return ERR_OK;
+    }
+    ServiceConnection.AddListener(this);
+    int32_t ret = ServiceConnection.Connect();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("Connect service failed, ret:%{public}d", ret);
+        return ret;
+    }
     std::lock_guard<std::mutex> clientLock(clientMutex_);
-    if (miscdeviceProxy_ != nullptr) {
-        MISC_HILOGD("miscdeviceProxy_ already init");
+    return SetupServiceLocked(ServiceConnection.GetProxy());
+}
+
+int32_t VibratorServiceClient::SetupServiceLocked(const sptr<IMiscdeviceService> &proxy)
+{
+    if (serviceReady_.load()) {
         return ERR_OK;
     }
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     if (vibratorClient_ == nullptr) {
         vibratorClient_ = new (std::nothrow) VibratorClientStub();
     }
-    auto sm = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-    if (sm == nullptr) {
-        MISC_HILOGE("sm cannot be null");
-        return MISC_NATIVE_SAM_ERR;
-    }
-    int32_t retry = 0;
-    while (retry < GET_SERVICE_MAX_COUNT) {
-        miscdeviceProxy_ = iface_cast<IMiscdeviceService>(sm->GetSystemAbility(MISCDEVICE_SERVICE_ABILITY_ID));
-        if (miscdeviceProxy_ != nullptr) {
-            MISC_HILOGD("Get service success, retry:%{public}d", retry);
-            serviceDeathObserver_ =
-                new (std::nothrow) DeathRecipientTemplate(*const_cast<VibratorServiceClient *>(this));
-            CHKPR(serviceDeathObserver_, MISC_NATIVE_GET_SERVICE_ERR);
-            auto remoteObject = miscdeviceProxy_->AsObject();
-            CHKPR(remoteObject, MISC_NATIVE_GET_SERVICE_ERR);
-            remoteObject->AddDeathRecipient(serviceDeathObserver_);
-            int32_t ret = TransferClientRemoteObject();
-            if (ret != ERR_OK) {
-                MISC_HILOGE("TransferClientRemoteObject failed, ret:%{public}d", ret);
-                return ERROR;
-            }
-            ret = GetVibratorCapacity();
-            if (ret != ERR_OK) {
-                MISC_HILOGE("GetVibratorCapacity failed, ret:%{public}d", ret);
-                return ERROR;
-            }
-            return ERR_OK;
-        }
-        MISC_HILOGW("Get service failed, retry:%{public}d", retry);
-        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_MS));
-        retry++;
-    }
-    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::MISCDEVICE, "MISC_SERVICE_EXCEPTION",
-        HiSysEvent::EventType::FAULT, "PKG_NAME", "InitServiceClient", "ERROR_CODE", MISC_NATIVE_GET_SERVICE_ERR);
-    MISC_HILOGE("Get service failed");
-    return MISC_NATIVE_GET_SERVICE_ERR;
+    int32_t ret = TransferClientRemoteObject(proxy);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("TransferClientRemoteObject failed, ret:%{public}d", ret);
+        return ERROR;
+    }
+    if (capabilityPage_.Map(proxy) != ERR_OK) {
+        MISC_HILOGW("Capability page unavailable, static queries go to the service");
+    }
+    ret = GetVibratorCapacity(proxy);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("GetVibratorCapacity failed, ret:%{public}d", ret);
+        return ERROR;
+    }
+    serviceReady_.store(true, std::memory_order_release);
+    return ERR_OK;
+}
+
+void VibratorServiceClient::OnServiceConnected(const sptr<IMiscdeviceService> &proxy)
+{
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    int32_t ret = SetupServiceLocked(proxy);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("Setup service failed, ret:%{public}d", ret);
+    }
+}
+
+void VibratorServiceClient::OnServiceDisconnected()
+{
+    CALL_LOG_ENTER;
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    serviceReady_.store(false);
+    capabilityPage_.Unmap();
 }
 
-int32_t VibratorServiceClient::TransferClientRemoteObject()
+int32_t VibratorServiceClient::TransferClientRemoteObject(const sptr<IMiscdeviceService> &proxy)
 {
+    CHKPR(vibratorClient_, MISC_NATIVE_GET_SERVICE_ERR);
     auto remoteObject = vibratorClient_->AsObject();
     CHKPR(remoteObject, MISC_NATIVE_GET_SERVICE_ERR);
-    CHKPR(miscdeviceProxy_, ERROR);
     StartTrace(HITRACE_TAG_SENSORS, "TransferClientRemoteObject");
-    int32_t ret = miscdeviceProxy_->TransferClientRemoteObject(remoteObject);
+    int32_t ret = proxy->TransferClientRemoteObject(remoteObject);
     FinishTrace(HITRACE_TAG_SENSORS);
     return ret;
 }
@@ -126,11 +124,12 @@ int32_t VibratorServiceClient::Vibrate(int32_t vibratorId, int32_t timeOut, int3
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "VibrateTime");
-    ret = miscdeviceProxy_->Vibrate(vibratorId, timeOut, usage);
+    ret = proxy->Vibrate(vibratorId, timeOut, usage);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("Vibrate time failed, ret:%{public}d, time:%{public}d, usage:%{public}d", ret, timeOut, usage);
@@ -146,11 +145,12 @@ int32_t VibratorServiceClient::Vibrate(int32_t vibratorId, const std::string &ef
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "VibrateEffect");
-    ret = miscdeviceProxy_->PlayVibratorEffect(vibratorId, effect, loopCount, usage);
+    ret = proxy->PlayVibratorEffect(vibratorId, effect, loopCount, usage);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("Vibrate effect failed, ret:%{public}d, effect:%{public}s, loopCount:%{public}d, usage:%{public}d",
@@ -168,15 +168,16 @@ int32_t VibratorServiceClient::PlayVibratorCustom(int32_t vibratorId, const RawF
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "PlayVibratorCustom");
     VibrateParameter vibateParameter = {
         .intensity = parameter.intensity,
         .frequency = parameter.frequency
     };
-    ret = miscdeviceProxy_->PlayVibratorCustom(vibratorId, rawFd, usage, vibateParameter);
+    ret = proxy->PlayVibratorCustom(vibratorId, rawFd, usage, vibateParameter);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("PlayVibratorCustom failed, ret:%{public}d, usage:%{public}d", ret, usage);
@@ -189,13 +190,19 @@ int32_t VibratorServiceClient::StopVibrator(int32_t vibratorId, const std::strin
 {
     MISC_HILOGD("StopVibrator begin, vibratorId:%{public}d, mode:%{public}s", vibratorId, mode.c_str());
     int32_t ret = InitServiceClient();
+    if (ret == MISC_NATIVE_SERVICE_UNAVAILABLE_ERR) {
+        return ServiceConnection.PostRequest([vibratorId, mode](const sptr<IMiscdeviceService> &proxy) {
+            return proxy->StopVibrator(vibratorId, mode);
+        });
+    }
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "StopVibratorByMode");
-    ret = miscdeviceProxy_->StopVibrator(vibratorId, mode);
+    ret = proxy->StopVibrator(vibratorId, mode);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGD("StopVibrator by mode failed, ret:%{public}d, mode:%{public}s", ret, mode.c_str());
@@ -207,13 +214,19 @@ int32_t VibratorServiceClient::StopVibrator(int32_t vibratorId)
 {
     MISC_HILOGD("StopVibrator begin, vibratorId:%{public}d", vibratorId);
     int32_t ret = InitServiceClient();
+    if (ret == MISC_NATIVE_SERVICE_UNAVAILABLE_ERR) {
+        return ServiceConnection.PostRequest([vibratorId](const sptr<IMiscdeviceService> &proxy) {
+            return proxy->StopVibrator(vibratorId);
+        });
+    }
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "StopVibratorAll");
-    ret = miscdeviceProxy_->StopVibrator(vibratorId);
+    ret = proxy->StopVibrator(vibratorId);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGD("StopVibrator failed, ret:%{public}d", ret);
@@ -224,7 +237,7 @@ int32_t VibratorServiceClient::StopVibrator(int32_t vibratorId)
 bool VibratorServiceClient::IsHdHapticSupported()
 {
     CALL_LOG_ENTER;
-    return capacity_.isSupportHdHaptic;
+    return GetCapacity().isSupportHdHaptic;
 }
 
 int32_t VibratorServiceClient::IsSupportEffect(const std::string &effect, bool &state)
@@ -233,11 +246,20 @@ int32_t VibratorServiceClient::IsSupportEffect(const std::string &effect, bool &
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
+    }
+    auto snapshot = capabilityPage_.GetSnapshot();
+    if (snapshot != nullptr) {
+        auto it = snapshot->effects.find(effect);
+        if (it != snapshot->effects.end()) {
+            state = it->second.isSupportEffect;
+            return ERR_OK;
+        }
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "VibrateEffect");
-    ret = miscdeviceProxy_->IsSupportEffect(effect, state);
+    ret = proxy->IsSupportEffect(effect, state);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("Query effect support failed, ret:%{public}d, effect:%{public}s", ret, effect.c_str());
@@ -245,18 +267,6 @@ int32_t VibratorServiceClient::IsSupportEffect(const std::string &effect, bool &
     return ret;
 }
 
-void VibratorServiceClient::ProcessDeathObserver(const wptr<IRemoteObject> &object)
-{
-    CALL_LOG_ENTER;
-    (void)object;
-    miscdeviceProxy_ = nullptr;
-    int32_t ret = InitServiceClient();
-    if (ret != ERR_OK) {
-        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return;
-    }
-}
-
 int32_t VibratorServiceClient::LoadDecoderLibrary(const std::string& path)
 {
     std::lock_guard<std::mutex> decodeLock(decodeMutex_);
@@ -304,6 +314,8 @@ int32_t VibratorServiceClient::PreProcess(const VibratorFileDescription &fd, Vib
     };
     decodeHandle_.decoder = decodeHandle_.create(rawFd);
     CHKPR(decodeHandle_.decoder, ERROR);
+    // The fd belongs to this process, so mapping it cannot be abused by another process.
+    decodeHandle_.decoder->SetTrustedFd(true);
     VibratePackage pkg = {};
     if (decodeHandle_.decoder->DecodeEffect(rawFd, pkg) != 0) {
         MISC_HILOGE("DecodeEffect fail");
@@ -321,11 +333,17 @@ int32_t VibratorServiceClient::GetDelayTime(int32_t &delayTime)
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    auto snapshot = capabilityPage_.GetSnapshot();
+    if ((snapshot != nullptr) && snapshot->hasDelayTime) {
+        delayTime = snapshot->delayTime;
+        return ERR_OK;
+    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "GetDelayTime");
-    ret = miscdeviceProxy_->GetDelayTime(delayTime);
+    ret = proxy->GetDelayTime(delayTime);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("GetDelayTime failed, ret:%{public}d", ret);
@@ -333,50 +351,61 @@ int32_t VibratorServiceClient::GetDelayTime(int32_t &delayTime)
     return ret;
 }
 
-int32_t VibratorServiceClient::PlayPattern(const VibratorPattern &pattern, int32_t usage,
-    const VibratorParameter &parameter)
+int32_t VibratorServiceClient::ConvertVibratorPattern(const VibratorPattern &inPattern,
+    VibratePattern &outPattern)
 {
-    MISC_HILOGD("Vibrate begin, usage:%{public}d", usage);
-    int32_t ret = InitServiceClient();
-    if (ret != ERR_OK) {
-        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
-    }
-    CHKPR(miscdeviceProxy_, ERROR);
-    StartTrace(HITRACE_TAG_SENSORS, "PlayPattern");
-    VibratePattern vibratePattern = {};
-    vibratePattern.startTime = pattern.time;
-    for (int32_t i = 0; i < pattern.eventNum; ++i) {
-        if (pattern.events == nullptr) {
+    outPattern.startTime = inPattern.time;
+    for (int32_t i = 0; i < inPattern.eventNum; ++i) {
+        if (inPattern.events == nullptr) {
             MISC_HILOGE("VibratorPattern's events is null");
             return ERROR;
         }
         VibrateEvent event;
-        event.tag = static_cast<VibrateTag>(pattern.events[i].type);
-        event.time = pattern.events[i].time;
-        event.duration = pattern.events[i].duration;
-        event.intensity = pattern.events[i].intensity;
-        event.frequency = pattern.events[i].frequency;
-        event.index = pattern.events[i].index;
-        for (int32_t j = 0; j < pattern.events[i].pointNum; ++j) {
-            if (pattern.events[i].points == nullptr) {
+        event.tag = static_cast<VibrateTag>(inPattern.events[i].type);
+        event.time = inPattern.events[i].time;
+        event.duration = inPattern.events[i].duration;
+        event.intensity = inPattern.events[i].intensity;
+        event.frequency = inPattern.events[i].frequency;
+        event.index = inPattern.events[i].index;
+        for (int32_t j = 0; j < inPattern.events[i].pointNum; ++j) {
+            if (inPattern.events[i].points == nullptr) {
                 MISC_HILOGE("VibratorEvent's points is null");
                 continue;
             }
             VibrateCurvePoint point;
-            point.time = pattern.events[i].points[j].time;
-            point.intensity = pattern.events[i].points[j].intensity;
-            point.frequency = pattern.events[i].points[j].frequency;
+            point.time = inPattern.events[i].points[j].time;
+            point.intensity = inPattern.events[i].points[j].intensity;
+            point.frequency = inPattern.events[i].points[j].frequency;
             event.points.emplace_back(point);
         }
-        vibratePattern.events.emplace_back(event);
-        vibratePattern.patternDuration = pattern.patternDuration;
+        outPattern.events.emplace_back(event);
+        outPattern.patternDuration = inPattern.patternDuration;
+    }
+    return ERR_OK;
+}
+
+int32_t VibratorServiceClient::PlayPattern(const VibratorPattern &pattern, int32_t usage,
+    const VibratorParameter &parameter)
+{
+    MISC_HILOGD("Vibrate begin, usage:%{public}d", usage);
+    int32_t ret = InitServiceClient();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
+        return ret;
+    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+    StartTrace(HITRACE_TAG_SENSORS, "PlayPattern");
+    VibratePattern vibratePattern = {};
+    if (ConvertVibratorPattern(pattern, vibratePattern) != ERR_OK) {
+        FinishTrace(HITRACE_TAG_SENSORS);
+        return ERROR;
     }
     VibrateParameter vibateParameter = {
         .intensity = parameter.intensity,
         .frequency = parameter.frequency
     };
-    ret = miscdeviceProxy_->PlayPattern(vibratePattern, usage, vibateParameter);
+    ret = proxy->PlayPattern(vibratePattern, usage, vibateParameter);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("PlayPattern failed, ret:%{public}d, usage:%{public}d", ret, usage);
@@ -388,52 +417,66 @@ int32_t VibratorServiceClient::ConvertVibratePackage(const VibratePackage& inPkg
     VibratorPackage &outPkg)
 {
     inPkg.Dump();
-    int32_t patternSize = static_cast<int32_t>(inPkg.patterns.size());
-    VibratorPattern *patterns = (VibratorPattern *)malloc(sizeof(VibratorPattern) * patternSize);
-    CHKPR(patterns, ERROR);
-    outPkg.patternNum = patternSize;
-    int32_t clientPatternDuration = 0;
-    for (int32_t i = 0; i < patternSize; ++i) {
-        patterns[i].time = inPkg.patterns[i].startTime;
-        auto vibrateEvents = inPkg.patterns[i].events;
-        int32_t eventSize = static_cast<int32_t>(vibrateEvents.size());
-        patterns[i].eventNum = eventSize;
-        VibratorEvent *events = (VibratorEvent *)malloc(sizeof(VibratorEvent) * eventSize);
-        if (events == nullptr) {
-            free(patterns);
-            patterns = nullptr;
-            return ERROR;
+    size_t patternSize = inPkg.patterns.size();
+    size_t eventSize = 0;
+    size_t pointSize = 0;
+    for (const auto &pattern : inPkg.patterns) {
+        eventSize += pattern.events.size();
+        for (const auto &event : pattern.events) {
+            pointSize += event.points.size();
         }
-        for (int32_t j = 0; j < eventSize; ++j) {
-            events[j].type = static_cast<VibratorEventType >(vibrateEvents[j].tag);
-            events[j].time = vibrateEvents[j].time;
-            events[j].duration = vibrateEvents[j].duration;
-            events[j].intensity = vibrateEvents[j].intensity;
-            events[j].frequency = vibrateEvents[j].frequency;
-            events[j].index = vibrateEvents[j].index;
-            auto vibratePoints = vibrateEvents[j].points;
-            events[j].pointNum = static_cast<int32_t>(vibratePoints.size());
-            VibratorCurvePoint *points = (VibratorCurvePoint *)malloc(sizeof(VibratorCurvePoint) * events[j].pointNum);
-            if (points == nullptr) {
-                free(patterns);
-                patterns = nullptr;
-                free(events);
-                events = nullptr;
-                return ERROR;
-            }
-            for (int32_t k = 0; k < events[j].pointNum; ++k) {
-                points[k].time = vibratePoints[k].time;
-                points[k].intensity  = vibratePoints[k].intensity;
-                points[k].frequency  = vibratePoints[k].frequency;
+    }
+    if ((patternSize > INT32_MAX) || (eventSize > INT32_MAX) || (pointSize > INT32_MAX)) {
+        MISC_HILOGE("Invalid package, pattern:%{public}zu, event:%{public}zu, point:%{public}zu",
+            patternSize, eventSize, pointSize);
+        return ERROR;
+    }
+    outPkg.packageDuration = inPkg.packageDuration;
+    if (patternSize == 0) {
+        outPkg.patternNum = 0;
+        outPkg.patterns = nullptr;
+        return ERR_OK;
+    }
+    // Patterns, events and points share one block, laid out in that order so that every array
+    // stays naturally aligned; FreeVibratorPackage releases the whole package with a single free.
+    static_assert(sizeof(VibratorPattern) % alignof(VibratorEvent) == 0, "VibratorEvent misaligned");
+    static_assert(sizeof(VibratorEvent) % alignof(VibratorCurvePoint) == 0, "VibratorCurvePoint misaligned");
+    size_t totalSize = sizeof(VibratorPattern) * patternSize + sizeof(VibratorEvent) * eventSize +
+        sizeof(VibratorCurvePoint) * pointSize;
+    uint8_t *block = static_cast<uint8_t *>(malloc(totalSize));
+    CHKPR(block, ERROR);
+    VibratorPattern *patterns = reinterpret_cast<VibratorPattern *>(block);
+    VibratorEvent *events = reinterpret_cast<VibratorEvent *>(patterns + patternSize);
+    VibratorCurvePoint *points = reinterpret_cast<VibratorCurvePoint *>(events + eventSize);
+    int32_t clientPatternDuration = 0;
+    for (size_t i = 0; i < patternSize; ++i) {
+        const VibratePattern &inPattern = inPkg.patterns[i];
+        VibratorPattern &pattern = patterns[i];
+        pattern.time = inPattern.startTime;
+        pattern.eventNum = static_cast<int32_t>(inPattern.events.size());
+        pattern.events = (pattern.eventNum > 0) ? events : nullptr;
+        for (const VibrateEvent &inEvent : inPattern.events) {
+            VibratorEvent &event = *events++;
+            event.type = static_cast<VibratorEventType>(inEvent.tag);
+            event.time = inEvent.time;
+            event.duration = inEvent.duration;
+            event.intensity = inEvent.intensity;
+            event.frequency = inEvent.frequency;
+            event.index = inEvent.index;
+            event.pointNum = static_cast<int32_t>(inEvent.points.size());
+            event.points = (event.pointNum > 0) ? points : nullptr;
+            for (const VibrateCurvePoint &inPoint : inEvent.points) {
+                VibratorCurvePoint &point = *points++;
+                point.time = inPoint.time;
+                point.intensity = inPoint.intensity;
+                point.frequency = inPoint.frequency;
             }
-            events[j].points = points;
-            clientPatternDuration += events[j].duration;
+            clientPatternDuration += event.duration;
         }
-        patterns[i].events = events;
-        patterns[i].patternDuration = clientPatternDuration;
+        pattern.patternDuration = clientPatternDuration;
     }
+    outPkg.patternNum = static_cast<int32_t>(patternSize);
     outPkg.patterns = patterns;
-    outPkg.packageDuration = inPkg.packageDuration;
     return ERR_OK;
 }
 
@@ -444,25 +487,11 @@ int32_t VibratorServiceClient::FreeVibratorPackage(VibratorPackage &package)
         MISC_HILOGW("Patterns is not need to free, pattern size:%{public}d", patternSize);
         return ERROR;
     }
-    auto patterns = package.patterns;
-    for (int32_t i = 0; i < patternSize; ++i) {
-        int32_t eventNum = patterns[i].eventNum;
-        if ((eventNum <= 0) || (patterns[i].events == nullptr)) {
-            MISC_HILOGW("Events is not need to free, event size:%{public}d", eventNum);
-            continue;
-        }
-        auto events = patterns[i].events;
-        for (int32_t j = 0; j < eventNum; ++j) {
-            if (events[j].points != nullptr) {
-                free(events[j].points);
-                events[j].points = nullptr;
-            }
-        }
-        free(events);
-        events = nullptr;
-    }
-    free(patterns);
-    patterns = nullptr;
+    // The events and points live in the same block as the patterns, see ConvertVibratePackage.
+    free(package.patterns);
+    package.patterns = nullptr;
+    package.patternNum = 0;
+    package.packageDuration = 0;
     return ERR_OK;
 }
 
@@ -474,11 +503,12 @@ int32_t VibratorServiceClient::PlayPrimitiveEffect(int32_t vibratorId, const std
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
-        return MISC_NATIVE_GET_SERVICE_ERR;
+        return ret;
     }
-    CHKPR(miscdeviceProxy_, ERROR);
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
     StartTrace(HITRACE_TAG_SENSORS, "PlayPrimitiveEffect");
-    ret = miscdeviceProxy_->PlayPrimitiveEffect(vibratorId, effect, intensity, usage);
+    ret = proxy->PlayPrimitiveEffect(vibratorId, effect, intensity, usage);
     FinishTrace(HITRACE_TAG_SENSORS);
     if (ret != ERR_OK) {
         MISC_HILOGE("Play primitive effect failed, ret:%{public}d, effect:%{public}s, intensity:%{public}d,"
@@ -487,23 +517,115 @@ int32_t VibratorServiceClient::PlayPrimitiveEffect(int32_t vibratorId, const std
     return ret;
 }
 
-int32_t VibratorServiceClient::GetVibratorCapacity()
+int32_t VibratorServiceClient::GetVibratorCapacity(const sptr<IMiscdeviceService> &proxy)
 {
-    CHKPR(miscdeviceProxy_, ERROR);
-    StartTrace(HITRACE_TAG_SENSORS, "GetVibratorCapacity");
-    int32_t ret = miscdeviceProxy_->GetVibratorCapacity(capacity_);
-    FinishTrace(HITRACE_TAG_SENSORS);
-    capacity_.Dump();
+    auto snapshot = capabilityPage_.GetSnapshot();
+    VibratorCapacity capacity;
+    int32_t ret = ERR_OK;
+    if (snapshot != nullptr) {
+        capacity = snapshot->capacity;
+    } else {
+        StartTrace(HITRACE_TAG_SENSORS, "GetVibratorCapacity");
+        ret = proxy->GetVibratorCapacity(capacity);
+        FinishTrace(HITRACE_TAG_SENSORS);
+    }
+    capacity.Dump();
+    std::lock_guard<std::mutex> capacityLock(capacityMutex_);
+    capacity_ = capacity;
     return ret;
 }
 
+VibratorCapacity VibratorServiceClient::GetCapacity()
+{
+    // GetSnapshot rereads the page once an HDI reconnect has published a new generation.
+    auto snapshot = capabilityPage_.GetSnapshot();
+    std::lock_guard<std::mutex> capacityLock(capacityMutex_);
+    if (snapshot != nullptr) {
+        capacity_ = snapshot->capacity;
+    }
+    return capacity_;
+}
+
 bool VibratorServiceClient::IsSupportVibratorCustom()
 {
     int32_t ret = InitServiceClient();
     if (ret != ERR_OK) {
         MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
     }
-    return (capacity_.isSupportHdHaptic || capacity_.isSupportPresetMapping || capacity_.isSupportTimeDelay);
+    VibratorCapacity capacity = GetCapacity();
+    return (capacity.isSupportHdHaptic || capacity.isSupportPresetMapping || capacity.isSupportTimeDelay);
+}
+
+int32_t VibratorServiceClient::RegisterEffect(const VibratorPackage &package, int32_t &handle)
+{
+    MISC_HILOGD("RegisterEffect begin, patternNum:%{public}d", package.patternNum);
+    if ((package.patterns == nullptr) || (package.patternNum <= 0)) {
+        MISC_HILOGE("Package is empty");
+        return PARAMETER_ERROR;
+    }
+    int32_t ret = InitServiceClient();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
+        return ret;
+    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+    VibratePackage vibratePackage;
+    vibratePackage.packageDuration = package.packageDuration;
+    for (int32_t i = 0; i < package.patternNum; ++i) {
+        VibratePattern vibratePattern;
+        if (ConvertVibratorPattern(package.patterns[i], vibratePattern) != ERR_OK) {
+            return ERROR;
+        }
+        vibratePackage.patterns.emplace_back(std::move(vibratePattern));
+    }
+    StartTrace(HITRACE_TAG_SENSORS, "RegisterEffect");
+    ret = proxy->RegisterEffect(vibratePackage, handle);
+    FinishTrace(HITRACE_TAG_SENSORS);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("RegisterEffect failed, ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t VibratorServiceClient::PlayEffectHandle(int32_t handle, int32_t usage, const VibratorParameter &parameter)
+{
+    MISC_HILOGD("PlayEffectHandle begin, handle:%{public}d, usage:%{public}d", handle, usage);
+    int32_t ret = InitServiceClient();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
+        return ret;
+    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+    VibrateParameter vibateParameter = {
+        .intensity = parameter.intensity,
+        .frequency = parameter.frequency
+    };
+    StartTrace(HITRACE_TAG_SENSORS, "PlayEffectHandle");
+    ret = proxy->PlayEffectHandle(handle, usage, vibateParameter);
+    FinishTrace(HITRACE_TAG_SENSORS);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("PlayEffectHandle failed, ret:%{public}d, handle:%{public}d", ret, handle);
+    }
+    return ret;
+}
+
+int32_t VibratorServiceClient::ReleaseEffect(int32_t handle)
+{
+    MISC_HILOGD("ReleaseEffect begin, handle:%{public}d", handle);
+    int32_t ret = InitServiceClient();
+    if (ret != ERR_OK) {
+        MISC_HILOGE("InitServiceClient failed, ret:%{public}d", ret);
+        return ret;
+    }
+    sptr<IMiscdeviceService> proxy = ServiceConnection.GetProxy();
+    CHKPR(proxy, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+    ret = proxy->ReleaseEffect(handle);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("ReleaseEffect failed, ret:%{public}d, handle:%{public}d", ret, handle);
+    }
+    return ret;
 }
 }  // namespace Sensors
 }  // namespace OHOS
@@ -17,6 +17,7 @@
 #include "parameters.h"
 
 #include "sensors_errors.h"
+#include "vibrator_err_code.h"
 #include "vibrator_service_client.h"
 
 #undef LOG_TAG
@@ -38,24 +39,6 @@ const int32_t FREQUENCY_ADJUST_MIN = -100;
 const int32_t FREQUENCY_ADJUST_MAX = 100;
 } // namespace
 
-static int32_t NormalizeErrCode(int32_t code)
-{
-    switch (code) {
-        case PERMISSION_DENIED: {
-            return PERMISSION_DENIED;
-        }
-        case PARAMETER_ERROR: {
-            return PARAMETER_ERROR;
-        }
-        case IS_NOT_SUPPORTED: {
-            return IS_NOT_SUPPORTED;
-        }
-        default: {
-            return DEVICE_OPERATION_FAILED;
-        }
-    }
-}
-
 bool SetLoopCount(int32_t count)
 {
     if (count <= 0) {
@@ -76,7 +59,7 @@ int32_t StartVibrator(const char *effectId)
     g_usage = USAGE_UNKNOWN;
     if (ret != ERR_OK) {
         MISC_HILOGE("Vibrate effectId failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -92,7 +75,7 @@ int32_t StartVibratorOnce(int32_t duration)
     g_usage = USAGE_UNKNOWN;
     if (ret != ERR_OK) {
         MISC_HILOGE("Vibrate duration failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -124,7 +107,7 @@ int32_t PlayVibratorCustom(int32_t fd, int64_t offset, int64_t length)
     g_vibratorParameter.frequency = 0;
     if (ret != ERR_OK) {
         MISC_HILOGE("PlayVibratorCustom failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 #else
@@ -144,7 +127,7 @@ int32_t StopVibrator(const char *mode)
     int32_t ret = client.StopVibrator(DEFAULT_VIBRATOR_ID, mode);
     if (ret != ERR_OK) {
         MISC_HILOGD("StopVibrator by mode failed, ret:%{public}d, mode:%{public}s", ret, mode);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -155,7 +138,7 @@ int32_t Cancel()
     int32_t ret = client.StopVibrator(DEFAULT_VIBRATOR_ID);
     if (ret != ERR_OK) {
         MISC_HILOGD("StopVibrator failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -183,7 +166,7 @@ int32_t IsSupportEffect(const char *effectId, bool *state)
     int32_t ret = client.IsSupportEffect(effectId, *state);
     if (ret != ERR_OK) {
         MISC_HILOGE("Query effect support failed, ret:%{public}d, effectId:%{public}s", ret, effectId);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -194,7 +177,7 @@ int32_t PreProcess(const VibratorFileDescription &fd, VibratorPackage &package)
     int32_t ret = client.PreProcess(fd, package);
     if (ret != ERR_OK) {
         MISC_HILOGE("DecodeVibratorFile failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -205,7 +188,7 @@ int32_t GetDelayTime(int32_t &delayTime)
     int32_t ret = client.GetDelayTime(delayTime);
     if (ret != ERR_OK) {
         MISC_HILOGE("GetDelayTime failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -219,7 +202,7 @@ int32_t PlayPattern(const VibratorPattern &pattern)
     g_vibratorParameter.frequency = 0;
     if (ret != ERR_OK) {
         MISC_HILOGE("PlayPattern failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -230,7 +213,7 @@ int32_t FreeVibratorPackage(VibratorPackage &package)
     int32_t ret = client.FreeVibratorPackage(package);
     if (ret != ERR_OK) {
         MISC_HILOGE("FreeVibratorPackage failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -256,7 +239,43 @@ int32_t PlayPrimitiveEffect(const char *effectId, int32_t intensity)
     g_usage = USAGE_UNKNOWN;
     if (ret != ERR_OK) {
         MISC_HILOGE("Play primitive effect failed, ret:%{public}d", ret);
-        return NormalizeErrCode(ret);
+        return NormalizeVibratorErrCode(ret);
+    }
+    return SUCCESS;
+}
+
+int32_t RegisterEffect(const VibratorPackage &package, int32_t &handle)
+{
+    auto &client = VibratorServiceClient::GetInstance();
+    int32_t ret = client.RegisterEffect(package, handle);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("RegisterEffect failed, ret:%{public}d", ret);
+        return NormalizeVibratorErrCode(ret);
+    }
+    return SUCCESS;
+}
+
+int32_t PlayEffectHandle(int32_t handle)
+{
+    auto &client = VibratorServiceClient::GetInstance();
+    int32_t ret = client.PlayEffectHandle(handle, g_usage, g_vibratorParameter);
+    g_usage = USAGE_UNKNOWN;
+    g_vibratorParameter.intensity = INTENSITY_ADJUST_MAX;
+    g_vibratorParameter.frequency = 0;
+    if (ret != ERR_OK) {
+        MISC_HILOGE("PlayEffectHandle failed, ret:%{public}d", ret);
+        return NormalizeVibratorErrCode(ret);
+    }
+    return SUCCESS;
+}
+
+int32_t ReleaseEffect(int32_t handle)
+{
+    auto &client = VibratorServiceClient::GetInstance();
+    int32_t ret = client.ReleaseEffect(handle);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("ReleaseEffect failed, ret:%{public}d", ret);
+        return NormalizeVibratorErrCode(ret);
     }
     return SUCCESS;
 }
@@ -210,6 +210,32 @@ bool SetParameters(const VibratorParameter &parameter);
  * @since 12
  */
 int32_t PlayPrimitiveEffect(const char *effectId, int32_t intensity);
+
+/**
+ * @brief Upload a vibration sequence package to the service once so that it can be played by handle.
+ * @param package: Vibration sequence package, such as {@link VibratorPackage}.
+ * @param handle: Out of the parameter, the handle of the registered package.
+ * @return 0 indicates success, otherwise indicates failure.
+ * @since 12
+ */
+int32_t RegisterEffect(const VibratorPackage &package, int32_t &handle);
+
+/**
+ * @brief Play a package registered by {@link RegisterEffect} with the usage and adjustment parameters set
+ *        by {@link SetUsage} and {@link SetParameters}.
+ * @param handle: The handle returned by {@link RegisterEffect}.
+ * @return 0 indicates success, otherwise indicates failure.
+ * @since 12
+ */
+int32_t PlayEffectHandle(int32_t handle);
+
+/**
+ * @brief Release a package registered by {@link RegisterEffect}.
+ * @param handle: The handle returned by {@link RegisterEffect}.
+ * @return 0 indicates success, otherwise indicates failure.
+ * @since 12
+ */
+int32_t ReleaseEffect(int32_t handle);
 } // namespace Sensors
 } // namespace OHOS
 #ifdef __cplusplus
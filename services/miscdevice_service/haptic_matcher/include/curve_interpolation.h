@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CURVE_INTERPOLATION_H
+#define CURVE_INTERPOLATION_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Linear interpolation of y at x on the segment (x1, y1)-(x2, y2), computed in float and truncated
+ * toward zero; returns y1 for a vertical segment. Targets compiling this file pin -ffp-contract=off,
+ * so the multiply and the add are rounded separately on every architecture.
+ */
+int32_t InterpolateLinear(int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t x);
+
+/*
+ * InterpolateLinear over count lanes held as separate arrays, four lanes at a time with NEON on
+ * aarch64 or SSE2 on x86, and one at a time elsewhere. The vector paths multiply and add unfused,
+ * like the scalar expression, so every lane equals the scalar result.
+ */
+void InterpolateLinearBatch(const int32_t *x1, const int32_t *x2, const int32_t *y1, const int32_t *y2,
+    const int32_t *x, int32_t *y, size_t count);
+}  // namespace Sensors
+}  // namespace OHOS
+#endif // CURVE_INTERPOLATION_H
@@ -29,21 +29,33 @@ class CustomVibrationMatcher {
 public:
     CustomVibrationMatcher() = default;
     ~CustomVibrationMatcher() = default;
-    int32_t TransformTime(const VibratePackage &package, std::vector<CompositeEffect> &compositeEffects);
-    int32_t TransformEffect(const VibratePackage &package, std::vector<CompositeEffect> &compositeEffects);
+    int32_t TransformTime(const FlatVibratePackage &package, std::vector<CompositeEffect> &compositeEffects);
+    int32_t TransformEffect(const FlatVibratePackage &package, std::vector<CompositeEffect> &compositeEffects);
+    // Builds the transient match table once; until then MatchTransientEffect searches every effect.
+    static void InitTransientMatchTable();
+    // Primitive effect id of the transient closest to the given intensity and frequency.
+    static int32_t MatchTransientEffect(int32_t intensity, int32_t frequency);
+    // Cuts a continuous curve into SLICE_STEP slices carrying the mean intensity and frequency at their ends.
+    // lanes is scratch space the caller keeps across calls so that slicing does not allocate per event.
+    static void SliceCurve(ArrayView<VibrateCurvePoint> curve, std::vector<int32_t> &lanes,
+        std::vector<VibrateSlice> &slices);
+    // Union of two overlapping curves, taking the louder intensity and the mean frequency where they overlap.
+    static std::vector<VibrateCurvePoint> MergeCurve(ArrayView<VibrateCurvePoint> curveLeft,
+        ArrayView<VibrateCurvePoint> curveRight);
 
 private:
-    static int32_t Interpolation(int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t x);
-    VibratePattern MixedWaveProcess(const VibratePackage &package);
-    void PreProcessEvent(VibrateEvent &event);
-    std::vector<VibrateCurvePoint> MergeCurve(const std::vector<VibrateCurvePoint> &curveLeft,
-        const std::vector<VibrateCurvePoint> &curveRight);
-    void ProcessContinuousEvent(const VibrateEvent &event, int32_t &preStartTime,
-        int32_t &preDuration, std::vector<CompositeEffect> &compositeEffects);
+    // Merges all patterns into the single pattern of the returned package.
+    FlatVibratePackage MixedWaveProcess(const FlatVibratePackage &package);
+    void PreProcessEvent(FlatVibrateEvent &event, ArrayView<VibrateCurvePoint> curve,
+        std::vector<VibrateCurvePoint> &points);
+    void ProcessContinuousEvent(const FlatVibrateEvent &event, ArrayView<VibrateCurvePoint> curve,
+        int32_t &preStartTime, int32_t &preDuration, std::vector<CompositeEffect> &compositeEffects);
     void ProcessContinuousEventSlice(const VibrateSlice &slice, int32_t &preStartTime, int32_t &preDuration,
         std::vector<CompositeEffect> &compositeEffects);
-    void ProcessTransientEvent(const VibrateEvent &event, int32_t &preStartTime, int32_t &preDuration,
+    void ProcessTransientEvent(const FlatVibrateEvent &event, int32_t &preStartTime, int32_t &preDuration,
         std::vector<CompositeEffect> &compositeEffects);
+    std::vector<int32_t> sliceLanes_;
+    std::vector<VibrateSlice> slices_;
 };
 }  // namespace Sensors
 }  // namespace OHOS
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "curve_interpolation.h"
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+#if defined(__aarch64__)
+struct FloatLanes {
+    static constexpr size_t WIDTH = 4;
+    using Int = int32x4_t;
+    using Float = float32x4_t;
+    static Int Load(const int32_t *p)
+    {
+        return vld1q_s32(p);
+    }
+    static void Store(int32_t *p, Int v)
+    {
+        vst1q_s32(p, v);
+    }
+    static Int Sub(Int a, Int b)
+    {
+        return vsubq_s32(a, b);
+    }
+    static Float ToFloat(Int v)
+    {
+        return vcvtq_f32_s32(v);
+    }
+    static Int Truncate(Float v)
+    {
+        return vcvtq_s32_f32(v);
+    }
+    // a + b * c with the product rounded before the sum, as the uncontracted scalar expression does.
+    static Float MulAdd(Float a, Float b, Float c)
+    {
+        return vaddq_f32(a, vmulq_f32(b, c));
+    }
+    static Float Div(Float a, Float b)
+    {
+        return vdivq_f32(a, b);
+    }
+    static Float One()
+    {
+        return vdupq_n_f32(1.0f);
+    }
+    // Lanes where a equals b take the value of whenEqual, the others keep otherwise.
+    static Float SelectEqual(Int a, Int b, Float whenEqual, Float otherwise)
+    {
+        return vbslq_f32(vceqq_s32(a, b), whenEqual, otherwise);
+    }
+    static Int SelectEqual(Int a, Int b, Int whenEqual, Int otherwise)
+    {
+        return vbslq_s32(vceqq_s32(a, b), whenEqual, otherwise);
+    }
+};
+#elif defined(__SSE2__)
+struct FloatLanes {
+    static constexpr size_t WIDTH = 4;
+    using Int = __m128i;
+    using Float = __m128;
+    static Int Load(const int32_t *p)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    }
+    static void Store(int32_t *p, Int v)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+    }
+    static Int Sub(Int a, Int b)
+    {
+        return _mm_sub_epi32(a, b);
+    }
+    static Float ToFloat(Int v)
+    {
+        return _mm_cvtepi32_ps(v);
+    }
+    static Int Truncate(Float v)
+    {
+        return _mm_cvttps_epi32(v);
+    }
+    static Float MulAdd(Float a, Float b, Float c)
+    {
+        return _mm_add_ps(a, _mm_mul_ps(b, c));
+    }
+    static Float Div(Float a, Float b)
+    {
+        return _mm_div_ps(a, b);
+    }
+    static Float One()
+    {
+        return _mm_set1_ps(1.0f);
+    }
+    static Float SelectEqual(Int a, Int b, Float whenEqual, Float otherwise)
+    {
+        __m128 mask = _mm_castsi128_ps(_mm_cmpeq_epi32(a, b));
+        return _mm_or_ps(_mm_and_ps(mask, whenEqual), _mm_andnot_ps(mask, otherwise));
+    }
+    static Int SelectEqual(Int a, Int b, Int whenEqual, Int otherwise)
+    {
+        __m128i mask = _mm_cmpeq_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(mask, whenEqual), _mm_andnot_si128(mask, otherwise));
+    }
+};
+#endif
+}  // namespace
+
+int32_t InterpolateLinear(int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t x)
+{
+    if (x1 == x2) {
+        return y1;
+    }
+    float delta_y = static_cast<float>(y2 - y1);
+    float delta_x = static_cast<float>(x2 - x1);
+    return y1 + delta_y / delta_x * (x - x1);
+}
+
+void InterpolateLinearBatch(const int32_t *x1, const int32_t *x2, const int32_t *y1, const int32_t *y2,
+    const int32_t *x, int32_t *y, size_t count)
+{
+    size_t i = 0;
+#if defined(__aarch64__) || defined(__SSE2__)
+    using L = FloatLanes;
+    for (; i + L::WIDTH <= count; i += L::WIDTH) {
+        L::Int left = L::Load(x1 + i);
+        L::Int right = L::Load(x2 + i);
+        L::Int start = L::Load(y1 + i);
+        // Vertical segments divide by one instead of zero; their lanes are replaced by y1 below.
+        L::Float deltaX = L::SelectEqual(left, right, L::One(), L::ToFloat(L::Sub(right, left)));
+        L::Float slope = L::Div(L::ToFloat(L::Sub(L::Load(y2 + i), start)), deltaX);
+        L::Float value = L::MulAdd(L::ToFloat(start), slope, L::ToFloat(L::Sub(L::Load(x + i), left)));
+        L::Store(y + i, L::SelectEqual(left, right, start, L::Truncate(value)));
+    }
+#endif
+    for (; i < count; ++i) {
+        y[i] = InterpolateLinear(x1[i], x2[i], y1[i], y2[i], x[i]);
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -15,9 +15,13 @@
 
 #include "custom_vibration_matcher.h"
 
+#include <array>
+#include <atomic>
+#include <climits>
 #include <cmath>
-#include <map>
+#include <mutex>
 
+#include "curve_interpolation.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -26,12 +30,19 @@
 namespace OHOS {
 namespace Sensors {
 namespace {
-const std::map<int32_t, std::vector<int32_t>> TRANSIENT_VIBRATION_INFOS = {
-    {0x28, {0x4d, 0x4d, 0x0b}}, {0x2c, {0x2a, 0x64, 0x07}}, {0x30, {0x44, 0x52, 0x16}},
-    {0x3c, {0x45, 0x34, 0x0a}}, {0x40, {0x2e, 0x43, 0x0a}}, {0x48, {0x51, 0x52, 0x0a}},
-    {0x4c, {0x3a, 0x0c, 0x0f}}, {0x50, {0x64, 0x20, 0x14}}, {0x54, {0x55, 0x34, 0x1c}},
-    {0x5c, {0x32, 0x0c, 0x13}}, {0x60, {0x12, 0x07, 0x0a}}
+struct TransientVibrationInfo {
+    int32_t id;
+    int32_t intensity;
+    int32_t frequency;
+    int32_t duration;
 };
+// In ascending id order, the search keeps the first of equally close effects.
+constexpr std::array<TransientVibrationInfo, 11> TRANSIENT_VIBRATION_INFOS = {{
+    {0x28, 0x4d, 0x4d, 0x0b}, {0x2c, 0x2a, 0x64, 0x07}, {0x30, 0x44, 0x52, 0x16},
+    {0x3c, 0x45, 0x34, 0x0a}, {0x40, 0x2e, 0x43, 0x0a}, {0x48, 0x51, 0x52, 0x0a},
+    {0x4c, 0x3a, 0x0c, 0x0f}, {0x50, 0x64, 0x20, 0x14}, {0x54, 0x55, 0x34, 0x1c},
+    {0x5c, 0x32, 0x0c, 0x13}, {0x60, 0x12, 0x07, 0x0a}
+}};
 constexpr int32_t FREQUENCY_MIN = 0;
 constexpr int32_t FREQUENCY_MAX = 100;
 constexpr int32_t INTENSITY_MIN = 0;
@@ -52,19 +63,80 @@ constexpr float CURVE_INTENSITY_SCALE = 100.00;
 constexpr int32_t SLICE_STEP = 50;
 constexpr int32_t CONTINUOUS_VIBRATION_DURATION_MIN = 15;
 constexpr int32_t INDEX_MIN_RESTRICT = 1;
+constexpr size_t DEFAULT_CURVE_POINTS = 2;
+
+// Weighted nearest neighbour over every transient effect and grade; used to build the match table and
+// for the rare event whose intensity or frequency lies outside the table.
+int32_t SearchTransientEffect(int32_t intensity, int32_t frequency)
+{
+    int32_t matchId = 0;
+    float minWeightSum = WEIGHT_SUM_INIT;
+    for (const auto &info : TRANSIENT_VIBRATION_INFOS) {
+        float frequencyDistance = std::abs(frequency - info.frequency);
+        for (int32_t j = 0; j < TRANSIENT_GRADE_NUM; ++j) {
+            float intensityDistance = std::abs(intensity - info.intensity * (1 - j * TRANSIENT_GRADE_GAIN));
+            float weightSum = INTENSITY_WEIGHT * intensityDistance + FREQUENCY_WEIGHT * frequencyDistance;
+            if (weightSum < minWeightSum) {
+                minWeightSum = weightSum;
+                matchId = info.id + j;
+            }
+        }
+    }
+    return matchId;
+}
+
+constexpr bool IsTransientIdInByteRange()
+{
+    for (const auto &info : TRANSIENT_VIBRATION_INFOS) {
+        if ((info.id < 0) || (info.id + TRANSIENT_GRADE_NUM - 1 > UCHAR_MAX)) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(IsTransientIdInByteRange(), "Every transient effect id and grade must fit a match table entry");
+
+// One byte per entry keeps the table at about 10KB.
+using TransientMatchTable = std::array<std::array<uint8_t, FREQUENCY_MAX + 1>, INTENSITY_MAX + 1>;
+TransientMatchTable g_transientMatchTable = {};
+std::once_flag g_transientMatchTableOnce;
+std::atomic<bool> g_transientMatchTableReady { false };
 }  // namespace
 
-int32_t CustomVibrationMatcher::TransformTime(const VibratePackage &package,
+void CustomVibrationMatcher::InitTransientMatchTable()
+{
+    std::call_once(g_transientMatchTableOnce, [] {
+        for (int32_t intensity = INTENSITY_MIN; intensity <= INTENSITY_MAX; ++intensity) {
+            for (int32_t frequency = FREQUENCY_MIN; frequency <= FREQUENCY_MAX; ++frequency) {
+                g_transientMatchTable[intensity][frequency] =
+                    static_cast<uint8_t>(SearchTransientEffect(intensity, frequency));
+            }
+        }
+        g_transientMatchTableReady.store(true, std::memory_order_release);
+    });
+}
+
+int32_t CustomVibrationMatcher::MatchTransientEffect(int32_t intensity, int32_t frequency)
+{
+    if ((intensity < INTENSITY_MIN) || (intensity > INTENSITY_MAX) ||
+        (frequency < FREQUENCY_MIN) || (frequency > FREQUENCY_MAX) ||
+        !g_transientMatchTableReady.load(std::memory_order_acquire)) {
+        return SearchTransientEffect(intensity, frequency);
+    }
+    return g_transientMatchTable[intensity][frequency];
+}
+
+int32_t CustomVibrationMatcher::TransformTime(const FlatVibratePackage &package,
     std::vector<CompositeEffect> &compositeEffects)
 {
     CALL_LOG_ENTER;
-    VibratePattern flatPattern = MixedWaveProcess(package);
-    if (flatPattern.events.empty()) {
+    FlatVibratePackage mixedPackage = MixedWaveProcess(package);
+    if (mixedPackage.events.empty()) {
         MISC_HILOGE("The events of pattern is empty");
         return ERROR;
     }
     int32_t frontTime = 0;
-    for (const VibrateEvent &event : flatPattern.events) {
+    for (const FlatVibrateEvent &event : mixedPackage.events) {
         TimeEffect timeEffect;
         timeEffect.delay = event.time - frontTime;
         timeEffect.time = event.duration;
@@ -74,7 +146,7 @@ int32_t CustomVibrationMatcher::TransformTime(const VibratePackage &package,
         frontTime = event.time;
     }
     TimeEffect timeEffect;
-    timeEffect.delay = flatPattern.events.back().duration;
+    timeEffect.delay = mixedPackage.events.back().duration;
     timeEffect.time = 0;
     CompositeEffect compositeEffect;
     compositeEffect.timeEffect = timeEffect;
@@ -82,20 +154,21 @@ int32_t CustomVibrationMatcher::TransformTime(const VibratePackage &package,
     return SUCCESS;
 }
 
-int32_t CustomVibrationMatcher::TransformEffect(const VibratePackage &package,
+int32_t CustomVibrationMatcher::TransformEffect(const FlatVibratePackage &package,
     std::vector<CompositeEffect> &compositeEffects)
 {
     CALL_LOG_ENTER;
-    VibratePattern flatPattern = MixedWaveProcess(package);
-    if (flatPattern.events.empty()) {
+    FlatVibratePackage mixedPackage = MixedWaveProcess(package);
+    if (mixedPackage.events.empty()) {
         MISC_HILOGE("The events of pattern is empty");
         return ERROR;
     }
-    int32_t preStartTime = flatPattern.startTime;
+    int32_t preStartTime = mixedPackage.patterns.front().startTime;
     int32_t preDuration = 0;
-    for (const VibrateEvent &event : flatPattern.events) {
+    for (const FlatVibrateEvent &event : mixedPackage.events) {
         if (event.tag == EVENT_TAG_CONTINUOUS) {
-            ProcessContinuousEvent(event, preStartTime, preDuration, compositeEffects);
+            ProcessContinuousEvent(event, mixedPackage.GetPoints(event), preStartTime, preDuration,
+                compositeEffects);
         } else if (event.tag == EVENT_TAG_TRANSIENT) {
             ProcessTransientEvent(event, preStartTime, preDuration, compositeEffects);
         } else {
@@ -112,56 +185,68 @@ int32_t CustomVibrationMatcher::TransformEffect(const VibratePackage &package,
     return SUCCESS;
 }
 
-VibratePattern CustomVibrationMatcher::MixedWaveProcess(const VibratePackage &package)
+FlatVibratePackage CustomVibrationMatcher::MixedWaveProcess(const FlatVibratePackage &package)
 {
-    VibratePattern outputPattern;
-    std::vector<VibrateEvent> &outputEvents = outputPattern.events;
-    for (const VibratePattern &pattern : package.patterns) {
-        for (VibrateEvent event : pattern.events) {
+    FlatVibratePackage output;
+    std::vector<FlatVibrateEvent> &outputEvents = output.events;
+    std::vector<VibrateCurvePoint> &outputPoints = output.points;
+    outputEvents.reserve(package.events.size());
+    outputPoints.reserve(package.points.size() + DEFAULT_CURVE_POINTS * package.events.size());
+    for (const FlatVibratePattern &pattern : package.patterns) {
+        for (FlatVibrateEvent event : package.GetEvents(pattern)) {
+            ArrayView<VibrateCurvePoint> curve = package.GetPoints(event);
             event.time += pattern.startTime;
-            PreProcessEvent(event);
+            // The curve of the event being appended always sits at the end of the point pool.
+            PreProcessEvent(event, curve, outputPoints);
             if ((outputEvents.empty()) ||
                 (event.time >= (outputEvents.back().time + outputEvents.back().duration)) ||
                 (outputEvents.back().tag == EVENT_TAG_TRANSIENT)) {
-                outputEvents.emplace_back(event);
-            } else {
-                VibrateEvent &lastEvent = outputEvents.back();
-                VibrateEvent newEvent = {
-                    .tag = EVENT_TAG_CONTINUOUS,
-                    .time = lastEvent.time,
-                    .duration = std::max(lastEvent.time + lastEvent.duration, event.time + event.duration)
-                        - lastEvent.time,
-                    .intensity = lastEvent.intensity,
-                    .frequency = lastEvent.frequency,
-                    .index = lastEvent.index,
-                    .points = MergeCurve(lastEvent.points, event.points),
-                };
-                outputEvents.pop_back();
-                outputEvents.push_back(newEvent);
+                outputEvents.push_back(event);
+                continue;
             }
+            FlatVibrateEvent &lastEvent = outputEvents.back();
+            std::vector<VibrateCurvePoint> mergedCurve = MergeCurve(output.GetPoints(lastEvent),
+                output.GetPoints(event));
+            lastEvent.tag = EVENT_TAG_CONTINUOUS;
+            lastEvent.duration = std::max(lastEvent.time + lastEvent.duration, event.time + event.duration) -
+                lastEvent.time;
+            lastEvent.pointCount = static_cast<uint32_t>(mergedCurve.size());
+            outputPoints.resize(lastEvent.firstPoint);
+            outputPoints.insert(outputPoints.end(), mergedCurve.begin(), mergedCurve.end());
         }
     }
-    return outputPattern;
+    output.patterns.push_back({
+        .startTime = 0,
+        .firstEvent = 0,
+        .eventCount = static_cast<uint32_t>(outputEvents.size()),
+    });
+    return output;
 }
 
-void CustomVibrationMatcher::PreProcessEvent(VibrateEvent &event)
+void CustomVibrationMatcher::PreProcessEvent(FlatVibrateEvent &event, ArrayView<VibrateCurvePoint> curve,
+    std::vector<VibrateCurvePoint> &points)
 {
-    if (event.points.empty()) {
+    event.firstPoint = static_cast<uint32_t>(points.size());
+    if (curve.empty()) {
         VibrateCurvePoint startPoint = {
             .time = 0,
             .intensity = INTENSITY_MAX,
             .frequency = 0,
         };
-        event.points.push_back(startPoint);
+        points.push_back(startPoint);
         VibrateCurvePoint endPoint = {
             .time = event.duration,
             .intensity = INTENSITY_MAX,
             .frequency = 0,
         };
-        event.points.push_back(endPoint);
+        points.push_back(endPoint);
+    } else {
+        points.insert(points.end(), curve.begin(), curve.end());
     }
+    event.pointCount = static_cast<uint32_t>(points.size()) - event.firstPoint;
     event.duration = std::max(event.duration, CONTINUOUS_VIBRATION_DURATION_MIN);
-    for (VibrateCurvePoint &curvePoint : event.points) {
+    for (size_t i = event.firstPoint; i < points.size(); ++i) {
+        VibrateCurvePoint &curvePoint = points[i];
         curvePoint.time += event.time;
         curvePoint.intensity *= (event.intensity / CURVE_INTENSITY_SCALE);
         curvePoint.intensity = std::max(curvePoint.intensity, INTENSITY_MIN);
@@ -172,8 +257,8 @@ void CustomVibrationMatcher::PreProcessEvent(VibrateEvent &event)
     }
 }
 
-std::vector<VibrateCurvePoint> CustomVibrationMatcher::MergeCurve(const std::vector<VibrateCurvePoint> &curveLeft,
-    const std::vector<VibrateCurvePoint> &curveRight)
+std::vector<VibrateCurvePoint> CustomVibrationMatcher::MergeCurve(ArrayView<VibrateCurvePoint> curveLeft,
+    ArrayView<VibrateCurvePoint> curveRight)
 {
     int32_t overlapLeft = std::max(curveLeft.front().time, curveRight.front().time);
     int32_t overlapRight = std::min(curveLeft.back().time, curveRight.back().time);
@@ -192,25 +277,25 @@ std::vector<VibrateCurvePoint> CustomVibrationMatcher::MergeCurve(const std::vec
         VibrateCurvePoint newCurvePoint;
         if (i < curveLeft.size() && j < curveRight.size()) {
             if (curveLeft[i].time < curveRight[j].time) {
-                int32_t intensity = Interpolation(curveRight[j - 1].time, curveRight[j].time,
+                int32_t intensity = InterpolateLinear(curveRight[j - 1].time, curveRight[j].time,
                     curveRight[j - 1].intensity, curveRight[j].intensity, curveLeft[i].time);
-                int32_t frequency = Interpolation(curveRight[j - 1].time, curveRight[j].time,
+                int32_t frequency = InterpolateLinear(curveRight[j - 1].time, curveRight[j].time,
                     curveRight[j - 1].frequency, curveRight[j].frequency, curveLeft[i].time);
                 newCurvePoint.time = curveLeft[i].time;
                 newCurvePoint.intensity = std::max(curveLeft[i].intensity, intensity);
                 newCurvePoint.frequency = (curveLeft[i].frequency + frequency) / 2;
                 ++i;
             } else if (curveLeft[i].time > curveRight[j].time) {
-                int32_t intensity = Interpolation(curveLeft[i - 1].time, curveLeft[i].time,
+                int32_t intensity = InterpolateLinear(curveLeft[i - 1].time, curveLeft[i].time,
                     curveLeft[i - 1].intensity, curveLeft[i].intensity, curveRight[j].time);
-                int32_t frequency = Interpolation(curveLeft[i - 1].time, curveLeft[i].time,
+                int32_t frequency = InterpolateLinear(curveLeft[i - 1].time, curveLeft[i].time,
                     curveLeft[i - 1].frequency, curveLeft[i].frequency, curveRight[j].time);
                 newCurvePoint.time = curveRight[j].time;
                 newCurvePoint.intensity = std::max(curveRight[j].intensity, intensity);
                 newCurvePoint.frequency = (curveRight[j].frequency + frequency) / 2;
                 ++j;
             } else {
-                newCurvePoint.time = curveRight[i].time;
+                newCurvePoint.time = curveRight[j].time;
                 newCurvePoint.intensity = std::max(curveLeft[i].intensity, curveRight[j].intensity);
                 newCurvePoint.frequency = (curveLeft[i].frequency + curveRight[j].frequency) / 2;
                 ++i;
@@ -222,8 +307,8 @@ std::vector<VibrateCurvePoint> CustomVibrationMatcher::MergeCurve(const std::vec
     return newCurve;
 }
 
-void CustomVibrationMatcher::ProcessContinuousEvent(const VibrateEvent &event, int32_t &preStartTime,
-    int32_t &preDuration, std::vector<CompositeEffect> &compositeEffects)
+void CustomVibrationMatcher::ProcessContinuousEvent(const FlatVibrateEvent &event, ArrayView<VibrateCurvePoint> curve,
+    int32_t &preStartTime, int32_t &preDuration, std::vector<CompositeEffect> &compositeEffects)
 {
     if (event.duration < 2 * SLICE_STEP) {
         VibrateSlice slice = {
@@ -235,16 +320,35 @@ void CustomVibrationMatcher::ProcessContinuousEvent(const VibrateEvent &event, i
         ProcessContinuousEventSlice(slice, preStartTime, preDuration, compositeEffects);
         return;
     }
-    const std::vector<VibrateCurvePoint> &curve = event.points;
+    slices_.clear();
+    SliceCurve(curve, sliceLanes_, slices_);
+    for (const VibrateSlice &slice : slices_) {
+        ProcessContinuousEventSlice(slice, preStartTime, preDuration, compositeEffects);
+    }
+}
+
+void CustomVibrationMatcher::SliceCurve(ArrayView<VibrateCurvePoint> curve, std::vector<int32_t> &lanes,
+    std::vector<VibrateSlice> &slices)
+{
     int32_t endTime = curve.back().time;
     int32_t curTime = curve.front().time;
-    int32_t curIntensity = curve.front().intensity;
-    int32_t curFrequency = curve.front().frequency;
+    if (curTime >= endTime) {
+        return;
+    }
+    // Every slice but the last is SLICE_STEP long, so this bounds the number of boundaries.
+    size_t capacity = static_cast<size_t>(endTime - curTime) / SLICE_STEP + 1;
+    // Structure of arrays for InterpolateLinearBatch: one column of capacity lanes per field.
+    enum { LEFT_TIME, RIGHT_TIME, NEXT_TIME, LEFT_INTENSITY, RIGHT_INTENSITY, LEFT_FREQUENCY, RIGHT_FREQUENCY,
+        NEXT_INTENSITY, NEXT_FREQUENCY, SLICE_TIME, COLUMN_NUM };
+    // Only grows the caller's buffer; every lane read below is written first.
+    lanes.resize(capacity * COLUMN_NUM);
+    auto column = [&lanes, capacity](int32_t index) {
+        return lanes.data() + index * capacity;
+    };
+    size_t count = 0;
     int32_t nextTime = 0;
     int32_t i = 0;
     while (curTime < endTime) {
-        int32_t nextIntensity = 0;
-        int32_t nextFrequency = 0;
         if ((endTime - curTime) >= (2 * SLICE_STEP)) {
             nextTime = curTime + SLICE_STEP;
         } else {
@@ -257,18 +361,34 @@ void CustomVibrationMatcher::ProcessContinuousEvent(const VibrateEvent &event, i
             curTime = nextTime;
             continue;
         }
-        nextIntensity = Interpolation(curve[i - 1].time, curve[i].time, curve[i - 1].intensity, curve[i].intensity,
-            nextTime);
-        nextFrequency = Interpolation(curve[i - 1].time, curve[i].time, curve[i - 1].frequency, curve[i].frequency,
-            nextTime);
+        column(LEFT_TIME)[count] = curve[i - 1].time;
+        column(RIGHT_TIME)[count] = curve[i].time;
+        column(NEXT_TIME)[count] = nextTime;
+        column(LEFT_INTENSITY)[count] = curve[i - 1].intensity;
+        column(RIGHT_INTENSITY)[count] = curve[i].intensity;
+        column(LEFT_FREQUENCY)[count] = curve[i - 1].frequency;
+        column(RIGHT_FREQUENCY)[count] = curve[i].frequency;
+        column(SLICE_TIME)[count] = curTime;
+        ++count;
+        curTime = nextTime;
+    }
+    InterpolateLinearBatch(column(LEFT_TIME), column(RIGHT_TIME), column(LEFT_INTENSITY), column(RIGHT_INTENSITY),
+        column(NEXT_TIME), column(NEXT_INTENSITY), count);
+    InterpolateLinearBatch(column(LEFT_TIME), column(RIGHT_TIME), column(LEFT_FREQUENCY), column(RIGHT_FREQUENCY),
+        column(NEXT_TIME), column(NEXT_FREQUENCY), count);
+    int32_t curIntensity = curve.front().intensity;
+    int32_t curFrequency = curve.front().frequency;
+    slices.reserve(slices.size() + count);
+    for (size_t k = 0; k < count; ++k) {
+        int32_t nextIntensity = column(NEXT_INTENSITY)[k];
+        int32_t nextFrequency = column(NEXT_FREQUENCY)[k];
         VibrateSlice slice = {
-            .time = curTime,
-            .duration = nextTime - curTime,
+            .time = column(SLICE_TIME)[k],
+            .duration = column(NEXT_TIME)[k] - column(SLICE_TIME)[k],
             .intensity = (curIntensity + nextIntensity) / 2,
             .frequency = (curFrequency + nextFrequency) / 2,
         };
-        ProcessContinuousEventSlice(slice, preStartTime, preDuration, compositeEffects);
-        curTime = nextTime;
+        slices.push_back(slice);
         curIntensity = nextIntensity;
         curFrequency = nextFrequency;
     }
@@ -304,42 +424,17 @@ void CustomVibrationMatcher::ProcessContinuousEventSlice(const VibrateSlice &sli
     preDuration = slice.duration;
 }
 
-void CustomVibrationMatcher::ProcessTransientEvent(const VibrateEvent &event, int32_t &preStartTime,
+void CustomVibrationMatcher::ProcessTransientEvent(const FlatVibrateEvent &event, int32_t &preStartTime,
     int32_t &preDuration, std::vector<CompositeEffect> &compositeEffects)
 {
-    int32_t matchId = 0;
-    float minWeightSum = WEIGHT_SUM_INIT;
-    for (const auto &transientInfo : TRANSIENT_VIBRATION_INFOS) {
-        int32_t id = transientInfo.first;
-        const std::vector<int32_t> &info = transientInfo.second;
-        float frequencyDistance = std::abs(event.frequency - info[1]);
-        for (int32_t j = 0; j < TRANSIENT_GRADE_NUM; ++j) {
-            float intensityDistance = std::abs(event.intensity - info[0] * (1 - j * TRANSIENT_GRADE_GAIN));
-            float weightSum = INTENSITY_WEIGHT * intensityDistance + FREQUENCY_WEIGHT * frequencyDistance;
-            if (weightSum < minWeightSum) {
-                minWeightSum = weightSum;
-                matchId = id + j;
-            }
-        }
-    }
     PrimitiveEffect primitiveEffect;
     primitiveEffect.delay = event.time - preStartTime;
-    primitiveEffect.effectId = matchId;
+    primitiveEffect.effectId = MatchTransientEffect(event.intensity, event.frequency);
     CompositeEffect compositeEffect;
     compositeEffect.primitiveEffect = primitiveEffect;
     compositeEffects.push_back(compositeEffect);
     preStartTime = event.time;
     preDuration = event.duration;
 }
-
-int32_t CustomVibrationMatcher::Interpolation(int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t x)
-{
-    if (x1 == x2) {
-        return y1;
-    }
-    float delta_y = static_cast<float>(y2 - y1);
-    float delta_x = static_cast<float>(x2 - x1);
-    return y1 + delta_y / delta_x * (x - x1);
-}
 }  // namespace Sensors
 }  // namespace OHOS
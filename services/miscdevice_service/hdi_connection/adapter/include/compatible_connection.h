@@ -38,7 +38,7 @@ public:
     int32_t Stop(HdfVibratorMode mode) override;
     int32_t GetDelayTime(int32_t mode, int32_t &delayTime) override;
     int32_t GetVibratorCapacity(VibratorCapacity &capacity) override;
-    int32_t PlayPattern(const VibratePattern &pattern) override;
+    int32_t PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern) override;
     int32_t DestroyHdiConnection() override;
     int32_t StartByIntensity(const std::string &effect, int32_t intensity) override;
 
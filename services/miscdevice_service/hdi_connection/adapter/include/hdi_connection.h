@@ -39,15 +39,17 @@ public:
     int32_t Stop(HdfVibratorMode mode) override;
     int32_t GetDelayTime(int32_t mode, int32_t &delayTime) override;
     int32_t GetVibratorCapacity(VibratorCapacity &capacity) override;
-    int32_t PlayPattern(const VibratePattern &pattern) override;
+    int32_t PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern) override;
     int32_t DestroyHdiConnection() override;
     void ProcessDeathObserver(const wptr<IRemoteObject> &object);
     int32_t StartByIntensity(const std::string &effect, int32_t intensity) override;
+    void SetReconnectCallback(ReconnectCallback callback) override;
 
 private:
     DISALLOW_COPY_AND_MOVE(HdiConnection);
     sptr<IVibratorInterface> vibratorInterface_ = nullptr;
     sptr<IRemoteObject::DeathRecipient> hdiDeathObserver_ = nullptr;
+    ReconnectCallback reconnectCallback_ = nullptr;
     void RegisterHdiDeathRecipient();
     void UnregisterHdiDeathRecipient();
     void Reconnect();
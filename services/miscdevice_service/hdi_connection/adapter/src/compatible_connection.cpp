@@ -164,7 +164,7 @@ int32_t CompatibleConnection::GetVibratorCapacity(VibratorCapacity &capacity)
     return ERR_OK;
 }
 
-int32_t CompatibleConnection::PlayPattern(const VibratePattern &pattern)
+int32_t CompatibleConnection::PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern)
 {
     return ERR_OK;
 }
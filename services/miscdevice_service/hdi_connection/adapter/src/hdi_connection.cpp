@@ -171,31 +171,31 @@ int32_t HdiConnection::GetVibratorCapacity(VibratorCapacity &capacity)
     return ERR_OK;
 }
 
-int32_t HdiConnection::PlayPattern(const VibratePattern &pattern)
+int32_t HdiConnection::PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern)
 {
     CHKPR(vibratorInterface_, ERR_INVALID_VALUE);
     HapticPaket packet = {};
     packet.time = pattern.startTime;
-    int32_t eventNum = static_cast<int32_t>(pattern.events.size());
-    packet.eventNum = eventNum;
-    for (int32_t i = 0; i < eventNum; ++i) {
+    packet.eventNum = static_cast<int32_t>(pattern.eventCount);
+    packet.events.reserve(pattern.eventCount);
+    for (const auto &event : package.GetEvents(pattern)) {
         HapticEvent hapticEvent = {};
-        hapticEvent.type = static_cast<EVENT_TYPE>(pattern.events[i].tag);
-        hapticEvent.time = pattern.events[i].time;
-        hapticEvent.duration = pattern.events[i].duration;
-        hapticEvent.intensity = pattern.events[i].intensity;
-        hapticEvent.frequency = pattern.events[i].frequency;
-        hapticEvent.index = pattern.events[i].index;
-        int32_t pointNum = static_cast<int32_t>(pattern.events[i].points.size());
-        hapticEvent.pointNum = pointNum;
-        for (int32_t j = 0; j < pointNum; ++j) {
+        hapticEvent.type = static_cast<EVENT_TYPE>(event.tag);
+        hapticEvent.time = event.time;
+        hapticEvent.duration = event.duration;
+        hapticEvent.intensity = event.intensity;
+        hapticEvent.frequency = event.frequency;
+        hapticEvent.index = event.index;
+        hapticEvent.pointNum = static_cast<int32_t>(event.pointCount);
+        hapticEvent.points.reserve(event.pointCount);
+        for (const auto &point : package.GetPoints(event)) {
             CurvePoint hapticPoint = {};
-            hapticPoint.time = pattern.events[i].points[j].time;
-            hapticPoint.intensity = pattern.events[i].points[j].intensity;
-            hapticPoint.frequency = pattern.events[i].points[j].frequency;
+            hapticPoint.time = point.time;
+            hapticPoint.intensity = point.intensity;
+            hapticPoint.frequency = point.frequency;
             hapticEvent.points.emplace_back(hapticPoint);
         }
-        packet.events.emplace_back(hapticEvent);
+        packet.events.emplace_back(std::move(hapticEvent));
     }
     int32_t ret = vibratorInterface_->PlayHapticPattern(packet);
     if (ret < 0) {
@@ -256,9 +256,18 @@ void HdiConnection::Reconnect()
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_HDF_SERVICE_EXCEPTION",
             HiSysEvent::EventType::FAULT, "PKG_NAME", "Reconnect", "ERROR_CODE", ret);
         MISC_HILOGE("Connect hdi fail");
+        return;
+    }
+    if (reconnectCallback_ != nullptr) {
+        reconnectCallback_();
     }
 }
 
+void HdiConnection::SetReconnectCallback(ReconnectCallback callback)
+{
+    reconnectCallback_ = callback;
+}
+
 int32_t HdiConnection::StartByIntensity(const std::string &effect, int32_t intensity)
 {
     MISC_HILOGD("Time delay measurement:end time, effect:%{public}s, intensity:%{public}d", effect.c_str(), intensity);
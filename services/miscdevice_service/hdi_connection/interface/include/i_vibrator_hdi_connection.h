@@ -16,6 +16,7 @@
 #ifndef I_VIBRATOR_HDI_CONNECTION_H
 #define I_VIBRATOR_HDI_CONNECTION_H
 
+#include <functional>
 #include <optional>
 #include <stdint.h>
 #include <string>
@@ -46,6 +47,7 @@ using OHOS::HDI::Vibrator::V1_1::PrimitiveEffect;
 using OHOS::HDI::Vibrator::V1_1::CompositeEffect;
 using OHOS::HDI::Vibrator::V1_1::HdfCompositeEffect;
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+using ReconnectCallback = std::function<void()>;
 class IVibratorHdiConnection {
 public:
     IVibratorHdiConnection() = default;
@@ -62,8 +64,9 @@ public:
     virtual int32_t DestroyHdiConnection() = 0;
     virtual int32_t GetDelayTime(int32_t mode, int32_t &delayTime) = 0;
     virtual int32_t GetVibratorCapacity(VibratorCapacity &capacity) = 0;
-    virtual int32_t PlayPattern(const VibratePattern &pattern) = 0;
+    virtual int32_t PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern) = 0;
     virtual int32_t StartByIntensity(const std::string &effect, int32_t intensity) = 0;
+    virtual void SetReconnectCallback(ReconnectCallback callback) {}
 
 private:
     DISALLOW_COPY_AND_MOVE(IVibratorHdiConnection);
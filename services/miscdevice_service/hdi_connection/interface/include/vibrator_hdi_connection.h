@@ -16,6 +16,10 @@
 #ifndef VIBRATOR_HDI_CONNECTION_H
 #define VIBRATOR_HDI_CONNECTION_H
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include "singleton.h"
 
 #include "i_vibrator_hdi_connection.h"
@@ -38,12 +42,21 @@ public:
     int32_t DestroyHdiConnection() override;
     int32_t GetDelayTime(int32_t mode, int32_t &delayTime) override;
     int32_t GetVibratorCapacity(VibratorCapacity &capacity) override;
-    int32_t PlayPattern(const VibratePattern &pattern) override;
+    int32_t PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern) override;
     int32_t StartByIntensity(const std::string &effect, int32_t intensity) override;
+    void SetReconnectCallback(ReconnectCallback callback) override;
 
 private:
+    using EffectCatalog = std::unordered_map<std::string, HdfEffectInfo>;
     DISALLOW_COPY_AND_MOVE(VibratorHdiConnection);
+    void ResetEffectCatalog();
     std::unique_ptr<IVibratorHdiConnection> iVibratorHdiConnection_ = nullptr;
+    // Effects the HDI reported as supported. Replaced as a whole on insert and read with
+    // atomic_load, so lookups never take a lock; cleared whenever the HDI reconnects.
+    std::shared_ptr<const EffectCatalog> effectCatalog_ = std::make_shared<const EffectCatalog>();
+    std::mutex effectCatalogMutex_;
+    ReconnectCallback reconnectCallback_ = nullptr;
+    std::mutex reconnectCallbackMutex_;
 };
 }  // namespace Sensors
 }  // namespace OHOS
@@ -27,9 +27,13 @@
 
 namespace OHOS {
 namespace Sensors {
+namespace {
+constexpr size_t MAX_EFFECT_CATALOG_SIZE = 256;
+}  // namespace
 
 int32_t VibratorHdiConnection::ConnectHdi()
 {
+    ResetEffectCatalog();
     iVibratorHdiConnection_ = std::make_unique<HdiConnection>();
     int32_t ret = iVibratorHdiConnection_->ConnectHdi();
 #ifdef BUILD_VARIANT_ENG
@@ -43,6 +47,19 @@ int32_t VibratorHdiConnection::ConnectHdi()
         return VIBRATOR_HDF_CONNECT_ERR;
     }
 #endif // BUILD_VARIANT_ENG
+    if (ret == ERR_OK) {
+        iVibratorHdiConnection_->SetReconnectCallback([this]() {
+            ResetEffectCatalog();
+            ReconnectCallback callback = nullptr;
+            {
+                std::lock_guard<std::mutex> callbackLock(reconnectCallbackMutex_);
+                callback = reconnectCallback_;
+            }
+            if (callback != nullptr) {
+                callback();
+            }
+        });
+    }
     return ret;
 }
 
@@ -99,12 +116,42 @@ std::optional<HdfEffectInfo> VibratorHdiConnection::GetEffectInfo(const std::str
         MISC_HILOGE("Connect hdi failed");
         return std::nullopt;
     }
+    std::shared_ptr<const EffectCatalog> catalog = std::atomic_load(&effectCatalog_);
+    auto it = catalog->find(effect);
+    if (it != catalog->end()) {
+        return it->second;
+    }
     StartTrace(HITRACE_TAG_SENSORS, "GetEffectInfo");
     std::optional<HdfEffectInfo> ret = iVibratorHdiConnection_->GetEffectInfo(effect);
     FinishTrace(HITRACE_TAG_SENSORS);
+    // Only effects the HDI supports are cached, so client-chosen names cannot fill the catalog.
+    if ((!ret.has_value()) || (!ret->isSupportEffect)) {
+        return ret;
+    }
+    std::lock_guard<std::mutex> catalogLock(effectCatalogMutex_);
+    catalog = std::atomic_load(&effectCatalog_);
+    if (catalog->size() >= MAX_EFFECT_CATALOG_SIZE) {
+        MISC_HILOGW("Effect catalog is full, effect:%{public}s", effect.c_str());
+        return ret;
+    }
+    auto newCatalog = std::make_shared<EffectCatalog>(*catalog);
+    newCatalog->emplace(effect, ret.value());
+    std::atomic_store(&effectCatalog_, std::shared_ptr<const EffectCatalog>(std::move(newCatalog)));
     return ret;
 }
 
+void VibratorHdiConnection::SetReconnectCallback(ReconnectCallback callback)
+{
+    std::lock_guard<std::mutex> callbackLock(reconnectCallbackMutex_);
+    reconnectCallback_ = callback;
+}
+
+void VibratorHdiConnection::ResetEffectCatalog()
+{
+    std::lock_guard<std::mutex> catalogLock(effectCatalogMutex_);
+    std::atomic_store(&effectCatalog_, std::make_shared<const EffectCatalog>());
+}
+
 int32_t VibratorHdiConnection::Stop(HdfVibratorMode mode)
 {
     CHKPR(iVibratorHdiConnection_, VIBRATOR_HDF_CONNECT_ERR);
@@ -130,10 +177,10 @@ int32_t VibratorHdiConnection::GetVibratorCapacity(VibratorCapacity &capacity)
     return iVibratorHdiConnection_->GetVibratorCapacity(capacity);
 }
     
-int32_t VibratorHdiConnection::PlayPattern(const VibratePattern &pattern)
+int32_t VibratorHdiConnection::PlayPattern(const FlatVibratePackage &package, const FlatVibratePattern &pattern)
 {
     CHKPR(iVibratorHdiConnection_, VIBRATOR_HDF_CONNECT_ERR);
-    return iVibratorHdiConnection_->PlayPattern(pattern);
+    return iVibratorHdiConnection_->PlayPattern(package, pattern);
 }
 
 int32_t VibratorHdiConnection::DestroyHdiConnection()
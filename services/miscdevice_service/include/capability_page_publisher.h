@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CAPABILITY_PAGE_PUBLISHER_H
+#define CAPABILITY_PAGE_PUBLISHER_H
+
+#include <mutex>
+
+#include "ashmem.h"
+#include "nocopyable.h"
+
+#include "capability_page.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Owns the service side of the capability page. The service keeps its own writable
+ * mapping, while the ashmem region handed to clients only allows read-only mappings.
+ */
+class CapabilityPagePublisher {
+public:
+    CapabilityPagePublisher() = default;
+    ~CapabilityPagePublisher();
+    bool Init();
+    void Publish(const CapabilitySnapshot &snapshot);
+    sptr<Ashmem> GetAshmem();
+
+private:
+    DISALLOW_COPY_AND_MOVE(CapabilityPagePublisher);
+    std::mutex pageMutex_;
+    sptr<Ashmem> ashmem_ = nullptr;
+    CapabilityPageLayout *page_ = nullptr;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // CAPABILITY_PAGE_PUBLISHER_H
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLIENT_SESSION_MANAGER_H
+#define CLIENT_SESSION_MANAGER_H
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "accesstoken_kit.h"
+#include "iremote_object.h"
+#include "singleton.h"
+
+#include "interned_string.h"
+
+namespace OHOS {
+namespace Sensors {
+using namespace Security::AccessToken;
+enum ClientPermission {
+    CLIENT_PERMISSION_VIBRATE = 0,
+    CLIENT_PERMISSION_LIGHT = 1,
+    CLIENT_PERMISSION_MAX = 2,
+};
+
+/*
+ * Everything the service needs to know about a calling token, resolved once and
+ * reused until the token's permissions change or its client dies. Permission verdicts
+ * are only cached while the permission observer is registered.
+ */
+struct ClientSession {
+    static constexpr int32_t VERDICT_UNKNOWN = -2;
+    AccessTokenID tokenId = 0;
+    InternedString packageName;
+    std::array<std::atomic<int32_t>, CLIENT_PERMISSION_MAX> verdicts;
+    // Set once a client with a death recipient is bound; unbound sessions are evicted first.
+    std::atomic_bool bound = false;
+    ClientSession();
+};
+
+class ClientSessionManager {
+    DECLARE_DELAYED_SINGLETON(ClientSessionManager);
+public:
+    DISALLOW_COPY_AND_MOVE(ClientSessionManager);
+    int32_t CheckPermission(AccessTokenID tokenId, ClientPermission permission);
+    InternedString GetPackageName(AccessTokenID tokenId);
+    void OpenSession(const sptr<IRemoteObject> &client, AccessTokenID tokenId);
+    void CloseSession(const sptr<IRemoteObject> &client);
+    void InvalidateSession(AccessTokenID tokenId);
+    int32_t RegisterPermissionObserver();
+
+private:
+    static constexpr size_t SESSION_SHARD_COUNT = 16;
+    static constexpr size_t SESSION_SHARD_CAPACITY = 32;
+    struct SessionShard {
+        std::shared_mutex mutex;
+        std::unordered_map<AccessTokenID, std::shared_ptr<ClientSession>> sessions;
+    };
+    std::shared_ptr<ClientSession> GetSession(AccessTokenID tokenId);
+    SessionShard &GetShard(AccessTokenID tokenId);
+    InternedString ResolvePackageName(AccessTokenID tokenId);
+    std::array<SessionShard, SESSION_SHARD_COUNT> shards_;
+    std::mutex clientMutex_;
+    std::map<sptr<IRemoteObject>, AccessTokenID> clientTokenMap_;
+    std::mutex observerMutex_;
+    std::shared_ptr<PermStateChangeCallbackCustomize> permissionObserver_ = nullptr;
+    std::atomic_bool observerRegistered_ = false;
+};
+#define SessionManager DelayedSingleton<ClientSessionManager>::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // CLIENT_SESSION_MANAGER_H
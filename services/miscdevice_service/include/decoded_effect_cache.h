@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DECODED_EFFECT_CACHE_H
+#define DECODED_EFFECT_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "nocopyable.h"
+#include "singleton.h"
+
+#include "raw_file_descriptor.h"
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+// Identity of the bytes behind a RawFileDescriptor, taken from fstat.
+struct EffectFileKey {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    int64_t mtimeSec = 0;
+    int64_t mtimeNsec = 0;
+    int64_t size = 0;
+    int64_t offset = 0;
+    int64_t length = 0;
+    bool operator==(const EffectFileKey &other) const;
+};
+
+struct EffectFileKeyHash {
+    size_t operator()(const EffectFileKey &key) const;
+};
+
+struct EffectCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+/*
+ * LRU cache of decoded custom effects, so replaying the same file skips decoding.
+ * Entries are charged by their estimated heap size against a fixed budget.
+ */
+class DecodedEffectCache {
+    DECLARE_DELAYED_SINGLETON(DecodedEffectCache);
+public:
+    DISALLOW_COPY_AND_MOVE(DecodedEffectCache);
+    static bool GetFileKey(const RawFileDescriptor &rawFd, EffectFileKey &key);
+    std::shared_ptr<const FlatVibratePackage> Find(const EffectFileKey &key);
+    void Insert(const EffectFileKey &key, std::shared_ptr<const FlatVibratePackage> package);
+    EffectCacheStats GetStats();
+
+private:
+    static constexpr size_t CACHE_BUDGET_BYTES = 1024 * 1024;
+    struct CacheEntry {
+        EffectFileKey key;
+        std::shared_ptr<const FlatVibratePackage> package = nullptr;
+        size_t bytes = 0;
+    };
+    static size_t EstimateBytes(const FlatVibratePackage &package);
+    std::mutex cacheMutex_;
+    std::list<CacheEntry> lru_;
+    std::unordered_map<EffectFileKey, std::list<CacheEntry>::iterator, EffectFileKeyHash> index_;
+    size_t bytes_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+#define EffectCache DelayedSingleton<DecodedEffectCache>::GetInstance()
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // DECODED_EFFECT_CACHE_H
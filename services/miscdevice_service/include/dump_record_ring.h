@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DUMP_RECORD_RING_H
+#define DUMP_RECORD_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Fixed-capacity ring of trivially copyable records with one writer and any number of
+ * readers. Each slot is a seqlock: readers copy optimistically and drop a record that was
+ * overwritten meanwhile, so the writer never waits for a reader.
+ */
+template<typename T, size_t CAPACITY>
+class DumpRecordRing {
+    static_assert(std::is_trivially_copyable_v<T>, "Records must be trivially copyable");
+    static_assert(CAPACITY > 0, "Capacity must not be zero");
+
+public:
+    DumpRecordRing() = default;
+    ~DumpRecordRing() = default;
+
+    // Must only be called by one thread at a time.
+    void Push(const T &record)
+    {
+        uint64_t pos = head_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[pos % CAPACITY];
+        slot.sequence.store(2 * pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        uint64_t words[WORDS] = {};
+        memcpy(words, &record, sizeof(T));
+        for (size_t i = 0; i < WORDS; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.sequence.store(2 * pos + 2, std::memory_order_release);
+        head_.store(pos + 1, std::memory_order_release);
+    }
+
+    // Oldest record first.
+    std::vector<T> Snapshot() const
+    {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        uint64_t begin = (head > CAPACITY) ? (head - CAPACITY) : 0;
+        std::vector<T> records;
+        records.reserve(head - begin);
+        for (uint64_t pos = begin; pos < head; ++pos) {
+            const Slot &slot = slots_[pos % CAPACITY];
+            uint64_t expected = 2 * pos + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != expected) {
+                continue;
+            }
+            uint64_t words[WORDS];
+            for (size_t i = 0; i < WORDS; ++i) {
+                words[i] = slot.words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+                continue;
+            }
+            T record;
+            memcpy(&record, words, sizeof(T));
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    bool Empty() const
+    {
+        return (head_.load(std::memory_order_acquire) == 0);
+    }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    struct Slot {
+        std::atomic<uint64_t> sequence { 0 };
+        std::atomic<uint64_t> words[WORDS] {};
+    };
+    Slot slots_[CAPACITY];
+    std::atomic<uint64_t> head_ { 0 };
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // DUMP_RECORD_RING_H
@@ -16,18 +16,53 @@
 #ifndef MISCDEVICE_DUMP_H
 #define MISCDEVICE_DUMP_H
 
-#include <queue>
+#include <string>
+#include <vector>
 
 #include "singleton.h"
 
+#include "dump_record_ring.h"
+#include "interned_string.h"
 #include "nocopyable.h"
 #include "vibrator_infos.h"
 
 namespace OHOS {
 namespace Sensors {
+// Raw clock readings; only hidumper turns them into calendar time.
+struct VibrateTimestamp {
+    int64_t monotonicNs = 0;
+    int64_t realtimeNs = 0;
+};
+
+VibrateTimestamp GetVibrateTimestamp();
+
+// Compact copy of a VibrateInfo; custom vibrations keep the package's content hash instead of the package.
 struct VibrateRecord {
-    std::string startTime;
-    VibrateInfo info;
+    // Copied inline and truncated, so recording takes no lock and allocates nothing.
+    static constexpr size_t EFFECT_NAME_SIZE = 48;
+    VibrateTimestamp startTime;
+    InternedString packageName;
+    char effect[EFFECT_NAME_SIZE] = {};
+    uint64_t packageHash = 0;
+    int32_t pid = -1;
+    int32_t uid = -1;
+    int32_t usage = 0;
+    int32_t duration = 0;
+    int32_t count = 0;
+    VibrateMode mode = VibrateMode::BUTT;
+};
+
+struct PlaybackDrift {
+    uint32_t stepCount = 0;
+    int64_t maxLatenessUs = 0;
+    int64_t totalLatenessUs = 0;
+};
+
+struct PlaybackDriftRecord {
+    VibrateTimestamp endTime;
+    VibrateMode mode = VibrateMode::BUTT;
+    InternedString packageName;
+    PlaybackDrift drift;
 };
 
 class MiscdeviceDump {
@@ -38,12 +73,17 @@ public:
     void DumpMiscdeviceRecord(int32_t fd);
     void ParseCommand(int32_t fd, const std::vector<std::string> &args);
     void SaveVibrateRecord(const VibrateInfo &vibrateInfo);
+    void SavePlaybackDrift(const VibrateInfo &vibrateInfo, const PlaybackDrift &drift);
 
 private:
-    std::queue<VibrateRecord> dumpQueue_;
-    std::mutex recordQueueMutex_;
-    void DumpCurrentTime(std::string &startTime);
-    void UpdateRecordQueue(const VibrateRecord &record);
+    static constexpr size_t MAX_DUMP_RECORD_SIZE = 30;
+    // Written by the binder thread holding the service's vibrator mutex.
+    DumpRecordRing<VibrateRecord, MAX_DUMP_RECORD_SIZE> recordRing_;
+    // Written by the vibrator thread.
+    DumpRecordRing<PlaybackDriftRecord, MAX_DUMP_RECORD_SIZE> driftRing_;
+    void DumpEffectCache(int32_t fd);
+    void DumpPlaybackDrift(int32_t fd);
+    std::string FormatTimestamp(const VibrateTimestamp &timestamp);
     std::string GetUsageName(int32_t usage);
     void RunVibratorDump(int32_t fd, int32_t optionIndex, const std::vector<std::string> &args, char **argv);
 };
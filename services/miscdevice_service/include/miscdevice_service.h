@@ -28,6 +28,7 @@
 #include "system_ability.h"
 #include "thread_ex.h"
 
+#include "capability_page_publisher.h"
 #include "file_utils.h"
 #include "json_parser.h"
 #include "light_hdi_connection.h"
@@ -35,6 +36,7 @@
 #include "miscdevice_delayed_sp_singleton.h"
 #include "miscdevice_dump.h"
 #include "miscdevice_service_stub.h"
+#include "playback_plan.h"
 #include "vibrator_hdi_connection.h"
 #include "vibrator_infos.h"
 #include "vibrator_thread.h"
@@ -47,6 +49,11 @@ enum class MiscdeviceServiceState {
     STATE_RUNNING,
 };
 
+struct RegisteredEffect {
+    std::shared_ptr<const FlatVibratePackage> package = nullptr;
+    int32_t pid = -1;
+};
+
 class MiscdeviceService : public SystemAbility, public MiscdeviceServiceStub {
     DECLARE_SYSTEM_ABILITY(MiscdeviceService)
     MISCDEVICE_DECLARE_DELAYED_SP_SINGLETON(MiscdeviceService);
@@ -80,17 +87,24 @@ public:
     virtual int32_t PlayPrimitiveEffect(int32_t vibratorId, const std::string &effect, int32_t intensity,
                                         int32_t usage) override;
     virtual int32_t GetVibratorCapacity(VibratorCapacity &capacity) override;
+    virtual int32_t RegisterEffect(const VibratePackage &package, int32_t &handle) override;
+    virtual int32_t PlayEffectHandle(int32_t handle, int32_t usage, const VibrateParameter &parameter) override;
+    virtual int32_t ReleaseEffect(int32_t handle) override;
+    virtual int32_t GetCapabilityPage(sptr<Ashmem> &ashmem) override;
 
 private:
     DISALLOW_COPY_AND_MOVE(MiscdeviceService);
     bool InitInterface();
     bool InitLightInterface();
-    std::string GetPackageName(AccessTokenID tokenId);
-    void StartVibrateThread(VibrateInfo info);
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    std::shared_ptr<const FlatVibratePackage> DecodeCustomEffect(const RawFileDescriptor &rawFd);
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    int32_t StartVibrateThread(const VibrateInfo &info, std::shared_ptr<const PlaybackPlan> plan);
     void StopVibrateThread();
     bool ShouldIgnoreVibrate(const VibrateInfo &info);
-    void VibrateCurrentTime(std::string &startTime);
-    void MergeVibratorParmeters(const VibrateParameter &parameter, VibratePackage &package);
+    void MergeVibratorParmeters(const VibrateParameter &parameter, FlatVibratePackage &package);
+    std::shared_ptr<const FlatVibratePackage> MergeVibratorParmeters(const VibrateParameter &parameter,
+        const std::shared_ptr<const FlatVibratePackage> &package);
     bool CheckVibratorParmeters(const VibrateParameter &parameter);
     bool InitLightList();
     void RegisterClientDeathRecipient(sptr<IRemoteObject> vibratorServiceClient, int32_t pid);
@@ -98,10 +112,14 @@ private:
     void SaveClientPid(const sptr<IRemoteObject> &vibratorServiceClient, int32_t pid);
     int32_t FindClientPid(const sptr<IRemoteObject> &vibratorServiceClient);
     void DestroyClientPid(const sptr<IRemoteObject> &vibratorServiceClient);
+    VibrateMode GetCustomVibrateMode();
+    void ReleaseClientEffects(int32_t pid);
+    void PublishCapabilityPage();
     VibratorHdiConnection &vibratorHdiConnection_ = VibratorHdiConnection::GetInstance();
     LightHdiConnection &lightHdiConnection_ = LightHdiConnection::GetInstance();
     bool lightExist_;
     bool vibratorExist_;
+    std::mutex lightInfosMutex_;
     std::vector<LightInfoIPC> lightInfos_;
     std::map<MiscdeviceDeviceId, bool> miscDeviceIdMap_;
     MiscdeviceServiceState state_;
@@ -111,6 +129,10 @@ private:
     std::mutex clientDeathObserverMutex_;
     std::map<sptr<IRemoteObject>, int32_t> clientPidMap_;
     std::mutex clientPidMapMutex_;
+    std::unordered_map<int32_t, RegisteredEffect> effectHandles_;
+    int32_t lastEffectHandle_ = 0;
+    std::mutex effectHandleMutex_;
+    CapabilityPagePublisher capabilityPage_;
 };
 }  // namespace Sensors
 }  // namespace OHOS
@@ -61,6 +61,10 @@ private:
     int32_t TransferClientRemoteObjectStub(MessageParcel &data, MessageParcel &reply);
     int32_t PlayPrimitiveEffectStub(MessageParcel &data, MessageParcel &reply);
     int32_t GetVibratorCapacityStub(MessageParcel &data, MessageParcel &reply);
+    int32_t RegisterEffectStub(MessageParcel &data, MessageParcel &reply);
+    int32_t PlayEffectHandleStub(MessageParcel &data, MessageParcel &reply);
+    int32_t ReleaseEffectStub(MessageParcel &data, MessageParcel &reply);
+    int32_t GetCapabilityPageStub(MessageParcel &data, MessageParcel &reply);
     std::map<uint32_t, MiscBaseFunc> baseFuncs_;
 };
 }  // namespace Sensors
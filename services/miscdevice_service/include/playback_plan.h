@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PLAYBACK_PLAN_H
+#define PLAYBACK_PLAN_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "i_vibrator_hdi_connection.h"
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+enum class PlaybackStepType {
+    START_ONCE = 0,
+    START_EFFECT,
+    START_BY_INTENSITY,
+    PLAY_PATTERN,
+    ENABLE_COMPOSITE_EFFECT,
+    STOP,
+};
+
+struct PlaybackStep {
+    PlaybackStepType type = PlaybackStepType::STOP;
+    int32_t time = 0;   // ms from the start of playback
+    int32_t value = 0;  // duration, intensity or HdfVibratorMode, depending on type
+    size_t index = 0;   // into PlaybackPlan::package->patterns or PlaybackPlan::compositeEffects
+};
+
+/*
+ * Flat list of timed HDI commands compiled from a VibrateInfo when the request is admitted.
+ * The worker only walks it; a step is never built on the playback thread.
+ */
+struct PlaybackPlan {
+    std::string effect;
+    std::shared_ptr<const FlatVibratePackage> package = nullptr;
+    std::vector<HdfCompositeEffect> compositeEffects;
+    int32_t compositeMode = -1;
+    std::vector<PlaybackStep> steps;
+    int32_t duration = 0;
+    HdfVibratorMode stopMode = HDF_VIBRATOR_MODE_PRESET;
+};
+
+int32_t BuildPlaybackPlan(const VibrateInfo &info, PlaybackPlan &plan);
+void UpdateCompositeSubmitLatency(int64_t latencyUs);
+int64_t GetCompositeSubmitLatency();
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // PLAYBACK_PLAN_H
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATE_COMMAND_QUEUE_H
+#define VIBRATE_COMMAND_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "playback_plan.h"
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+enum class VibrateCommandType {
+    PLAY = 0,
+    STOP = 1,
+};
+
+struct VibrateCommand {
+    VibrateCommandType type = VibrateCommandType::STOP;
+    uint64_t sequence = 0;
+    std::shared_ptr<const VibrateInfo> info = nullptr;
+    std::shared_ptr<const PlaybackPlan> plan = nullptr;
+};
+
+/*
+ * Bounded lock-free queue with any number of producers and exactly one consumer.
+ * Every cell carries a sequence number that tells producers whether it is free and
+ * tells the consumer whether it has been published, so neither side takes a lock.
+ */
+template<typename T, size_t CAPACITY>
+class MpscQueue {
+    static_assert((CAPACITY >= 2) && ((CAPACITY & (CAPACITY - 1)) == 0), "Capacity must be a power of two");
+
+public:
+    MpscQueue()
+    {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~MpscQueue() = default;
+
+    bool Push(T &&value)
+    {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &cells_[pos & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Must only be called from the consumer thread.
+    bool Pop(T &value)
+    {
+        Cell &cell = cells_[dequeuePos_ & MASK];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePos_ + 1) < 0) {
+            return false;
+        }
+        value = std::move(cell.data);
+        cell.data = T();
+        cell.sequence.store(dequeuePos_ + CAPACITY, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+    // Must only be called from the consumer thread.
+    bool Empty() const
+    {
+        const Cell &cell = cells_[dequeuePos_ & MASK];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        return (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeuePos_ + 1) < 0);
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    struct Cell {
+        std::atomic<size_t> sequence { 0 };
+        T data;
+    };
+    Cell cells_[CAPACITY];
+    std::atomic<size_t> enqueuePos_ { 0 };
+    size_t dequeuePos_ = 0;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATE_COMMAND_QUEUE_H
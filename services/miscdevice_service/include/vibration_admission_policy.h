@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATION_ADMISSION_POLICY_H
+#define VIBRATION_ADMISSION_POLICY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+enum VibrateStatus {
+    VIBRATION = 0,
+    IGNORE_BACKGROUND = 1,
+    IGNORE_LOW_POWER = 2,
+    IGNORE_GLOBAL_SETTINGS = 3,
+    IGNORE_RINGTONE = 4,
+    IGNORE_REPEAT = 5,
+    IGNORE_ALARM = 6,
+    IGNORE_UNKNOWN = 7,
+    IGNORE_RINGER_MODE = 8,
+    IGNORE_FEEDBACK = 9,
+};
+
+constexpr uint32_t UsageMask(int32_t usage)
+{
+    return (1U << static_cast<uint32_t>(usage));
+}
+
+// Policy definition. The admission table below is generated from these rules only.
+// Usages muted while the ringer is silent.
+constexpr uint32_t RINGER_SILENCED_USAGES = UsageMask(USAGE_ALARM) | UsageMask(USAGE_RING) |
+    UsageMask(USAGE_NOTIFICATION) | UsageMask(USAGE_COMMUNICATION);
+// Usages muted while haptic feedback is switched off.
+constexpr uint32_t FEEDBACK_SILENCED_USAGES = UsageMask(USAGE_TOUCH) | UsageMask(USAGE_MEDIA) |
+    UsageMask(USAGE_UNKNOWN) | UsageMask(USAGE_PHYSICAL_FEEDBACK) | UsageMask(USAGE_SIMULATE_REALITY);
+// Running usages that nothing but a loop vibration may preempt.
+constexpr uint32_t UNINTERRUPTIBLE_USAGES = UsageMask(USAGE_ALARM);
+// Incoming usages that never preempt a vibration of a different usage.
+constexpr uint32_t LOW_PRIORITY_USAGES = UsageMask(USAGE_UNKNOWN);
+
+struct AdmissionState {
+    int32_t usage = USAGE_UNKNOWN;
+    bool isLoop = false;
+    bool isVibrating = false;
+    int32_t currentUsage = USAGE_UNKNOWN;
+    bool isCurrentLoop = false;
+    bool isRingerSilent = false;
+    bool isFeedbackOff = false;
+};
+
+constexpr VibrateStatus DecideAdmission(const AdmissionState &state)
+{
+    if (state.isRingerSilent && ((RINGER_SILENCED_USAGES & UsageMask(state.usage)) != 0)) {
+        return IGNORE_RINGER_MODE;
+    }
+    if (state.isFeedbackOff && ((FEEDBACK_SILENCED_USAGES & UsageMask(state.usage)) != 0)) {
+        return IGNORE_FEEDBACK;
+    }
+    if (!state.isVibrating || state.isLoop) {
+        return VIBRATION;
+    }
+    if ((UNINTERRUPTIBLE_USAGES & UsageMask(state.currentUsage)) != 0) {
+        return IGNORE_ALARM;
+    }
+    if (state.isCurrentLoop) {
+        return IGNORE_REPEAT;
+    }
+    if ((state.currentUsage != state.usage) && ((LOW_PRIORITY_USAGES & UsageMask(state.usage)) != 0)) {
+        return IGNORE_UNKNOWN;
+    }
+    return VIBRATION;
+}
+
+// Current vibration: 0 when idle, otherwise 1 + usage * 2 + loop flag.
+constexpr size_t ADMISSION_CURRENT_STATES = 1 + static_cast<size_t>(USAGE_MAX) * 2;
+constexpr size_t ADMISSION_TABLE_SIZE = static_cast<size_t>(USAGE_MAX) * 2 * ADMISSION_CURRENT_STATES * 2 * 2;
+
+constexpr size_t GetAdmissionIndex(const AdmissionState &state)
+{
+    size_t current = state.isVibrating ?
+        (1 + static_cast<size_t>(state.currentUsage) * 2 + (state.isCurrentLoop ? 1 : 0)) : 0;
+    size_t index = static_cast<size_t>(state.usage) * 2 + (state.isLoop ? 1 : 0);
+    index = index * ADMISSION_CURRENT_STATES + current;
+    index = index * 2 + (state.isRingerSilent ? 1 : 0);
+    return index * 2 + (state.isFeedbackOff ? 1 : 0);
+}
+
+constexpr std::array<uint8_t, ADMISSION_TABLE_SIZE> BuildAdmissionTable()
+{
+    std::array<uint8_t, ADMISSION_TABLE_SIZE> table {};
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        for (int32_t current = 0; current < static_cast<int32_t>(ADMISSION_CURRENT_STATES); ++current) {
+            for (uint32_t flags = 0; flags < (1U << 3); ++flags) {
+                AdmissionState state;
+                state.usage = usage;
+                state.isLoop = ((flags & 1U) != 0);
+                state.isRingerSilent = ((flags & 2U) != 0);
+                state.isFeedbackOff = ((flags & 4U) != 0);
+                state.isVibrating = (current != 0);
+                state.currentUsage = state.isVibrating ? ((current - 1) / 2) : USAGE_UNKNOWN;
+                state.isCurrentLoop = state.isVibrating && (((current - 1) % 2) != 0);
+                table[GetAdmissionIndex(state)] = static_cast<uint8_t>(DecideAdmission(state));
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<uint8_t, ADMISSION_TABLE_SIZE> ADMISSION_TABLE = BuildAdmissionTable();
+
+// The caller guarantees usage and currentUsage are in [0, USAGE_MAX).
+constexpr VibrateStatus LookupAdmission(const AdmissionState &state)
+{
+    return static_cast<VibrateStatus>(ADMISSION_TABLE[GetAdmissionIndex(state)]);
+}
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATION_ADMISSION_POLICY_H
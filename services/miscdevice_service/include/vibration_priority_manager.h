@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -26,37 +27,13 @@
 #include "singleton.h"
 
 #include "miscdevice_observer.h"
+#include "vibration_admission_policy.h"
+#include "vibration_settings.h"
 #include "vibrator_infos.h"
 #include "vibrator_thread.h"
 
 namespace OHOS {
 namespace Sensors {
-enum VibrateStatus {
-    VIBRATION = 0,
-    IGNORE_BACKGROUND = 1,
-    IGNORE_LOW_POWER = 2,
-    IGNORE_GLOBAL_SETTINGS = 3,
-    IGNORE_RINGTONE = 4,
-    IGNORE_REPEAT = 5,
-    IGNORE_ALARM = 6,
-    IGNORE_UNKNOWN = 7,
-    IGNORE_RINGER_MODE = 8,
-    IGNORE_FEEDBACK = 9,
-};
-
-enum RingerMode {
-    RINGER_MODE_INVALID = -1,
-    RINGER_MODE_SILENT = 0,
-    RINGER_MODE_VIBRATE = 1,
-    RINGER_MODE_NORMAL = 2
-};
-
-enum FeedbackMode {
-    FEEDBACK_MODE_INVALID = -1,
-    FEEDBACK_MODE_OFF = 0,
-    FEEDBACK_MODE_ON = 1
-};
-
 class VibrationPriorityManager {
     DECLARE_DELAYED_SINGLETON(VibrationPriorityManager);
 public:
@@ -66,10 +43,11 @@ public:
 private:
     bool IsCurrentVibrate(std::shared_ptr<VibratorThread> vibratorThread) const;
     bool IsLoopVibrate(const VibrateInfo &vibrateInfo) const;
-    VibrateStatus ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo, VibrateInfo currentVibrateInfo) const;
-    static void ExecRegisterCb(const sptr<MiscDeviceObserver> &observer);
     int32_t RegisterObserver(const sptr<MiscDeviceObserver> &observer);
     int32_t UnregisterObserver(const sptr<MiscDeviceObserver> &observer);
+    int32_t QuerySettings(std::map<std::string, std::string> &values);
+    int32_t LoadSettings(SettingsSnapshot &snapshot);
+    int32_t RefreshSettings(SettingsSnapshot &snapshot);
     int32_t GetIntValue(const std::string &key, int32_t &value);
     int32_t GetLongValue(const std::string &key, int64_t &value);
     int32_t GetStringValue(const std::string &key, std::string &value);
@@ -78,11 +56,11 @@ private:
     bool ReleaseDataShareHelper(std::shared_ptr<DataShare::DataShareHelper> &helper);
     sptr<MiscDeviceObserver> CreateObserver(const MiscDeviceObserver::UpdateFunc &func);
     void Initialize();
-    void UpdateStatus();
     sptr<IRemoteObject> remoteObj_ { nullptr };
     sptr<MiscDeviceObserver> observer_ { nullptr };
-    std::atomic_int32_t miscFeedback_ = FEEDBACK_MODE_INVALID;
-    std::atomic_int32_t miscAudioRingerMode_ = RINGER_MODE_INVALID;
+    // Touched only by settings loads, which never run concurrently, and by the destructor after Stop.
+    bool observerRegistered_ = false;
+    VibrationSettings settings_ { [this](SettingsSnapshot &snapshot) { return RefreshSettings(snapshot); } };
 };
 #define PriorityManager DelayedSingleton<VibrationPriorityManager>::GetInstance()
 }  // namespace Sensors
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATION_SETTINGS_H
+#define VIBRATION_SETTINGS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Sensors {
+enum RingerMode {
+    RINGER_MODE_INVALID = -1,
+    RINGER_MODE_SILENT = 0,
+    RINGER_MODE_VIBRATE = 1,
+    RINGER_MODE_NORMAL = 2
+};
+
+enum FeedbackMode {
+    FEEDBACK_MODE_INVALID = -1,
+    FEEDBACK_MODE_OFF = 0,
+    FEEDBACK_MODE_ON = 1
+};
+
+struct SettingsSnapshot {
+    int32_t feedback = FEEDBACK_MODE_INVALID;
+    int32_t ringerMode = RINGER_MODE_INVALID;
+};
+
+/*
+ * Ringer and feedback settings as seen by vibration admission. Start runs the first load on the
+ * calling thread, so admission never decides on the defaults while the real values are on their way;
+ * later reloads, and retries of a failed load, run on a worker.
+ */
+class VibrationSettings {
+public:
+    // Updates the snapshot in place; on failure the snapshot is discarded.
+    using LoadFunc = std::function<int32_t(SettingsSnapshot &snapshot)>;
+    static constexpr int32_t RETRY_DELAY_MIN_MS = 500;
+    static constexpr int32_t RETRY_DELAY_MAX_MS = 30000;
+    explicit VibrationSettings(LoadFunc load);
+    ~VibrationSettings();
+    DISALLOW_COPY_AND_MOVE(VibrationSettings);
+    int32_t Start();
+    void Stop();
+    void RequestRefresh();
+    // The loaded settings, with feedback on and ringer normal for values that were never loaded.
+    SettingsSnapshot Get() const;
+
+private:
+    int32_t Load();
+    void RefreshLoop(int32_t firstRet);
+    LoadFunc load_;
+    // Written by Start and then only by the refresh worker; the admission path just loads it.
+    std::atomic<SettingsSnapshot> settings_ { SettingsSnapshot() };
+    std::mutex refreshMutex_;
+    std::condition_variable refreshCv_;
+    bool refreshRequested_ = false;
+    bool stopRefresh_ = false;
+    std::thread refreshWorker_;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATION_SETTINGS_H
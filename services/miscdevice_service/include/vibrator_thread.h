@@ -16,21 +16,32 @@
 #ifndef VIBRATOR_THREAD_H
 #define VIBRATOR_THREAD_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <thread>
 
 #include "thread_ex.h"
 
+#include "miscdevice_dump.h"
+#include "playback_plan.h"
+#include "vibrate_command_queue.h"
 #include "vibrator_hdi_connection.h"
 #include "vibrator_infos.h"
 
 namespace OHOS {
 namespace Sensors {
+/*
+ * Long-lived playback worker. Binder threads only post commands; the worker owns the
+ * vibrator device and handles preemption at its next wait point.
+ */
 class VibratorThread : public Thread {
 public:
-    void UpdateVibratorEffect(const VibrateInfo &vibrateInfo);
-    VibrateInfo GetCurrentVibrateInfo();
+    bool StartVibrate(const VibrateInfo &info, std::shared_ptr<const PlaybackPlan> plan);
+    bool StopVibrate();
+    bool IsVibrating() const;
+    std::shared_ptr<const VibrateInfo> GetCurrentVibrateInfo() const;
     void SetExitStatus(bool status);
     void WakeUp();
 
@@ -38,16 +49,27 @@ protected:
     virtual bool Run();
 
 private:
-    int32_t PlayOnce(const VibrateInfo &info);
-    int32_t PlayEffect(const VibrateInfo &info);
-    int32_t PlayCustomByHdHptic(const VibrateInfo &info);
-    int32_t PlayCustomByCompositeEffect(const VibrateInfo &info);
-    int32_t PlayCompositeEffect(const VibrateInfo &info, const HdfCompositeEffect &hdfCompositeEffect);
-    std::mutex currentVibrationMutex_;
-    VibrateInfo currentVibration_;
+    static constexpr size_t COMMAND_QUEUE_CAPACITY = 16;
+    bool PostCommand(VibrateCommand &&command);
+    bool WaitForCommand(VibrateCommand &command);
+    void StartPlaybackClock();
+    void WaitUntil(int32_t offsetTime);
+    bool IsInterrupted() const;
+    void StopDeviceVibration();
+    int32_t PlayPlan(const VibrateInfo &info, const PlaybackPlan &plan);
+    int32_t ExecuteStep(const PlaybackPlan &plan, const PlaybackStep &step);
+    int32_t GetCompositeLeadTime(int32_t compositeMode);
+    // Published with atomic_store and read with atomic_load; the pointee is never modified.
+    std::shared_ptr<const VibrateInfo> currentVibration_ = std::make_shared<const VibrateInfo>();
     std::mutex vibrateMutex_;
     std::condition_variable cv_;
     std::atomic<bool> exitFlag_ = false;
+    MpscQueue<VibrateCommand, COMMAND_QUEUE_CAPACITY> commandQueue_;
+    std::atomic<uint64_t> commandSequence_ = 0;
+    std::atomic<uint64_t> activeSequence_ = 0;
+    // steady_clock is CLOCK_MONOTONIC; every wait is an absolute deadline from playbackStart_.
+    std::chrono::steady_clock::time_point playbackStart_;
+    PlaybackDrift playbackDrift_;
 };
 #define VibratorDevice VibratorHdiConnection::GetInstance()
 }  // namespace Sensors
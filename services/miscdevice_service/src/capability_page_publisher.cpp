@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "capability_page_publisher.h"
+
+#include <cerrno>
+#include <new>
+
+#include <sys/mman.h>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "CapabilityPagePublisher"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+const char *CAPABILITY_PAGE_NAME = "MiscdeviceCapability";
+}  // namespace
+
+CapabilityPagePublisher::~CapabilityPagePublisher()
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    if (page_ != nullptr) {
+        munmap(page_, sizeof(CapabilityPageLayout));
+        page_ = nullptr;
+    }
+    if (ashmem_ != nullptr) {
+        ashmem_->CloseAshmem();
+        ashmem_ = nullptr;
+    }
+}
+
+bool CapabilityPagePublisher::Init()
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    if (page_ != nullptr) {
+        return true;
+    }
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(CAPABILITY_PAGE_NAME, sizeof(CapabilityPageLayout));
+    CHKPF(ashmem);
+    void *addr = mmap(nullptr, sizeof(CapabilityPageLayout), PROT_READ | PROT_WRITE, MAP_SHARED,
+        ashmem->GetAshmemFd(), 0);
+    if (addr == MAP_FAILED) {
+        MISC_HILOGE("Map capability page failed, errno:%{public}d", errno);
+        ashmem->CloseAshmem();
+        return false;
+    }
+    // Later mappings, including every client mapping, can only be read-only.
+    if (!ashmem->SetProtection(PROT_READ)) {
+        MISC_HILOGE("Set capability page protection failed");
+        munmap(addr, sizeof(CapabilityPageLayout));
+        ashmem->CloseAshmem();
+        return false;
+    }
+    page_ = new (addr) CapabilityPageLayout();
+    ashmem_ = ashmem;
+    return true;
+}
+
+void CapabilityPagePublisher::Publish(const CapabilitySnapshot &snapshot)
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    CHKPV(page_);
+    WriteCapabilityPage(*page_, snapshot);
+    MISC_HILOGI("Capability page published, generation:%{public}u, effects:%{public}zu, lights:%{public}zu",
+        GetCapabilityPageGeneration(*page_), snapshot.effects.size(), snapshot.lights.size());
+}
+
+sptr<Ashmem> CapabilityPagePublisher::GetAshmem()
+{
+    std::lock_guard<std::mutex> pageLock(pageMutex_);
+    return ashmem_;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "client_session_manager.h"
+
+#include <string>
+#include <vector>
+
+#include "permission_util.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "ClientSessionManager"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+const std::string VIBRATE_PERMISSION = "ohos.permission.VIBRATE";
+const std::string LIGHT_PERMISSION = "ohos.permission.SYSTEM_LIGHT_CONTROL";
+const std::array<std::string, CLIENT_PERMISSION_MAX> PERMISSION_NAMES = { VIBRATE_PERMISSION, LIGHT_PERMISSION };
+
+class PermissionObserver : public PermStateChangeCallbackCustomize {
+public:
+    explicit PermissionObserver(const PermStateChangeScope &scope) : PermStateChangeCallbackCustomize(scope) {}
+    ~PermissionObserver() override = default;
+    void PermStateChangeCallback(PermStateChangeInfo &result) override
+    {
+        MISC_HILOGD("Permission changed, tokenId:%{public}u, permission:%{public}s", result.tokenID,
+            result.permissionName.c_str());
+        SessionManager->InvalidateSession(result.tokenID);
+    }
+};
+}  // namespace
+
+ClientSession::ClientSession()
+{
+    for (auto &verdict : verdicts) {
+        verdict.store(VERDICT_UNKNOWN);
+    }
+}
+
+ClientSessionManager::ClientSessionManager() {}
+
+ClientSessionManager::~ClientSessionManager()
+{
+    std::lock_guard<std::mutex> observerLock(observerMutex_);
+    if (permissionObserver_ != nullptr) {
+        observerRegistered_.store(false, std::memory_order_release);
+        AccessTokenKit::UnRegisterPermStateChangeCallback(permissionObserver_);
+        permissionObserver_ = nullptr;
+    }
+}
+
+int32_t ClientSessionManager::RegisterPermissionObserver()
+{
+    std::lock_guard<std::mutex> observerLock(observerMutex_);
+    if (permissionObserver_ != nullptr) {
+        return ERR_OK;
+    }
+    PermStateChangeScope scope;
+    scope.permList = std::vector<std::string>(PERMISSION_NAMES.begin(), PERMISSION_NAMES.end());
+    auto observer = std::make_shared<PermissionObserver>(scope);
+    int32_t ret = AccessTokenKit::RegisterPermStateChangeCallback(observer);
+    if (ret != ERR_OK) {
+        MISC_HILOGE("RegisterPermStateChangeCallback failed, ret:%{public}d", ret);
+        return ret;
+    }
+    permissionObserver_ = observer;
+    observerRegistered_.store(true, std::memory_order_release);
+    return ERR_OK;
+}
+
+int32_t ClientSessionManager::CheckPermission(AccessTokenID tokenId, ClientPermission permission)
+{
+    if ((permission < 0) || (permission >= CLIENT_PERMISSION_MAX)) {
+        MISC_HILOGE("Invalid permission:%{public}d", permission);
+        return PERMISSION_DENIED;
+    }
+    if (!observerRegistered_.load(std::memory_order_acquire)) {
+        // Without the observer a revoked permission would go unnoticed, so nothing is cached.
+        return PermissionUtil::GetInstance().CheckVibratePermission(tokenId, PERMISSION_NAMES[permission]);
+    }
+    std::shared_ptr<ClientSession> session = GetSession(tokenId);
+    int32_t verdict = session->verdicts[permission].load(std::memory_order_acquire);
+    if (verdict != ClientSession::VERDICT_UNKNOWN) {
+        return verdict;
+    }
+    verdict = PermissionUtil::GetInstance().CheckVibratePermission(tokenId, PERMISSION_NAMES[permission]);
+    session->verdicts[permission].store(verdict, std::memory_order_release);
+    return verdict;
+}
+
+InternedString ClientSessionManager::GetPackageName(AccessTokenID tokenId)
+{
+    return GetSession(tokenId)->packageName;
+}
+
+void ClientSessionManager::OpenSession(const sptr<IRemoteObject> &client, AccessTokenID tokenId)
+{
+    CHKPV(client);
+    GetSession(tokenId)->bound.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> clientLock(clientMutex_);
+    clientTokenMap_[client] = tokenId;
+}
+
+void ClientSessionManager::CloseSession(const sptr<IRemoteObject> &client)
+{
+    CHKPV(client);
+    AccessTokenID tokenId = 0;
+    {
+        std::lock_guard<std::mutex> clientLock(clientMutex_);
+        auto it = clientTokenMap_.find(client);
+        if (it == clientTokenMap_.end()) {
+            MISC_HILOGD("No session bound to the client");
+            return;
+        }
+        tokenId = it->second;
+        clientTokenMap_.erase(it);
+    }
+    InvalidateSession(tokenId);
+}
+
+void ClientSessionManager::InvalidateSession(AccessTokenID tokenId)
+{
+    SessionShard &shard = GetShard(tokenId);
+    std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+    shard.sessions.erase(tokenId);
+}
+
+std::shared_ptr<ClientSession> ClientSessionManager::GetSession(AccessTokenID tokenId)
+{
+    SessionShard &shard = GetShard(tokenId);
+    {
+        std::shared_lock<std::shared_mutex> shardLock(shard.mutex);
+        auto it = shard.sessions.find(tokenId);
+        if (it != shard.sessions.end()) {
+            return it->second;
+        }
+    }
+    auto session = std::make_shared<ClientSession>();
+    session->tokenId = tokenId;
+    session->packageName = ResolvePackageName(tokenId);
+    if (session->packageName.Empty()) {
+        // Not cached, so a transient token service failure is retried on the next call.
+        return session;
+    }
+    std::unique_lock<std::shared_mutex> shardLock(shard.mutex);
+    auto it = shard.sessions.find(tokenId);
+    if (it != shard.sessions.end()) {
+        return it->second;
+    }
+    if (shard.sessions.size() >= SESSION_SHARD_CAPACITY) {
+        // Tokens that never transferred a client object have no death recipient to close them.
+        for (auto iter = shard.sessions.begin(); iter != shard.sessions.end();) {
+            if (iter->second->bound.load(std::memory_order_acquire)) {
+                ++iter;
+            } else {
+                iter = shard.sessions.erase(iter);
+            }
+        }
+        if (shard.sessions.size() >= SESSION_SHARD_CAPACITY) {
+            MISC_HILOGW("Session shard is full, tokenId:%{public}u", tokenId);
+            return session;
+        }
+    }
+    shard.sessions.emplace(tokenId, session);
+    return session;
+}
+
+ClientSessionManager::SessionShard &ClientSessionManager::GetShard(AccessTokenID tokenId)
+{
+    return shards_[tokenId % SESSION_SHARD_COUNT];
+}
+
+InternedString ClientSessionManager::ResolvePackageName(AccessTokenID tokenId)
+{
+    std::string packageName;
+    int32_t tokenType = AccessTokenKit::GetTokenTypeFlag(tokenId);
+    switch (tokenType) {
+        case ATokenTypeEnum::TOKEN_HAP: {
+            HapTokenInfo hapInfo;
+            if (AccessTokenKit::GetHapTokenInfo(tokenId, hapInfo) != 0) {
+                MISC_HILOGE("Get hap token info fail");
+                return {};
+            }
+            packageName = hapInfo.bundleName;
+            break;
+        }
+        case ATokenTypeEnum::TOKEN_NATIVE:
+        case ATokenTypeEnum::TOKEN_SHELL: {
+            NativeTokenInfo tokenInfo;
+            if (AccessTokenKit::GetNativeTokenInfo(tokenId, tokenInfo) != 0) {
+                MISC_HILOGE("Get native token info fail");
+                return {};
+            }
+            packageName = tokenInfo.processName;
+            break;
+        }
+        default: {
+            MISC_HILOGW("Token type not match");
+            break;
+        }
+    }
+    return InternedString::Intern(packageName);
+}
+}  // namespace Sensors
+}  // namespace OHOS
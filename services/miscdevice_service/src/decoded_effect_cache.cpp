@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "decoded_effect_cache.h"
+
+#include <sys/stat.h>
+
+#include <cerrno>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "DecodedEffectCache"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr uint64_t HASH_SEED = 0x9e3779b97f4a7c15ULL;
+constexpr uint32_t HASH_FOLD_SHIFT = 32;
+
+// Combined in 64 bits on every target; size_t is only 32 bits wide on arm32.
+void HashCombine(uint64_t &seed, uint64_t value)
+{
+    seed ^= value + HASH_SEED + (seed << 6) + (seed >> 2);
+}
+}  // namespace
+
+bool EffectFileKey::operator==(const EffectFileKey &other) const
+{
+    return (device == other.device) && (inode == other.inode) && (mtimeSec == other.mtimeSec) &&
+        (mtimeNsec == other.mtimeNsec) && (size == other.size) && (offset == other.offset) &&
+        (length == other.length);
+}
+
+size_t EffectFileKeyHash::operator()(const EffectFileKey &key) const
+{
+    uint64_t seed = 0;
+    HashCombine(seed, key.device);
+    HashCombine(seed, key.inode);
+    HashCombine(seed, static_cast<uint64_t>(key.mtimeSec));
+    HashCombine(seed, static_cast<uint64_t>(key.mtimeNsec));
+    HashCombine(seed, static_cast<uint64_t>(key.size));
+    HashCombine(seed, static_cast<uint64_t>(key.offset));
+    HashCombine(seed, static_cast<uint64_t>(key.length));
+    return static_cast<size_t>(seed ^ (seed >> HASH_FOLD_SHIFT));
+}
+
+DecodedEffectCache::DecodedEffectCache() {}
+
+DecodedEffectCache::~DecodedEffectCache() {}
+
+bool DecodedEffectCache::GetFileKey(const RawFileDescriptor &rawFd, EffectFileKey &key)
+{
+    struct stat statbuf;
+    if (fstat(rawFd.fd, &statbuf) != 0) {
+        MISC_HILOGW("fstat failed, errno:%{public}d", errno);
+        return false;
+    }
+    // Pipes and shared memory have no stable identity, so their content is never cached.
+    if (!S_ISREG(statbuf.st_mode)) {
+        return false;
+    }
+    key.device = static_cast<uint64_t>(statbuf.st_dev);
+    key.inode = static_cast<uint64_t>(statbuf.st_ino);
+    key.mtimeSec = static_cast<int64_t>(statbuf.st_mtim.tv_sec);
+    key.mtimeNsec = static_cast<int64_t>(statbuf.st_mtim.tv_nsec);
+    key.size = static_cast<int64_t>(statbuf.st_size);
+    key.offset = rawFd.offset;
+    key.length = rawFd.length;
+    return true;
+}
+
+std::shared_ptr<const FlatVibratePackage> DecodedEffectCache::Find(const EffectFileKey &key)
+{
+    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    ++hits_;
+    return it->second->package;
+}
+
+void DecodedEffectCache::Insert(const EffectFileKey &key, std::shared_ptr<const FlatVibratePackage> package)
+{
+    CHKPV(package);
+    size_t bytes = EstimateBytes(*package);
+    if (bytes > CACHE_BUDGET_BYTES) {
+        MISC_HILOGD("Effect of %{public}zu bytes exceeds the cache budget", bytes);
+        return;
+    }
+    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        bytes_ -= it->second->bytes;
+        lru_.erase(it->second);
+        index_.erase(it);
+    }
+    while (!lru_.empty() && (bytes_ + bytes > CACHE_BUDGET_BYTES)) {
+        const CacheEntry &victim = lru_.back();
+        bytes_ -= victim.bytes;
+        index_.erase(victim.key);
+        lru_.pop_back();
+    }
+    lru_.push_front({ .key = key, .package = package, .bytes = bytes });
+    index_[key] = lru_.begin();
+    bytes_ += bytes;
+}
+
+EffectCacheStats DecodedEffectCache::GetStats()
+{
+    std::lock_guard<std::mutex> cacheLock(cacheMutex_);
+    return {
+        .hits = hits_,
+        .misses = misses_,
+        .entries = lru_.size(),
+        .bytes = bytes_
+    };
+}
+
+size_t DecodedEffectCache::EstimateBytes(const FlatVibratePackage &package)
+{
+    return sizeof(CacheEntry) + sizeof(FlatVibratePackage) + package.GetHeapBytes();
+}
+}  // namespace Sensors
+}  // namespace OHOS
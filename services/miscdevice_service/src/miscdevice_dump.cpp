@@ -23,6 +23,8 @@
 #include <map>
 
 #include "securec.h"
+
+#include "decoded_effect_cache.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -31,13 +33,28 @@
 namespace OHOS {
 namespace Sensors {
 namespace {
-constexpr uint32_t MAX_DUMP_RECORD_SIZE = 30;
 constexpr uint32_t BASE_YEAR = 1900;
 constexpr uint32_t BASE_MON = 1;
 constexpr int32_t MAX_DUMP_PARAMETERS = 32;
-constexpr int32_t CONVERSION_RATE = 1000;
+constexpr int64_t NS_PER_SEC = 1000000000;
+constexpr int64_t NS_PER_MS = 1000000;
+
+int64_t ReadClockNs(clockid_t clockId)
+{
+    timespec time;
+    clock_gettime(clockId, &time);
+    return static_cast<int64_t>(time.tv_sec) * NS_PER_SEC + time.tv_nsec;
+}
 }  // namespace
 
+VibrateTimestamp GetVibrateTimestamp()
+{
+    return {
+        .monotonicNs = ReadClockNs(CLOCK_MONOTONIC),
+        .realtimeNs = ReadClockNs(CLOCK_REALTIME)
+    };
+}
+
 static std::map<int32_t, std::string> usageMap_ = {
     {USAGE_UNKNOWN, "unknown"},
     {USAGE_ALARM, "alarm"},
@@ -137,61 +154,104 @@ void MiscdeviceDump::DumpHelp(int32_t fd)
 
 void MiscdeviceDump::DumpMiscdeviceRecord(int32_t fd)
 {
-    std::lock_guard<std::mutex> queueLock(recordQueueMutex_);
-    if (dumpQueue_.empty()) {
-        MISC_HILOGW("dumpQueue_ is empty");
+    DumpEffectCache(fd);
+    DumpPlaybackDrift(fd);
+    std::vector<VibrateRecord> records = recordRing_.Snapshot();
+    if (records.empty()) {
+        MISC_HILOGW("No vibrate record");
         return;
     }
-    size_t length = dumpQueue_.size() > MAX_DUMP_RECORD_SIZE ? MAX_DUMP_RECORD_SIZE : dumpQueue_.size();
-    for (size_t i = 0; i < length; ++i) {
-        auto record = dumpQueue_.front();
-        dumpQueue_.push(record);
-        dumpQueue_.pop();
-        VibrateInfo info = record.info;
-        if (info.mode == "time") {
+    for (const auto &record : records) {
+        std::string startTime = FormatTimestamp(record.startTime);
+        if (record.mode == VibrateMode::TIME) {
             dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | duration:%d | usage:%s\n",
-                record.startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
-                info.duration, GetUsageName(info.usage).c_str());
-        } else if (info.mode == "preset") {
+                startTime.c_str(), record.uid, record.pid, record.packageName.c_str(),
+                record.duration, GetUsageName(record.usage).c_str());
+        } else if (record.mode == VibrateMode::PRESET) {
             dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | effect:%s | count:%d | usage:%s\n",
-                record.startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
-                info.effect.c_str(), info.count, GetUsageName(info.usage).c_str());
+                startTime.c_str(), record.uid, record.pid, record.packageName.c_str(),
+                record.effect, record.count, GetUsageName(record.usage).c_str());
         } else {
-            dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | usage:%s\n",
-                record.startTime.c_str(), info.uid, info.pid, info.packageName.c_str(),
-                GetUsageName(info.usage).c_str());
+            dprintf(fd, "startTime:%s | uid:%d | pid:%d | packageName:%s | mode:%s | duration:%d | "
+                "packageHash:%016" PRIx64 " | usage:%s\n", startTime.c_str(), record.uid, record.pid,
+                record.packageName.c_str(), GetVibrateModeName(record.mode).c_str(), record.duration,
+                record.packageHash, GetUsageName(record.usage).c_str());
         }
     }
 }
 
-void MiscdeviceDump::DumpCurrentTime(std::string &startTime)
+void MiscdeviceDump::DumpEffectCache(int32_t fd)
+{
+    EffectCacheStats stats = EffectCache->GetStats();
+    dprintf(fd, "Decoded effect cache: hits:%" PRIu64 " | misses:%" PRIu64 " | entries:%zu | bytes:%zu\n",
+        stats.hits, stats.misses, stats.entries, stats.bytes);
+}
+
+void MiscdeviceDump::DumpPlaybackDrift(int32_t fd)
 {
-    timespec curTime;
-    clock_gettime(CLOCK_REALTIME, &curTime);
-    struct tm *timeinfo = localtime(&(curTime.tv_sec));
-    CHKPV(timeinfo);
-    startTime.append(std::to_string(timeinfo->tm_year + BASE_YEAR)).append("-")
-        .append(std::to_string(timeinfo->tm_mon + BASE_MON)).append("-").append(std::to_string(timeinfo->tm_mday))
-        .append(" ").append(std::to_string(timeinfo->tm_hour)).append(":").append(std::to_string(timeinfo->tm_min))
-        .append(":").append(std::to_string(timeinfo->tm_sec)).append(".")
-        .append(std::to_string(curTime.tv_nsec / (CONVERSION_RATE * CONVERSION_RATE)));
+    std::vector<PlaybackDriftRecord> records = driftRing_.Snapshot();
+    if (records.empty()) {
+        return;
+    }
+    dprintf(fd, "Playback drift:\n");
+    for (const auto &record : records) {
+        const PlaybackDrift &drift = record.drift;
+        int64_t meanLatenessUs = drift.totalLatenessUs / static_cast<int64_t>(drift.stepCount);
+        std::string endTime = FormatTimestamp(record.endTime);
+        dprintf(fd, "endTime:%s | mode:%s | packageName:%s | steps:%u | maxDrift:%" PRId64 "us"
+            " | meanDrift:%" PRId64 "us\n", endTime.c_str(), GetVibrateModeName(record.mode).c_str(),
+            record.packageName.c_str(), drift.stepCount, drift.maxLatenessUs, meanLatenessUs);
+    }
 }
 
-void MiscdeviceDump::UpdateRecordQueue(const VibrateRecord &record)
+std::string MiscdeviceDump::FormatTimestamp(const VibrateTimestamp &timestamp)
 {
-    std::lock_guard<std::mutex> queueLock(recordQueueMutex_);
-    dumpQueue_.push(record);
-    if (dumpQueue_.size() > MAX_DUMP_RECORD_SIZE) {
-        dumpQueue_.pop();
+    time_t seconds = static_cast<time_t>(timestamp.realtimeNs / NS_PER_SEC);
+    struct tm timeinfo;
+    if (localtime_r(&seconds, &timeinfo) == nullptr) {
+        MISC_HILOGE("localtime_r failed");
+        return {};
     }
+    std::string time;
+    time.append(std::to_string(timeinfo.tm_year + BASE_YEAR)).append("-")
+        .append(std::to_string(timeinfo.tm_mon + BASE_MON)).append("-").append(std::to_string(timeinfo.tm_mday))
+        .append(" ").append(std::to_string(timeinfo.tm_hour)).append(":").append(std::to_string(timeinfo.tm_min))
+        .append(":").append(std::to_string(timeinfo.tm_sec)).append(".")
+        .append(std::to_string((timestamp.realtimeNs % NS_PER_SEC) / NS_PER_MS));
+    return time;
 }
 
 void MiscdeviceDump::SaveVibrateRecord(const VibrateInfo &vibrateInfo)
 {
     VibrateRecord record;
-    record.info = vibrateInfo;
-    DumpCurrentTime(record.startTime);
-    UpdateRecordQueue(record);
+    record.startTime = GetVibrateTimestamp();
+    record.packageName = vibrateInfo.packageName;
+    record.pid = vibrateInfo.pid;
+    record.uid = vibrateInfo.uid;
+    record.usage = vibrateInfo.usage;
+    record.duration = vibrateInfo.duration;
+    record.count = vibrateInfo.count;
+    record.mode = vibrateInfo.mode;
+    vibrateInfo.effect.copy(record.effect, VibrateRecord::EFFECT_NAME_SIZE - 1);
+    if ((vibrateInfo.package != nullptr) && (!vibrateInfo.package->patterns.empty())) {
+        record.packageHash = vibrateInfo.package->contentHash;
+        record.duration = vibrateInfo.package->packageDuration;
+    }
+    recordRing_.Push(record);
+}
+
+void MiscdeviceDump::SavePlaybackDrift(const VibrateInfo &vibrateInfo, const PlaybackDrift &drift)
+{
+    if (drift.stepCount == 0) {
+        return;
+    }
+    PlaybackDriftRecord record = {
+        .endTime = GetVibrateTimestamp(),
+        .mode = vibrateInfo.mode,
+        .packageName = vibrateInfo.packageName,
+        .drift = drift
+    };
+    driftRing_.Push(record);
 }
 
 std::string MiscdeviceDump::GetUsageName(int32_t usage)
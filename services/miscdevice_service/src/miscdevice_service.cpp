@@ -16,13 +16,18 @@
 #include "miscdevice_service.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <map>
 #include <string_ex.h>
 
 #include "death_recipient_template.h"
 #include "system_ability_definition.h"
 
+#include "client_session_manager.h"
+#include "custom_vibration_matcher.h"
+#include "decoded_effect_cache.h"
 #include "sensors_errors.h"
+#include "vibrate_package_checker.h"
 #include "vibration_priority_manager.h"
 
 #ifdef HDF_DRIVERS_INTERFACE_LIGHT
@@ -57,9 +62,12 @@ constexpr int32_t FREQUENCY_ADJUST_MIN = -100;
 constexpr int32_t FREQUENCY_ADJUST_MAX = 100;
 constexpr int32_t INVALID_PID = -1;
 constexpr int32_t VIBRATOR_ID = 0;
-constexpr int32_t BASE_YEAR = 1900;
-constexpr int32_t BASE_MON = 1;
-constexpr int32_t CONVERSION_RATE = 1000;
+constexpr size_t MAX_EFFECT_HANDLES_PER_CLIENT = 32;
+const std::vector<std::string> PRESET_EFFECT_NAMES = {
+    "haptic.clock.timer", "haptic.default.effect", "haptic.fail", "haptic.charging", "haptic.threshold",
+    "haptic.slide", "haptic.slide.light", "haptic.long_press.light", "haptic.long_press.medium",
+    "haptic.long_press.heavy", "haptic.effect.hard", "haptic.effect.soft", "haptic.effect.sharp"
+};
 VibratorCapacity g_capacity;
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 const std::string PHONE_TYPE = "phone";
@@ -78,7 +86,11 @@ MiscdeviceService::MiscdeviceService()
 
 MiscdeviceService::~MiscdeviceService()
 {
-    StopVibrateThread();
+    if (vibratorThread_ != nullptr) {
+        vibratorThread_->SetExitStatus(true);
+        vibratorThread_->WakeUp();
+        vibratorThread_->NotifyExitSync();
+    }
 }
 
 void MiscdeviceService::OnDump()
@@ -99,10 +111,25 @@ void MiscdeviceService::OnStart()
     if (!InitLightInterface()) {
         MISC_HILOGE("InitLightInterface failed");
     }
+    CustomVibrationMatcher::InitTransientMatchTable();
+    if (capabilityPage_.Init()) {
+        (void)InitLightList();
+        PublishCapabilityPage();
+        vibratorHdiConnection_.SetReconnectCallback([this]() { PublishCapabilityPage(); });
+    } else {
+        MISC_HILOGW("Capability page not created, clients fall back to IPC queries");
+    }
+    if (SessionManager->RegisterPermissionObserver() != ERR_OK) {
+        MISC_HILOGW("Permission observer not registered, permissions are checked on every request");
+    }
     if (!SystemAbility::Publish(MiscdeviceDelayedSpSingleton<MiscdeviceService>::GetInstance())) {
         MISC_HILOGE("Publish MiscdeviceService failed");
         return;
     }
+    // Loads the ringer and feedback settings now, so the first vibration is admitted against them.
+    if (PriorityManager == nullptr) {
+        MISC_HILOGE("PriorityManager is nullptr");
+    }
     auto ret = miscDeviceIdMap_.insert(std::make_pair(MiscdeviceDeviceId::LED, lightExist_));
     if (!ret.second) {
         MISC_HILOGI("Light exist in miscDeviceIdMap_");
@@ -168,6 +195,7 @@ bool MiscdeviceService::InitLightInterface()
 bool MiscdeviceService::IsValid(int32_t lightId)
 {
     CALL_LOG_ENTER;
+    std::lock_guard<std::mutex> lightInfosLock(lightInfosMutex_);
     for (const auto &item : lightInfos_) {
         if (lightId == item.GetLightId()) {
             return true;
@@ -215,7 +243,7 @@ bool MiscdeviceService::ShouldIgnoreVibrate(const VibrateInfo &info)
 
 int32_t MiscdeviceService::Vibrate(int32_t vibratorId, int32_t timeOut, int32_t usage)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Start vibrator time, time:%{public}d, usage:%{public}d, package:%{public}s",
         timeOut, usage, packageName.c_str());
     if ((timeOut <= MIN_VIBRATOR_TIME) || (timeOut > MAX_VIBRATOR_TIME)
@@ -224,43 +252,47 @@ int32_t MiscdeviceService::Vibrate(int32_t vibratorId, int32_t timeOut, int32_t
         return PARAMETER_ERROR;
     }
     VibrateInfo info = {
-        .mode = VIBRATE_TIME,
+        .mode = VibrateMode::TIME,
         .packageName = packageName,
         .pid = GetCallingPid(),
         .uid = GetCallingUid(),
         .usage = usage,
         .duration = timeOut
     };
+    auto plan = std::make_shared<PlaybackPlan>();
+    if (BuildPlaybackPlan(info, *plan) != SUCCESS) {
+        MISC_HILOGE("Build playback plan fail");
+        return ERROR;
+    }
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
     if (ShouldIgnoreVibrate(info)) {
         MISC_HILOGE("Vibration is ignored and high priority is vibrating");
         return ERROR;
     }
-    std::string curVibrateTime;
-    StartVibrateThread(info);
-    VibrateCurrentTime(curVibrateTime);
-    MISC_HILOGI("Vibrate currentTime:%{public}s, pid:%{public}d, vibratorId:%{public}d,"
-        "duration:%{public}d, package:%{public}s", curVibrateTime.c_str(), info.pid, vibratorId,
+    if (StartVibrateThread(info, plan) != ERR_OK) {
+        MISC_HILOGE("Start vibrate thread fail");
+        return ERROR;
+    }
+    VibrateTimestamp timestamp = GetVibrateTimestamp();
+    MISC_HILOGI("Vibrate realtime:%{public}" PRId64 "ns, pid:%{public}d, vibratorId:%{public}d,"
+        "duration:%{public}d, package:%{public}s", timestamp.realtimeNs, info.pid, vibratorId,
         info.duration, packageName.c_str());
     return NO_ERROR;
 }
 
 int32_t MiscdeviceService::StopVibrator(int32_t vibratorId)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Stop vibrator, package:%{public}s", packageName.c_str());
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning() &&
+    if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsVibrating() &&
         !vibratorHdiConnection_.IsVibratorRunning())) {
         MISC_HILOGD("No vibration, no need to stop");
         return ERROR;
     }
-    if (vibratorHdiConnection_.IsVibratorRunning()) {
-        vibratorHdiConnection_.Stop(HDF_VIBRATOR_MODE_PRESET);
-    }
 #else
-    if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning())) {
+    if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsVibrating())) {
         MISC_HILOGD("No vibration, no need to stop");
         return ERROR;
     }
@@ -272,7 +304,7 @@ int32_t MiscdeviceService::StopVibrator(int32_t vibratorId)
 int32_t MiscdeviceService::PlayVibratorEffect(int32_t vibratorId, const std::string &effect,
     int32_t count, int32_t usage)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Start vibrator effect, effect:%{public}s, count:%{public}d, usage:%{public}d, package:%{public}s",
         effect.c_str(), count, usage, packageName.c_str());
     if ((count < MIN_VIBRATOR_COUNT) || (count > MAX_VIBRATOR_COUNT) || (usage >= USAGE_MAX) || (usage < 0)) {
@@ -289,7 +321,7 @@ int32_t MiscdeviceService::PlayVibratorEffect(int32_t vibratorId, const std::str
         return PARAMETER_ERROR;
     }
     VibrateInfo info = {
-        .mode = VIBRATE_PRESET,
+        .mode = VibrateMode::PRESET,
         .packageName = packageName,
         .pid = GetCallingPid(),
         .uid = GetCallingUid(),
@@ -298,62 +330,66 @@ int32_t MiscdeviceService::PlayVibratorEffect(int32_t vibratorId, const std::str
         .effect = effect,
         .count = count
     };
+    auto plan = std::make_shared<PlaybackPlan>();
+    if (BuildPlaybackPlan(info, *plan) != SUCCESS) {
+        MISC_HILOGE("Build playback plan fail");
+        return ERROR;
+    }
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
     if (ShouldIgnoreVibrate(info)) {
         MISC_HILOGE("Vibration is ignored and high priority is vibrating");
         return ERROR;
     }
-    std::string curEffectTime;
-    VibrateCurrentTime(curEffectTime);
-    StartVibrateThread(info);
-    MISC_HILOGI("PlayVibratorEffect currentTime:%{public}s, pid:%{public}d, duration:%{public}d,"
-        "package:%{public}s", curEffectTime.c_str(), info.pid, info.duration, packageName.c_str());
+    if (StartVibrateThread(info, plan) != ERR_OK) {
+        MISC_HILOGE("Start vibrate thread fail");
+        return ERROR;
+    }
+    VibrateTimestamp timestamp = GetVibrateTimestamp();
+    MISC_HILOGI("PlayVibratorEffect realtime:%{public}" PRId64 "ns, pid:%{public}d, duration:%{public}d,"
+        "package:%{public}s", timestamp.realtimeNs, info.pid, info.duration, packageName.c_str());
     return NO_ERROR;
 }
 
-void MiscdeviceService::StartVibrateThread(VibrateInfo info)
+int32_t MiscdeviceService::StartVibrateThread(const VibrateInfo &info, std::shared_ptr<const PlaybackPlan> plan)
 {
     if (vibratorThread_ == nullptr) {
         vibratorThread_ = std::make_shared<VibratorThread>();
     }
-    StopVibrateThread();
-#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    if (vibratorHdiConnection_.IsVibratorRunning()) {
-        vibratorHdiConnection_.Stop(HDF_VIBRATOR_MODE_PRESET);
+    if (!vibratorThread_->IsRunning()) {
+        vibratorThread_->Start("VibratorThread");
+    }
+    if (!vibratorThread_->StartVibrate(info, plan)) {
+        MISC_HILOGE("Post vibrate command fail, package:%{public}s", info.packageName.c_str());
+        return ERROR;
     }
-#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
-    vibratorThread_->UpdateVibratorEffect(info);
-    vibratorThread_->Start("VibratorThread");
     DumpHelper->SaveVibrateRecord(info);
+    return ERR_OK;
 }
 
 void MiscdeviceService::StopVibrateThread()
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Stop vibrator,package:%{public}s", packageName.c_str());
     if ((vibratorThread_ != nullptr) && (vibratorThread_->IsRunning())) {
-        std::string curStopTime;
-        VibrateCurrentTime(curStopTime);
-        MISC_HILOGI("StopVibrateThread currentTime:%{public}s, pid:%{public}d, package:%{public}s",
-            curStopTime.c_str(), GetCallingPid(), packageName.c_str());
-        vibratorThread_->SetExitStatus(true);
-        vibratorThread_->WakeUp();
-        vibratorThread_->NotifyExitSync();
-        vibratorThread_->SetExitStatus(false);
+        VibrateTimestamp timestamp = GetVibrateTimestamp();
+        MISC_HILOGI("StopVibrateThread realtime:%{public}" PRId64 "ns, pid:%{public}d, package:%{public}s",
+            timestamp.realtimeNs, GetCallingPid(), packageName.c_str());
+        vibratorThread_->StopVibrate();
     }
 }
 
 int32_t MiscdeviceService::StopVibrator(int32_t vibratorId, const std::string &mode)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Stop vibrator, mode:%{public}s, package:%{public}s", mode.c_str(), packageName.c_str());
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
-    if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsRunning())) {
+    if ((vibratorThread_ == nullptr) || (!vibratorThread_->IsVibrating())) {
         MISC_HILOGD("No vibration, no need to stop");
         return ERROR;
     }
-    const VibrateInfo info = vibratorThread_->GetCurrentVibrateInfo();
-    if (info.mode != mode) {
+    std::shared_ptr<const VibrateInfo> info = vibratorThread_->GetCurrentVibrateInfo();
+    VibrateMode stopMode = ParseVibrateMode(mode);
+    if ((stopMode == VibrateMode::BUTT) || (info->mode != stopMode)) {
         MISC_HILOGD("Stop vibration information mismatch");
         return ERROR;
     }
@@ -372,24 +408,11 @@ int32_t MiscdeviceService::IsSupportEffect(const std::string &effect, bool &stat
     return NO_ERROR;
 }
 
-void MiscdeviceService::VibrateCurrentTime(std::string &startTime)
-{
-    timespec curTime;
-    clock_gettime(CLOCK_REALTIME, &curTime);
-    struct tm *timeinfo = localtime(&(curTime.tv_sec));
-    CHKPV(timeinfo);
-    startTime.append(std::to_string(timeinfo->tm_year + BASE_YEAR)).append("-")
-        .append(std::to_string(timeinfo->tm_mon + BASE_MON)).append("-").append(std::to_string(timeinfo->tm_mday))
-        .append(" ").append(std::to_string(timeinfo->tm_hour)).append(":").append(std::to_string(timeinfo->tm_min))
-        .append(":").append(std::to_string(timeinfo->tm_sec)).append(".")
-        .append(std::to_string(curTime.tv_nsec / (CONVERSION_RATE * CONVERSION_RATE)));
-}
-
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 int32_t MiscdeviceService::PlayVibratorCustom(int32_t vibratorId, const RawFileDescriptor &rawFd, int32_t usage,
     const VibrateParameter &parameter)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Start vibrator custom, usage:%{public}d, package:%{public}s", usage, packageName.c_str());
     if (!(g_capacity.isSupportHdHaptic || g_capacity.isSupportPresetMapping || g_capacity.isSupportTimeDelay)) {
         MISC_HILOGE("The device does not support this operation");
@@ -399,94 +422,93 @@ int32_t MiscdeviceService::PlayVibratorCustom(int32_t vibratorId, const RawFileD
         MISC_HILOGE("Invalid parameter, usage:%{public}d", usage);
         return PARAMETER_ERROR;
     }
-    std::unique_ptr<IVibratorDecoderFactory> decoderFactory = std::make_unique<DefaultVibratorDecoderFactory>();
-    std::unique_ptr<IVibratorDecoder> decoder(decoderFactory->CreateDecoder());
-    VibratePackage package;
-    int32_t ret = decoder->DecodeEffect(rawFd, package);
-    if (ret != SUCCESS || package.patterns.empty()) {
+    std::shared_ptr<const FlatVibratePackage> decodedPackage = DecodeCustomEffect(rawFd);
+    if (decodedPackage == nullptr) {
         MISC_HILOGE("Decode effect error");
         return ERROR;
     }
-    MergeVibratorParmeters(parameter, package);
-    package.Dump();
     VibrateInfo info = {
-        .mode = VIBRATE_CUSTOM_COMPOSITE_EFFECT,
+        .mode = VibrateMode::CUSTOM_COMPOSITE_EFFECT,
         .packageName = packageName,
         .pid = GetCallingPid(),
         .uid = GetCallingUid(),
         .usage = usage,
-        .package = package,
+        .package = MergeVibratorParmeters(parameter, decodedPackage),
     };
+    info.package->Dump();
+    auto plan = std::make_shared<PlaybackPlan>();
+    if (BuildPlaybackPlan(info, *plan) != SUCCESS) {
+        MISC_HILOGE("Build playback plan fail");
+        return ERROR;
+    }
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
     if (ShouldIgnoreVibrate(info)) {
         MISC_HILOGE("Vibration is ignored and high priority is vibrating");
         return ERROR;
     }
-    std::string curCustomTime;
-    VibrateCurrentTime(curCustomTime);
-    StartVibrateThread(info);
-    MISC_HILOGI("PlayVibratorCustom currentTime:%{public}s, pid:%{public}d, duration:%{public}d,"
-        "package:%{public}s", curCustomTime.c_str(), info.pid, package.packageDuration, packageName.c_str());
+    if (StartVibrateThread(info, plan) != ERR_OK) {
+        MISC_HILOGE("Start vibrate thread fail");
+        return ERROR;
+    }
+    VibrateTimestamp timestamp = GetVibrateTimestamp();
+    MISC_HILOGI("PlayVibratorCustom realtime:%{public}" PRId64 "ns, pid:%{public}d, duration:%{public}d,"
+        "package:%{public}s", timestamp.realtimeNs, info.pid, info.package->packageDuration, packageName.c_str());
     return NO_ERROR;
 }
-#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 
-std::string MiscdeviceService::GetPackageName(AccessTokenID tokenId)
-{
-    std::string packageName;
-    int32_t tokenType = AccessTokenKit::GetTokenTypeFlag(tokenId);
-    switch (tokenType) {
-        case ATokenTypeEnum::TOKEN_HAP: {
-            HapTokenInfo hapInfo;
-            if (AccessTokenKit::GetHapTokenInfo(tokenId, hapInfo) != 0) {
-                MISC_HILOGE("Get hap token info fail");
-                return {};
-            }
-            packageName = hapInfo.bundleName;
-            break;
-        }
-        case ATokenTypeEnum::TOKEN_NATIVE:
-        case ATokenTypeEnum::TOKEN_SHELL: {
-            NativeTokenInfo tokenInfo;
-            if (AccessTokenKit::GetNativeTokenInfo(tokenId, tokenInfo) != 0) {
-                MISC_HILOGE("Get native token info fail");
-                return {};
-            }
-            packageName = tokenInfo.processName;
-            break;
-        }
-        default: {
-            MISC_HILOGW("Token type not match");
-            break;
+std::shared_ptr<const FlatVibratePackage> MiscdeviceService::DecodeCustomEffect(const RawFileDescriptor &rawFd)
+{
+    EffectFileKey fileKey;
+    bool cacheable = DecodedEffectCache::GetFileKey(rawFd, fileKey);
+    if (cacheable) {
+        std::shared_ptr<const FlatVibratePackage> cachedPackage = EffectCache->Find(fileKey);
+        if (cachedPackage != nullptr) {
+            return cachedPackage;
         }
     }
-    return packageName;
+    std::unique_ptr<IVibratorDecoderFactory> decoderFactory = std::make_unique<DefaultVibratorDecoderFactory>();
+    std::unique_ptr<IVibratorDecoder> decoder(decoderFactory->CreateDecoder());
+    VibratePackage decodedPackage;
+    int32_t ret = decoder->DecodeEffect(rawFd, decodedPackage);
+    if (ret != SUCCESS || decodedPackage.patterns.empty()) {
+        MISC_HILOGE("Decode effect fail, ret:%{public}d", ret);
+        return nullptr;
+    }
+    auto package = std::make_shared<const FlatVibratePackage>(FlatVibratePackage::Flatten(decodedPackage));
+    if (cacheable) {
+        EffectCache->Insert(fileKey, package);
+    }
+    return package;
 }
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 
 std::vector<LightInfoIPC> MiscdeviceService::GetLightList()
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGI("GetLightList, package:%{public}s", packageName.c_str());
     if (!InitLightList()) {
         MISC_HILOGE("InitLightList init failed");
-        return lightInfos_;
     }
+    std::lock_guard<std::mutex> lightInfosLock(lightInfosMutex_);
     return lightInfos_;
 }
 
 bool MiscdeviceService::InitLightList()
 {
-    int32_t ret = lightHdiConnection_.GetLightList(lightInfos_);
+    std::vector<LightInfoIPC> lightInfos;
+    int32_t ret = lightHdiConnection_.GetLightList(lightInfos);
     if (ret != ERR_OK) {
         MISC_HILOGE("InitLightList failed, ret:%{public}d", ret);
         return false;
     }
+    std::lock_guard<std::mutex> lightInfosLock(lightInfosMutex_);
+    lightInfos_ = std::move(lightInfos);
     return true;
 }
 
 int32_t MiscdeviceService::TurnOn(int32_t lightId, const LightColor &color, const LightAnimationIPC &animation)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGI("TurnOn, package:%{public}s", packageName.c_str());
     if (!IsValid(lightId)) {
         MISC_HILOGE("lightId is invalid, lightId:%{public}d", lightId);
@@ -506,7 +528,7 @@ int32_t MiscdeviceService::TurnOn(int32_t lightId, const LightColor &color, cons
 
 int32_t MiscdeviceService::TurnOff(int32_t lightId)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGI("TurnOff, package:%{public}s", packageName.c_str());
     if (!IsValid(lightId)) {
         MISC_HILOGE("lightId is invalid, lightId:%{public}d", lightId);
@@ -545,59 +567,61 @@ int32_t MiscdeviceService::Dump(int32_t fd, const std::vector<std::u16string> &a
 int32_t MiscdeviceService::PlayPattern(const VibratePattern &pattern, int32_t usage,
     const VibrateParameter &parameter)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Start vibrator pattern, usage:%{public}d, package:%{public}s", usage, packageName.c_str());
     if ((usage >= USAGE_MAX) || (usage < 0) || (!CheckVibratorParmeters(parameter))) {
         MISC_HILOGE("Invalid parameter, usage:%{public}d", usage);
         return PARAMETER_ERROR;
     }
-    VibratePattern vibratePattern = {
-        .startTime = 0,
-        .events = pattern.events
-    };
-    std::vector<VibratePattern> patterns = {vibratePattern};
-    VibratePackage package = {
-        .patterns = patterns
-    };
-    MergeVibratorParmeters(parameter, package);
-    package.Dump();
+    // The HDI plays at most MAX_EVENT_SIZE events per pattern.
+    auto package = std::make_shared<FlatVibratePackage>(FlatVibratePackage::Flatten(pattern, MAX_EVENT_SIZE));
+    MergeVibratorParmeters(parameter, *package);
+    package->Dump();
     VibrateInfo info = {
-        .mode = VIBRATE_BUTT,
+        .mode = GetCustomVibrateMode(),
         .packageName = packageName,
         .pid = GetCallingPid(),
         .uid = GetCallingUid(),
         .usage = usage,
+        .package = package,
     };
-    if (g_capacity.isSupportHdHaptic) {
-        std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
-        if (ShouldIgnoreVibrate(info)) {
-            MISC_HILOGE("Vibration is ignored and high priority is vibrating");
-            return ERROR;
-        }
-        StartVibrateThread(info);
-        return vibratorHdiConnection_.PlayPattern(package.patterns.front());
-    } else if (g_capacity.isSupportPresetMapping) {
-        info.mode = VIBRATE_CUSTOM_COMPOSITE_EFFECT;
-    } else if (g_capacity.isSupportTimeDelay) {
-        info.mode = VIBRATE_CUSTOM_COMPOSITE_TIME;
-    }
-    info.package = package;
+    auto plan = std::make_shared<PlaybackPlan>();
+    if (BuildPlaybackPlan(info, *plan) != SUCCESS) {
+        MISC_HILOGE("Build playback plan fail");
+        return ERROR;
+    }
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
     if (ShouldIgnoreVibrate(info)) {
         MISC_HILOGE("Vibration is ignored and high priority is vibrating");
         return ERROR;
     }
-    std::string curPatternTime;
-    VibrateCurrentTime(curPatternTime);
-    StartVibrateThread(info);
-    MISC_HILOGI("PlayVibratorCustom currentTime:%{public}s, pid:%{public}d, duration:%{public}d,"
-        "package:%{public}s", curPatternTime.c_str(), info.pid, pattern.patternDuration, packageName.c_str());
+    if (StartVibrateThread(info, plan) != ERR_OK) {
+        MISC_HILOGE("Start vibrate thread fail");
+        return ERROR;
+    }
+    VibrateTimestamp timestamp = GetVibrateTimestamp();
+    MISC_HILOGI("PlayVibratorCustom realtime:%{public}" PRId64 "ns, pid:%{public}d, duration:%{public}d,"
+        "package:%{public}s", timestamp.realtimeNs, info.pid, pattern.patternDuration, packageName.c_str());
     return ERR_OK;
 }
 
+VibrateMode MiscdeviceService::GetCustomVibrateMode()
+{
+    if (g_capacity.isSupportHdHaptic) {
+        return VibrateMode::CUSTOM_HD;
+    }
+    if (g_capacity.isSupportPresetMapping) {
+        return VibrateMode::CUSTOM_COMPOSITE_EFFECT;
+    }
+    if (g_capacity.isSupportTimeDelay) {
+        return VibrateMode::CUSTOM_COMPOSITE_TIME;
+    }
+    return VibrateMode::BUTT;
+}
+
 int32_t MiscdeviceService::GetDelayTime(int32_t &delayTime)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("GetDelayTime, package:%{public}s", packageName.c_str());
     return vibratorHdiConnection_.GetDelayTime(g_capacity.GetVibrateMode(), delayTime);
 }
@@ -613,33 +637,44 @@ bool MiscdeviceService::CheckVibratorParmeters(const VibrateParameter &parameter
     return true;
 }
 
-void MiscdeviceService::MergeVibratorParmeters(const VibrateParameter &parameter, VibratePackage &package)
+void MiscdeviceService::MergeVibratorParmeters(const VibrateParameter &parameter, FlatVibratePackage &package)
 {
     if ((parameter.intensity == INTENSITY_ADJUST_MAX) && (parameter.frequency == 0)) {
         MISC_HILOGD("The adjust parameter is not need to merge");
         return;
     }
     parameter.Dump();
-    for (VibratePattern &pattern : package.patterns) {
-        for (VibrateEvent &event : pattern.events) {
-            float intensityScale = static_cast<float>(parameter.intensity) / INTENSITY_ADJUST_MAX;
-            if ((event.tag == EVENT_TAG_TRANSIENT) || (event.points.empty())) {
-                event.intensity = static_cast<int32_t>(event.intensity * intensityScale);
-                event.intensity = std::max(std::min(event.intensity, INTENSITY_MAX), INTENSITY_MIN);
-                event.frequency = event.frequency + parameter.frequency;
-                event.frequency = std::max(std::min(event.frequency, FREQUENCY_MAX), FREQUENCY_MIN);
-            } else {
-                for (VibrateCurvePoint &point : event.points) {
-                    point.intensity = static_cast<int32_t>(point.intensity * intensityScale);
-                    point.intensity = std::max(std::min(point.intensity, INTENSITY_ADJUST_MAX), INTENSITY_ADJUST_MIN);
-                    point.frequency = point.frequency + parameter.frequency;
-                    point.frequency = std::max(std::min(point.frequency, FREQUENCY_ADJUST_MAX), FREQUENCY_ADJUST_MIN);
-                }
-            }
+    float intensityScale = static_cast<float>(parameter.intensity) / INTENSITY_ADJUST_MAX;
+    for (FlatVibrateEvent &event : package.events) {
+        if ((event.tag == EVENT_TAG_TRANSIENT) || (event.pointCount == 0)) {
+            event.intensity = static_cast<int32_t>(event.intensity * intensityScale);
+            event.intensity = std::max(std::min(event.intensity, INTENSITY_MAX), INTENSITY_MIN);
+            event.frequency = event.frequency + parameter.frequency;
+            event.frequency = std::max(std::min(event.frequency, FREQUENCY_MAX), FREQUENCY_MIN);
+            continue;
+        }
+        auto first = package.points.begin() + event.firstPoint;
+        for (auto point = first; point != first + event.pointCount; ++point) {
+            point->intensity = static_cast<int32_t>(point->intensity * intensityScale);
+            point->intensity = std::max(std::min(point->intensity, INTENSITY_ADJUST_MAX), INTENSITY_ADJUST_MIN);
+            point->frequency = point->frequency + parameter.frequency;
+            point->frequency = std::max(std::min(point->frequency, FREQUENCY_ADJUST_MAX), FREQUENCY_ADJUST_MIN);
         }
     }
 }
 
+std::shared_ptr<const FlatVibratePackage> MiscdeviceService::MergeVibratorParmeters(
+    const VibrateParameter &parameter, const std::shared_ptr<const FlatVibratePackage> &package)
+{
+    CHKPP(package);
+    if ((parameter.intensity == INTENSITY_ADJUST_MAX) && (parameter.frequency == 0)) {
+        return package;
+    }
+    auto mergedPackage = std::make_shared<FlatVibratePackage>(*package);
+    MergeVibratorParmeters(parameter, *mergedPackage);
+    return mergedPackage;
+}
+
 int32_t MiscdeviceService::TransferClientRemoteObject(const sptr<IRemoteObject> &vibratorServiceClient)
 {
     auto clientPid = GetCallingPid();
@@ -648,6 +683,7 @@ int32_t MiscdeviceService::TransferClientRemoteObject(const sptr<IRemoteObject>
         return ERROR;
     }
     RegisterClientDeathRecipient(vibratorServiceClient, clientPid);
+    SessionManager->OpenSession(vibratorServiceClient, GetCallingTokenID());
     return ERR_OK;
 }
 
@@ -656,7 +692,7 @@ void MiscdeviceService::ProcessDeathObserver(const wptr<IRemoteObject> &object)
     CALL_LOG_ENTER;
     sptr<IRemoteObject> client = object.promote();
     int32_t clientPid = FindClientPid(client);
-    VibrateInfo info;
+    std::shared_ptr<const VibrateInfo> info = nullptr;
     {
         std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
         if (vibratorThread_ == nullptr) {
@@ -664,11 +700,15 @@ void MiscdeviceService::ProcessDeathObserver(const wptr<IRemoteObject> &object)
         }
         info = vibratorThread_->GetCurrentVibrateInfo();
     }
-    int32_t vibratePid = info.pid;
+    int32_t vibratePid = info->pid;
     MISC_HILOGI("ClientPid:%{public}d, VibratePid:%{public}d", clientPid, vibratePid);
     if ((clientPid != INVALID_PID) && (clientPid == vibratePid)) {
         StopVibrator(VIBRATOR_ID);
     }
+    if (clientPid != INVALID_PID) {
+        ReleaseClientEffects(clientPid);
+    }
+    SessionManager->CloseSession(client);
     UnregisterClientDeathRecipient(client);
 }
 
@@ -749,7 +789,7 @@ void MiscdeviceService::DestroyClientPid(const sptr<IRemoteObject> &vibratorServ
 int32_t MiscdeviceService::PlayPrimitiveEffect(int32_t vibratorId, const std::string &effect,
     int32_t intensity, int32_t usage)
 {
-    std::string packageName = GetPackageName(GetCallingTokenID());
+    InternedString packageName = SessionManager->GetPackageName(GetCallingTokenID());
     MISC_HILOGD("Start vibrator effect, effect:%{public}s, intensity:%{public}d, usage:%{public}d, package:%{public}s",
         effect.c_str(), intensity, usage, packageName.c_str());
     if ((intensity <= INTENSITY_MIN) || (intensity > INTENSITY_MAX) || (usage >= USAGE_MAX) || (usage < 0)) {
@@ -766,20 +806,26 @@ int32_t MiscdeviceService::PlayPrimitiveEffect(int32_t vibratorId, const std::st
         return PARAMETER_ERROR;
     }
     VibrateInfo info = {
-        .mode = VIBRATE_BUTT,
+        .mode = VibrateMode::PRIMITIVE,
         .packageName = packageName,
         .pid = GetCallingPid(),
         .uid = GetCallingUid(),
         .usage = usage,
+        .duration = effectInfo->duration,
         .effect = effect,
+        .intensity = intensity,
     };
+    auto plan = std::make_shared<PlaybackPlan>();
+    if (BuildPlaybackPlan(info, *plan) != SUCCESS) {
+        MISC_HILOGE("Build playback plan fail");
+        return ERROR;
+    }
     std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
     if (ShouldIgnoreVibrate(info)) {
         MISC_HILOGE("Vibration is ignored and high priority is vibrating");
         return ERROR;
     }
-    StartVibrateThread(info);
-    return vibratorHdiConnection_.StartByIntensity(effect, intensity);
+    return StartVibrateThread(info, plan);
 }
 
 int32_t MiscdeviceService::GetVibratorCapacity(VibratorCapacity &capacity)
@@ -787,5 +833,125 @@ int32_t MiscdeviceService::GetVibratorCapacity(VibratorCapacity &capacity)
     capacity = g_capacity;
     return ERR_OK;
 }
+
+int32_t MiscdeviceService::RegisterEffect(const VibratePackage &package, int32_t &handle)
+{
+    int32_t pid = GetCallingPid();
+    if (!VibratePackageChecker::CheckPackage(package)) {
+        MISC_HILOGE("Package is invalid, pid:%{public}d", pid);
+        return PARAMETER_ERROR;
+    }
+    auto registeredPackage = std::make_shared<const FlatVibratePackage>(FlatVibratePackage::Flatten(package));
+    std::lock_guard<std::mutex> lock(effectHandleMutex_);
+    size_t count = static_cast<size_t>(std::count_if(effectHandles_.begin(), effectHandles_.end(),
+        [pid](const auto &item) { return item.second.pid == pid; }));
+    if (count >= MAX_EFFECT_HANDLES_PER_CLIENT) {
+        MISC_HILOGE("Too many effects registered, pid:%{public}d", pid);
+        return ERROR;
+    }
+    do {
+        lastEffectHandle_ = (lastEffectHandle_ == INT32_MAX) ? 1 : (lastEffectHandle_ + 1);
+    } while (effectHandles_.find(lastEffectHandle_) != effectHandles_.end());
+    handle = lastEffectHandle_;
+    effectHandles_[handle] = { .package = registeredPackage, .pid = pid };
+    MISC_HILOGI("Register effect, handle:%{public}d, pid:%{public}d", handle, pid);
+    return NO_ERROR;
+}
+
+int32_t MiscdeviceService::PlayEffectHandle(int32_t handle, int32_t usage, const VibrateParameter &parameter)
+{
+    if ((usage >= USAGE_MAX) || (usage < 0) || (!CheckVibratorParmeters(parameter))) {
+        MISC_HILOGE("Invalid parameter, usage:%{public}d", usage);
+        return PARAMETER_ERROR;
+    }
+    int32_t pid = GetCallingPid();
+    std::shared_ptr<const FlatVibratePackage> registeredPackage = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(effectHandleMutex_);
+        auto it = effectHandles_.find(handle);
+        if ((it == effectHandles_.end()) || (it->second.pid != pid)) {
+            MISC_HILOGE("Effect handle not found, handle:%{public}d, pid:%{public}d", handle, pid);
+            return PARAMETER_ERROR;
+        }
+        registeredPackage = it->second.package;
+    }
+    VibrateInfo info = {
+        .mode = GetCustomVibrateMode(),
+        .packageName = SessionManager->GetPackageName(GetCallingTokenID()),
+        .pid = pid,
+        .uid = GetCallingUid(),
+        .usage = usage,
+        .package = MergeVibratorParmeters(parameter, registeredPackage),
+    };
+    auto plan = std::make_shared<PlaybackPlan>();
+    if (BuildPlaybackPlan(info, *plan) != SUCCESS) {
+        MISC_HILOGE("Build playback plan fail");
+        return ERROR;
+    }
+    std::lock_guard<std::mutex> lock(vibratorThreadMutex_);
+    if (ShouldIgnoreVibrate(info)) {
+        MISC_HILOGE("Vibration is ignored and high priority is vibrating");
+        return ERROR;
+    }
+    return StartVibrateThread(info, plan);
+}
+
+int32_t MiscdeviceService::ReleaseEffect(int32_t handle)
+{
+    int32_t pid = GetCallingPid();
+    std::lock_guard<std::mutex> lock(effectHandleMutex_);
+    auto it = effectHandles_.find(handle);
+    if ((it == effectHandles_.end()) || (it->second.pid != pid)) {
+        MISC_HILOGE("Effect handle not found, handle:%{public}d, pid:%{public}d", handle, pid);
+        return PARAMETER_ERROR;
+    }
+    effectHandles_.erase(it);
+    return NO_ERROR;
+}
+
+int32_t MiscdeviceService::GetCapabilityPage(sptr<Ashmem> &ashmem)
+{
+    ashmem = capabilityPage_.GetAshmem();
+    if (ashmem == nullptr) {
+        MISC_HILOGE("Capability page is not available");
+        return ERROR;
+    }
+    return NO_ERROR;
+}
+
+void MiscdeviceService::PublishCapabilityPage()
+{
+    CapabilitySnapshot snapshot;
+    snapshot.capacity = g_capacity;
+    snapshot.hasDelayTime =
+        (vibratorHdiConnection_.GetDelayTime(snapshot.capacity.GetVibrateMode(), snapshot.delayTime) == ERR_OK);
+    for (const auto &effect : PRESET_EFFECT_NAMES) {
+        std::optional<HdfEffectInfo> effectInfo = vibratorHdiConnection_.GetEffectInfo(effect);
+        if (effectInfo.has_value()) {
+            snapshot.effects[effect] = {
+                .duration = effectInfo->duration,
+                .isSupportEffect = effectInfo->isSupportEffect,
+            };
+        }
+    }
+    {
+        // Runs on the HDI reconnect thread while binder threads may refresh the list.
+        std::lock_guard<std::mutex> lightInfosLock(lightInfosMutex_);
+        snapshot.lights = lightInfos_;
+    }
+    capabilityPage_.Publish(snapshot);
+}
+
+void MiscdeviceService::ReleaseClientEffects(int32_t pid)
+{
+    std::lock_guard<std::mutex> lock(effectHandleMutex_);
+    for (auto it = effectHandles_.begin(); it != effectHandles_.end();) {
+        if (it->second.pid == pid) {
+            it = effectHandles_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
 }  // namespace Sensors
 }  // namespace OHOS
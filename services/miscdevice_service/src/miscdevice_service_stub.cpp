@@ -23,7 +23,7 @@
 #include "message_parcel.h"
 #include "securec.h"
 
-#include "permission_util.h"
+#include "client_session_manager.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -33,11 +33,6 @@ namespace OHOS {
 namespace Sensors {
 using namespace OHOS::HiviewDFX;
 
-namespace {
-const std::string VIBRATE_PERMISSION = "ohos.permission.VIBRATE";
-const std::string LIGHT_PERMISSION = "ohos.permission.SYSTEM_LIGHT_CONTROL";
-}  // namespace
-
 MiscdeviceServiceStub::MiscdeviceServiceStub()
 {
     baseFuncs_[static_cast<uint32_t>(MiscdeviceInterfaceCode::VIBRATE)] =
@@ -70,6 +65,14 @@ MiscdeviceServiceStub::MiscdeviceServiceStub()
         &MiscdeviceServiceStub::PlayPrimitiveEffectStub;
     baseFuncs_[static_cast<uint32_t>(MiscdeviceInterfaceCode::GET_VIBRATOR_CAPACITY)] =
         &MiscdeviceServiceStub::GetVibratorCapacityStub;
+    baseFuncs_[static_cast<uint32_t>(MiscdeviceInterfaceCode::REGISTER_EFFECT)] =
+        &MiscdeviceServiceStub::RegisterEffectStub;
+    baseFuncs_[static_cast<uint32_t>(MiscdeviceInterfaceCode::PLAY_EFFECT_HANDLE)] =
+        &MiscdeviceServiceStub::PlayEffectHandleStub;
+    baseFuncs_[static_cast<uint32_t>(MiscdeviceInterfaceCode::RELEASE_EFFECT)] =
+        &MiscdeviceServiceStub::ReleaseEffectStub;
+    baseFuncs_[static_cast<uint32_t>(MiscdeviceInterfaceCode::GET_CAPABILITY_PAGE)] =
+        &MiscdeviceServiceStub::GetCapabilityPageStub;
 }
 
 MiscdeviceServiceStub::~MiscdeviceServiceStub()
@@ -79,8 +82,7 @@ MiscdeviceServiceStub::~MiscdeviceServiceStub()
 
 int32_t MiscdeviceServiceStub::VibrateStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "VibrateStub", "ERROR_CODE", ret);
@@ -99,8 +101,7 @@ int32_t MiscdeviceServiceStub::VibrateStub(MessageParcel &data, MessageParcel &r
 
 int32_t MiscdeviceServiceStub::StopVibratorAllStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "StopVibratorStub", "ERROR_CODE", ret);
@@ -117,8 +118,7 @@ int32_t MiscdeviceServiceStub::StopVibratorAllStub(MessageParcel &data, MessageP
 
 int32_t MiscdeviceServiceStub::PlayVibratorEffectStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "PlayVibratorEffectStub", "ERROR_CODE", ret);
@@ -139,8 +139,7 @@ int32_t MiscdeviceServiceStub::PlayVibratorEffectStub(MessageParcel &data, Messa
 
 int32_t MiscdeviceServiceStub::StopVibratorByModeStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "StopVibratorByModeStub", "ERROR_CODE", ret);
@@ -178,8 +177,7 @@ int32_t MiscdeviceServiceStub::IsSupportEffectStub(MessageParcel &data, MessageP
 #ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 int32_t MiscdeviceServiceStub::PlayVibratorCustomStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "PlayVibratorCustomStub", "ERROR_CODE", ret);
@@ -247,8 +245,7 @@ int32_t MiscdeviceServiceStub::GetLightListStub(MessageParcel &data, MessageParc
 
 int32_t MiscdeviceServiceStub::TurnOnStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), LIGHT_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_LIGHT);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "LIGHT_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "turnOnStub", "ERROR_CODE", ret);
@@ -266,8 +263,7 @@ int32_t MiscdeviceServiceStub::TurnOnStub(MessageParcel &data, MessageParcel &re
 
 int32_t MiscdeviceServiceStub::TurnOffStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), LIGHT_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_LIGHT);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "LIGHT_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "TurnOffStub", "ERROR_CODE", ret);
@@ -302,18 +298,28 @@ int32_t MiscdeviceServiceStub::OnRemoteRequest(uint32_t code, MessageParcel &dat
 int32_t MiscdeviceServiceStub::PlayPatternStub(MessageParcel &data, MessageParcel &reply)
 {
     CALL_LOG_ENTER;
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "PlayPatternStub", "ERROR_CODE", ret);
         MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
         return PERMISSION_DENIED;
     }
+    uint32_t size = 0;
+    if (!data.ReadUint32(size)) {
+        MISC_HILOGE("Parcel read pattern size failed");
+        return ERROR;
+    }
+    if ((size < sizeof(PatternWireHeader)) || (size > MAX_PATTERN_WIRE_SIZE)) {
+        MISC_HILOGE("Invalid pattern size:%{public}u", size);
+        return ERROR;
+    }
+    const uint8_t *buffer = static_cast<const uint8_t *>(data.ReadRawData(size));
+    CHKPR(buffer, ERROR);
     VibratePattern vibratePattern;
-    auto pattern = vibratePattern.Unmarshalling(data);
+    auto pattern = vibratePattern.Decode(buffer, size);
     if (!pattern.has_value()) {
-        MISC_HILOGE("Pattern Unmarshalling failed");
+        MISC_HILOGE("Pattern decode failed");
         return ERROR;
     }
     int32_t usage = 0;
@@ -358,8 +364,7 @@ int32_t MiscdeviceServiceStub::TransferClientRemoteObjectStub(MessageParcel &dat
 
 int32_t MiscdeviceServiceStub::PlayPrimitiveEffectStub(MessageParcel &data, MessageParcel &reply)
 {
-    PermissionUtil &permissionUtil = PermissionUtil::GetInstance();
-    int32_t ret = permissionUtil.CheckVibratePermission(this->GetCallingTokenID(), VIBRATE_PERMISSION);
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
     if (ret != PERMISSION_GRANTED) {
         HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
             HiSysEvent::EventType::SECURITY, "PKG_NAME", "PlayPrimitiveEffectStub", "ERROR_CODE", ret);
@@ -392,5 +397,92 @@ int32_t MiscdeviceServiceStub::GetVibratorCapacityStub(MessageParcel &data, Mess
     }
     return ret;
 }
+
+int32_t MiscdeviceServiceStub::RegisterEffectStub(MessageParcel &data, MessageParcel &reply)
+{
+    CALL_LOG_ENTER;
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
+    if (ret != PERMISSION_GRANTED) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
+            HiSysEvent::EventType::SECURITY, "PKG_NAME", "RegisterEffectStub", "ERROR_CODE", ret);
+        MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
+        return PERMISSION_DENIED;
+    }
+    VibratePackage vibratePackage;
+    auto package = vibratePackage.Unmarshalling(data);
+    if (!package.has_value()) {
+        MISC_HILOGE("Package Unmarshalling failed");
+        return ERROR;
+    }
+    int32_t handle = 0;
+    ret = RegisterEffect(package.value(), handle);
+    if (ret != NO_ERROR) {
+        MISC_HILOGE("RegisterEffect failed, ret:%{public}d", ret);
+        return ret;
+    }
+    if (!reply.WriteInt32(handle)) {
+        MISC_HILOGE("Parcel write handle failed");
+        ReleaseEffect(handle);
+        return ERROR;
+    }
+    return NO_ERROR;
+}
+
+int32_t MiscdeviceServiceStub::PlayEffectHandleStub(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
+    if (ret != PERMISSION_GRANTED) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
+            HiSysEvent::EventType::SECURITY, "PKG_NAME", "PlayEffectHandleStub", "ERROR_CODE", ret);
+        MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
+        return PERMISSION_DENIED;
+    }
+    int32_t handle = 0;
+    int32_t usage = 0;
+    if ((!data.ReadInt32(handle)) || (!data.ReadInt32(usage))) {
+        MISC_HILOGE("Parcel read failed");
+        return ERROR;
+    }
+    VibrateParameter vibrateParameter;
+    auto parameter = vibrateParameter.Unmarshalling(data);
+    if (!parameter.has_value()) {
+        MISC_HILOGE("Parameter Unmarshalling failed");
+        return ERROR;
+    }
+    return PlayEffectHandle(handle, usage, parameter.value());
+}
+
+int32_t MiscdeviceServiceStub::ReleaseEffectStub(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t ret = SessionManager->CheckPermission(this->GetCallingTokenID(), CLIENT_PERMISSION_VIBRATE);
+    if (ret != PERMISSION_GRANTED) {
+        HiSysEventWrite(HiSysEvent::Domain::MISCDEVICE, "VIBRATOR_PERMISSIONS_EXCEPTION",
+            HiSysEvent::EventType::SECURITY, "PKG_NAME", "ReleaseEffectStub", "ERROR_CODE", ret);
+        MISC_HILOGE("CheckVibratePermission failed, ret:%{public}d", ret);
+        return PERMISSION_DENIED;
+    }
+    int32_t handle = 0;
+    if (!data.ReadInt32(handle)) {
+        MISC_HILOGE("Parcel read handle failed");
+        return ERROR;
+    }
+    return ReleaseEffect(handle);
+}
+
+int32_t MiscdeviceServiceStub::GetCapabilityPageStub(MessageParcel &data, MessageParcel &reply)
+{
+    (void)data;
+    sptr<Ashmem> ashmem = nullptr;
+    int32_t ret = GetCapabilityPage(ashmem);
+    if (ret != NO_ERROR) {
+        MISC_HILOGE("GetCapabilityPage failed, ret:%{public}d", ret);
+        return ret;
+    }
+    if (!reply.WriteAshmem(ashmem)) {
+        MISC_HILOGE("Parcel write ashmem failed");
+        return WRITE_MSG_ERR;
+    }
+    return NO_ERROR;
+}
 }  // namespace Sensors
 }  // namespace OHOS
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "playback_plan.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "custom_vibration_matcher.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "PlaybackPlan"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr size_t COMPOSITE_EFFECT_PART = 128;
+constexpr int32_t MIN_CHUNK_DURATION = 200;
+constexpr int64_t CHUNK_LATENCY_FACTOR = 8;
+constexpr int64_t LATENCY_SMOOTHING_FACTOR = 8;
+constexpr int64_t US_PER_MS = 1000;
+std::atomic<int64_t> g_submitLatencyUs = 0;
+}  // namespace
+
+static void AddStep(PlaybackPlan &plan, PlaybackStepType type, int32_t time, int32_t value = 0, size_t index = 0)
+{
+    PlaybackStep step = {
+        .type = type,
+        .time = time,
+        .value = value,
+        .index = index
+    };
+    plan.steps.push_back(step);
+}
+
+static int32_t BuildOncePlan(const VibrateInfo &info, PlaybackPlan &plan)
+{
+    if (info.duration <= 0) {
+        MISC_HILOGE("Invalid duration:%{public}d", info.duration);
+        return ERROR;
+    }
+    plan.stopMode = HDF_VIBRATOR_MODE_ONCE;
+    AddStep(plan, PlaybackStepType::START_ONCE, 0, info.duration);
+    AddStep(plan, PlaybackStepType::STOP, info.duration, HDF_VIBRATOR_MODE_ONCE);
+    plan.duration = info.duration;
+    return SUCCESS;
+}
+
+static int32_t BuildEffectPlan(const VibrateInfo &info, PlaybackPlan &plan)
+{
+    plan.effect = info.effect;
+    for (int32_t i = 0; i < info.count; ++i) {
+        AddStep(plan, PlaybackStepType::START_EFFECT, i * info.duration);
+        AddStep(plan, PlaybackStepType::STOP, (i + 1) * info.duration, HDF_VIBRATOR_MODE_PRESET);
+    }
+    plan.duration = info.count * info.duration;
+    return SUCCESS;
+}
+
+static int32_t BuildPrimitivePlan(const VibrateInfo &info, PlaybackPlan &plan)
+{
+    plan.effect = info.effect;
+    AddStep(plan, PlaybackStepType::START_BY_INTENSITY, 0, info.intensity);
+    plan.duration = info.duration;
+    return SUCCESS;
+}
+
+static int32_t BuildHdHapticPlan(const VibrateInfo &info, PlaybackPlan &plan)
+{
+    CHKPR(info.package, ERROR);
+    plan.package = info.package;
+    const auto &patterns = plan.package->patterns;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        AddStep(plan, PlaybackStepType::PLAY_PATTERN, patterns[i].startTime, 0, i);
+        plan.duration = std::max(plan.duration, patterns[i].startTime);
+    }
+    return SUCCESS;
+}
+
+static int32_t GetCompositeDelay(int32_t type, const CompositeEffect &effect)
+{
+    return (type == HDF_EFFECT_TYPE_TIME) ? effect.timeEffect.delay : effect.primitiveEffect.delay;
+}
+
+static int32_t BuildCompositePlan(const VibrateInfo &info, PlaybackPlan &plan)
+{
+    CHKPR(info.package, ERROR);
+    CustomVibrationMatcher matcher;
+    std::vector<CompositeEffect> compositeEffects;
+    int32_t type = HDF_EFFECT_TYPE_PRIMITIVE;
+    if (info.mode == VibrateMode::CUSTOM_COMPOSITE_EFFECT) {
+        plan.compositeMode = VIBRATE_MODE_MAPPING;
+        if (matcher.TransformEffect(*info.package, compositeEffects) != SUCCESS) {
+            MISC_HILOGE("Transform pattern to predefined wave fail");
+            return ERROR;
+        }
+    } else {
+        type = HDF_EFFECT_TYPE_TIME;
+        plan.compositeMode = VIBRATE_MODE_TIMES;
+        if (matcher.TransformTime(*info.package, compositeEffects) != SUCCESS) {
+            MISC_HILOGE("Transform pattern to time series fail");
+            return ERROR;
+        }
+    }
+    // A chunk must play long enough to hide the submission of the next one behind it.
+    int64_t targetDuration = std::max<int64_t>(MIN_CHUNK_DURATION,
+        CHUNK_LATENCY_FACTOR * GetCompositeSubmitLatency() / US_PER_MS);
+    size_t effectSize = compositeEffects.size();
+    size_t index = 0;
+    int32_t chunkStartTime = 0;
+    while (index < effectSize) {
+        HdfCompositeEffect effectsPart;
+        effectsPart.type = type;
+        int32_t chunkDuration = 0;
+        while ((index < effectSize) && (effectsPart.compositeEffects.size() < COMPOSITE_EFFECT_PART) &&
+            (chunkDuration < targetDuration)) {
+            chunkDuration += GetCompositeDelay(type, compositeEffects[index]);
+            effectsPart.compositeEffects.push_back(compositeEffects[index]);
+            ++index;
+        }
+        AddStep(plan, PlaybackStepType::ENABLE_COMPOSITE_EFFECT, chunkStartTime, 0, plan.compositeEffects.size());
+        plan.compositeEffects.push_back(std::move(effectsPart));
+        chunkStartTime += chunkDuration;
+    }
+    plan.duration = chunkStartTime;
+    return SUCCESS;
+}
+
+int32_t BuildPlaybackPlan(const VibrateInfo &info, PlaybackPlan &plan)
+{
+    plan = {};
+    switch (info.mode) {
+        case VibrateMode::TIME:
+            return BuildOncePlan(info, plan);
+        case VibrateMode::PRESET:
+            return BuildEffectPlan(info, plan);
+        case VibrateMode::PRIMITIVE:
+            return BuildPrimitivePlan(info, plan);
+        case VibrateMode::CUSTOM_HD:
+            return BuildHdHapticPlan(info, plan);
+        case VibrateMode::CUSTOM_COMPOSITE_EFFECT:
+        case VibrateMode::CUSTOM_COMPOSITE_TIME:
+            return BuildCompositePlan(info, plan);
+        default:
+            MISC_HILOGE("Unsupported vibrate mode:%{public}s", GetVibrateModeName(info.mode).c_str());
+            return ERROR;
+    }
+}
+
+void UpdateCompositeSubmitLatency(int64_t latencyUs)
+{
+    int64_t current = g_submitLatencyUs.load();
+    int64_t updated = (current == 0) ? latencyUs : (current + (latencyUs - current) / LATENCY_SMOOTHING_FACTOR);
+    g_submitLatencyUs.store(updated);
+}
+
+int64_t GetCompositeSubmitLatency()
+{
+    return g_submitLatencyUs.load();
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "vibration_priority_manager.h"
 
+#include <algorithm>
+
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
 #include "system_ability_definition.h"
@@ -35,24 +37,15 @@ const std::string SETTING_RINGER_MODE_KEY = "ringer_mode";
 const std::string SETTING_URI_PROXY = "datashare:///com.ohos.settingsdata/entry/settingsdata/SETTINGSDATA?Proxy=true";
 constexpr const char *SETTINGS_DATA_EXT_URI = "datashare:///com.ohos.settingsdata.DataAbility";
 constexpr int32_t DECEM_BASE = 10;
+constexpr int32_t KEYWORD_COLUMN_INDEX = 0;
+constexpr int32_t VALUE_COLUMN_INDEX = 1;
 }  // namespace
 
 VibrationPriorityManager::VibrationPriorityManager()
 {
     Initialize();
     MiscDeviceObserver::UpdateFunc updateFunc = [&]() {
-        int32_t feedback = miscFeedback_;
-        if (GetIntValue(SETTING_FEEDBACK_KEY, feedback) != ERR_OK) {
-            MISC_HILOGE("Get feedback failed");
-        }
-        miscFeedback_ = feedback;
-        MISC_HILOGI("feedback:%{public}d", feedback);
-        int32_t ringerMode = miscAudioRingerMode_;
-        if (GetIntValue(SETTING_RINGER_MODE_KEY, ringerMode) != ERR_OK) {
-            MISC_HILOGE("Get ringerMode failed");
-        }
-        miscAudioRingerMode_ = ringerMode;
-        MISC_HILOGI("ringerMode:%{public}d", ringerMode);
+        settings_.RequestRefresh();
     };
     auto observer = CreateObserver(updateFunc);
     if (observer == nullptr) {
@@ -60,17 +53,20 @@ VibrationPriorityManager::VibrationPriorityManager()
         return;
     }
     observer_ = observer;
-    if (RegisterObserver(observer_) != ERR_OK) {
-        MISC_HILOGE("RegisterObserver failed");
+    // Registers the observer and loads the settings before the first admission can run; the service
+    // creates the manager in OnStart. If settingsdata is not up yet, the load is retried in background.
+    if (settings_.Start() != ERR_OK) {
+        MISC_HILOGW("Settings not loaded, use defaults until a retry succeeds");
     }
 }
 
 VibrationPriorityManager::~VibrationPriorityManager()
 {
-    remoteObj_ = nullptr;
-    if (UnregisterObserver(observer_) != ERR_OK) {
+    settings_.Stop();
+    if (observerRegistered_ && (UnregisterObserver(observer_) != ERR_OK)) {
         MISC_HILOGE("UnregisterObserver failed");
     }
+    remoteObj_ = nullptr;
 }
 
 int32_t VibrationPriorityManager::GetIntValue(const std::string &key, int32_t &value)
@@ -134,24 +130,91 @@ int32_t VibrationPriorityManager::GetStringValue(const std::string &key, std::st
     return ERR_OK;
 }
 
-void VibrationPriorityManager::UpdateStatus()
+int32_t VibrationPriorityManager::QuerySettings(std::map<std::string, std::string> &values)
 {
-    if (miscFeedback_ == FEEDBACK_MODE_INVALID) {
-        int32_t feedback = FEEDBACK_MODE_INVALID;
-        if (GetIntValue(SETTING_FEEDBACK_KEY, feedback) != ERR_OK) {
-            feedback = FEEDBACK_MODE_ON;
-            MISC_HILOGE("Get feedback failed");
+    std::string callingIdentity = IPCSkeleton::ResetCallingIdentity();
+    auto helper = CreateDataShareHelper();
+    if (helper == nullptr) {
+        IPCSkeleton::SetCallingIdentity(callingIdentity);
+        return MISC_NO_INIT_ERR;
+    }
+    std::vector<std::string> columns = {SETTING_COLUMN_KEYWORD, SETTING_COLUMN_VALUE};
+    std::vector<std::string> keys = {SETTING_FEEDBACK_KEY, SETTING_RINGER_MODE_KEY};
+    DataShare::DataSharePredicates predicates;
+    predicates.In(SETTING_COLUMN_KEYWORD, keys);
+    Uri uri(SETTING_URI_PROXY);
+    auto resultSet = helper->Query(uri, predicates, columns);
+    ReleaseDataShareHelper(helper);
+    if (resultSet == nullptr) {
+        MISC_HILOGE("resultSet is nullptr");
+        IPCSkeleton::SetCallingIdentity(callingIdentity);
+        return MISC_INVALID_OPERATION_ERR;
+    }
+    int32_t count = 0;
+    resultSet->GetRowCount(count);
+    for (int32_t row = 0; row < count; ++row) {
+        resultSet->GoToRow(row);
+        std::string key;
+        std::string value;
+        if ((resultSet->GetString(KEYWORD_COLUMN_INDEX, key) != ERR_OK) ||
+            (resultSet->GetString(VALUE_COLUMN_INDEX, value) != ERR_OK)) {
+            MISC_HILOGW("GetString failed, row:%{public}d", row);
+            continue;
         }
-        miscFeedback_ = feedback;
+        values[key] = value;
     }
-    if (miscAudioRingerMode_ == RINGER_MODE_INVALID) {
-        int32_t ringerMode = RINGER_MODE_INVALID;
-        if (GetIntValue(SETTING_RINGER_MODE_KEY, ringerMode) != ERR_OK) {
-            ringerMode = RINGER_MODE_NORMAL;
-            MISC_HILOGE("Get ringerMode failed");
+    resultSet->Close();
+    IPCSkeleton::SetCallingIdentity(callingIdentity);
+    return ERR_OK;
+}
+
+int32_t VibrationPriorityManager::LoadSettings(SettingsSnapshot &snapshot)
+{
+    std::map<std::string, std::string> values;
+    int32_t ret = QuerySettings(values);
+    if (ret == MISC_NO_INIT_ERR) {
+        MISC_HILOGW("settingsdata is not ready");
+        return ret;
+    }
+    if (ret != ERR_OK) {
+        MISC_HILOGW("Batched settings query failed, query keys one by one");
+    }
+    std::vector<std::pair<std::string, int32_t *>> items = {
+        {SETTING_FEEDBACK_KEY, &snapshot.feedback},
+        {SETTING_RINGER_MODE_KEY, &snapshot.ringerMode},
+    };
+    for (auto &item : items) {
+        auto it = values.find(item.first);
+        if (it != values.end()) {
+            *item.second = static_cast<int32_t>(strtoll(it->second.c_str(), nullptr, DECEM_BASE));
+            continue;
+        }
+        ret = GetIntValue(item.first, *item.second);
+        if ((ret == MISC_NO_INIT_ERR) || (ret == MISC_INVALID_OPERATION_ERR)) {
+            MISC_HILOGW("settingsdata is not ready");
+            return ret;
+        }
+        if (ret != ERR_OK) {
+            MISC_HILOGE("Get %{public}s failed", item.first.c_str());
         }
-        miscAudioRingerMode_ = ringerMode;
     }
+    return ERR_OK;
+}
+
+int32_t VibrationPriorityManager::RefreshSettings(SettingsSnapshot &snapshot)
+{
+    if (remoteObj_ == nullptr) {
+        Initialize();
+    }
+    if (!observerRegistered_) {
+        int32_t ret = RegisterObserver(observer_);
+        if (ret != ERR_OK) {
+            MISC_HILOGW("RegisterObserver failed, ret:%{public}d", ret);
+            return ret;
+        }
+        observerRegistered_ = true;
+    }
+    return LoadSettings(snapshot);
 }
 
 VibrateStatus VibrationPriorityManager::ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo,
@@ -161,63 +224,43 @@ VibrateStatus VibrationPriorityManager::ShouldIgnoreVibrate(const VibrateInfo &v
         MISC_HILOGD("There is no vibration, it can vibrate");
         return VIBRATION;
     }
-    UpdateStatus();
-    if ((vibrateInfo.usage == USAGE_ALARM || vibrateInfo.usage == USAGE_RING || vibrateInfo.usage == USAGE_NOTIFICATION
-        || vibrateInfo.usage == USAGE_COMMUNICATION) && (miscAudioRingerMode_ == RINGER_MODE_SILENT)) {
-        MISC_HILOGD("Vibration is ignored for ringer mode:%{public}d", static_cast<int32_t>(miscAudioRingerMode_));
-        return IGNORE_RINGER_MODE;
-    }
-    if ((vibrateInfo.usage == USAGE_TOUCH || vibrateInfo.usage == USAGE_MEDIA || vibrateInfo.usage == USAGE_UNKNOWN
-        || vibrateInfo.usage == USAGE_PHYSICAL_FEEDBACK || vibrateInfo.usage == USAGE_SIMULATE_REALITY)
-        && (miscFeedback_ == FEEDBACK_MODE_OFF)) {
-        MISC_HILOGD("Vibration is ignored for feedback:%{public}d", static_cast<int32_t>(miscFeedback_));
-        return IGNORE_FEEDBACK;
-    }
-    if (vibratorThread == nullptr) {
-        MISC_HILOGD("There is no vibration, it can vibrate");
-        return VIBRATION;
+    SettingsSnapshot settings = settings_.Get();
+    AdmissionState state;
+    state.usage = vibrateInfo.usage;
+    state.isLoop = IsLoopVibrate(vibrateInfo);
+    state.isRingerSilent = (settings.ringerMode == RINGER_MODE_SILENT);
+    state.isFeedbackOff = (settings.feedback == FEEDBACK_MODE_OFF);
+    state.isVibrating = IsCurrentVibrate(vibratorThread);
+    if (state.isVibrating) {
+        auto currentVibrateInfo = vibratorThread->GetCurrentVibrateInfo();
+        state.currentUsage = currentVibrateInfo->usage;
+        state.isCurrentLoop = IsLoopVibrate(*currentVibrateInfo);
     }
-    if (!IsCurrentVibrate(vibratorThread)) {
-        MISC_HILOGD("There is no vibration at the moment, it can vibrate");
+    if ((state.usage < 0) || (state.usage >= USAGE_MAX) || (state.currentUsage < 0) ||
+        (state.currentUsage >= USAGE_MAX)) {
+        MISC_HILOGE("Invalid usage:%{public}d, current usage:%{public}d", state.usage, state.currentUsage);
         return VIBRATION;
     }
-    if (IsLoopVibrate(vibrateInfo)) {
-        MISC_HILOGD("Can vibrate, loop priority is high");
-        return VIBRATION;
+    VibrateStatus status = LookupAdmission(state);
+    if (status != VIBRATION) {
+        MISC_HILOGD("Vibration is ignored, status:%{public}d, usage:%{public}d, current usage:%{public}d",
+            status, state.usage, state.currentUsage);
     }
-    return ShouldIgnoreVibrate(vibrateInfo, vibratorThread->GetCurrentVibrateInfo());
+    return status;
 }
 
 bool VibrationPriorityManager::IsCurrentVibrate(std::shared_ptr<VibratorThread> vibratorThread) const
 {
 #if defined(OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM)
-    return ((vibratorThread != nullptr) && (vibratorThread->IsRunning() || VibratorDevice.IsVibratorRunning()));
+    return ((vibratorThread != nullptr) && (vibratorThread->IsVibrating() || VibratorDevice.IsVibratorRunning()));
 #else
-    return ((vibratorThread != nullptr) && (vibratorThread->IsRunning()));
+    return ((vibratorThread != nullptr) && (vibratorThread->IsVibrating()));
 #endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
 }
 
 bool VibrationPriorityManager::IsLoopVibrate(const VibrateInfo &vibrateInfo) const
 {
-    return ((vibrateInfo.mode == "preset") && (vibrateInfo.count > 1));
-}
-
-VibrateStatus VibrationPriorityManager::ShouldIgnoreVibrate(const VibrateInfo &vibrateInfo,
-    VibrateInfo currentVibrateInfo) const
-{
-    if (currentVibrateInfo.usage == USAGE_ALARM) {
-        MISC_HILOGD("Vibration is ignored for alarm");
-        return IGNORE_ALARM;
-    }
-    if (IsLoopVibrate(currentVibrateInfo)) {
-        MISC_HILOGD("Vibration is ignored for repeat");
-        return IGNORE_REPEAT;
-    }
-    if ((currentVibrateInfo.usage != vibrateInfo.usage) && (vibrateInfo.usage == USAGE_UNKNOWN)) {
-        MISC_HILOGD("Vibration is ignored, unknown has a low priority");
-        return IGNORE_UNKNOWN;
-    }
-    return VIBRATION;
+    return ((vibrateInfo.mode == VibrateMode::PRESET) && (vibrateInfo.count > 1));
 }
 
 sptr<MiscDeviceObserver> VibrationPriorityManager::CreateObserver(const MiscDeviceObserver::UpdateFunc &func)
@@ -275,15 +318,6 @@ bool VibrationPriorityManager::ReleaseDataShareHelper(std::shared_ptr<DataShare:
     return true;
 }
 
-void VibrationPriorityManager::ExecRegisterCb(const sptr<MiscDeviceObserver> &observer)
-{
-    if (observer == nullptr) {
-        MISC_HILOGE("observer is nullptr");
-        return;
-    }
-    observer->OnChange();
-}
-
 int32_t VibrationPriorityManager::RegisterObserver(const sptr<MiscDeviceObserver> &observer)
 {
     if (observer == nullptr) {
@@ -302,8 +336,6 @@ int32_t VibrationPriorityManager::RegisterObserver(const sptr<MiscDeviceObserver
     auto uriRingerMode = AssembleUri(SETTING_RINGER_MODE_KEY);
     helper->RegisterObserver(uriRingerMode, observer);
     helper->NotifyChange(uriRingerMode);
-    std::thread execCb(VibrationPriorityManager::ExecRegisterCb, observer);
-    execCb.detach();
     ReleaseDataShareHelper(helper);
     IPCSkeleton::SetCallingIdentity(callingIdentity);
     MISC_HILOGD("succeed to register observer of uri");
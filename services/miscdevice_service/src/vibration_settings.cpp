@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibration_settings.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationSettings"
+
+namespace OHOS {
+namespace Sensors {
+VibrationSettings::VibrationSettings(LoadFunc load) : load_(std::move(load))
+{}
+
+VibrationSettings::~VibrationSettings()
+{
+    Stop();
+}
+
+int32_t VibrationSettings::Start()
+{
+    if (refreshWorker_.joinable()) {
+        MISC_HILOGW("Settings already started");
+        return ERR_OK;
+    }
+    int32_t ret = Load();
+    if (ret != ERR_OK) {
+        MISC_HILOGW("First settings load failed, ret:%{public}d, retry in background", ret);
+    }
+    refreshWorker_ = std::thread([this, ret] {
+        RefreshLoop(ret);
+    });
+    return ret;
+}
+
+void VibrationSettings::Stop()
+{
+    {
+        std::lock_guard<std::mutex> refreshLock(refreshMutex_);
+        stopRefresh_ = true;
+    }
+    refreshCv_.notify_all();
+    if (refreshWorker_.joinable()) {
+        refreshWorker_.join();
+    }
+}
+
+void VibrationSettings::RequestRefresh()
+{
+    {
+        std::lock_guard<std::mutex> refreshLock(refreshMutex_);
+        refreshRequested_ = true;
+    }
+    refreshCv_.notify_one();
+}
+
+SettingsSnapshot VibrationSettings::Get() const
+{
+    SettingsSnapshot snapshot = settings_.load();
+    if (snapshot.feedback == FEEDBACK_MODE_INVALID) {
+        snapshot.feedback = FEEDBACK_MODE_ON;
+    }
+    if (snapshot.ringerMode == RINGER_MODE_INVALID) {
+        snapshot.ringerMode = RINGER_MODE_NORMAL;
+    }
+    return snapshot;
+}
+
+int32_t VibrationSettings::Load()
+{
+    SettingsSnapshot snapshot = settings_.load();
+    int32_t ret = load_(snapshot);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    settings_.store(snapshot);
+    MISC_HILOGI("feedback:%{public}d, ringerMode:%{public}d", snapshot.feedback, snapshot.ringerMode);
+    return ERR_OK;
+}
+
+void VibrationSettings::RefreshLoop(int32_t firstRet)
+{
+    // Changes arriving during a load are coalesced. A load that fails, e.g. because settingsdata is not
+    // up yet early in boot, is retried with exponential backoff; a change notification retries at once.
+    int32_t ret = firstRet;
+    int32_t retryDelayMs = RETRY_DELAY_MIN_MS;
+    std::unique_lock<std::mutex> refreshLock(refreshMutex_);
+    while (true) {
+        if (ret == ERR_OK) {
+            retryDelayMs = RETRY_DELAY_MIN_MS;
+            refreshCv_.wait(refreshLock, [this] {
+                return stopRefresh_ || refreshRequested_;
+            });
+        } else {
+            MISC_HILOGW("Refresh settings failed, retry in %{public}d ms", retryDelayMs);
+            refreshCv_.wait_for(refreshLock, std::chrono::milliseconds(retryDelayMs), [this] {
+                return stopRefresh_ || refreshRequested_;
+            });
+            retryDelayMs = std::min(retryDelayMs * 2, RETRY_DELAY_MAX_MS);
+        }
+        if (stopRefresh_) {
+            return;
+        }
+        refreshRequested_ = false;
+        refreshLock.unlock();
+        ret = Load();
+        refreshLock.lock();
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
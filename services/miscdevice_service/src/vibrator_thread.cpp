@@ -17,7 +17,8 @@
 
 #include <sys/prctl.h>
 
-#include "custom_vibration_matcher.h"
+#include <algorithm>
+
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -27,168 +28,220 @@ namespace OHOS {
 namespace Sensors {
 namespace {
 const std::string VIBRATE_CONTROL_THREAD_NAME = "OS_VibControl";
-constexpr size_t COMPOSITE_EFFECT_PART = 128;
+constexpr int64_t US_PER_MS = 1000;
 }  // namespace
 
 bool VibratorThread::Run()
 {
-    CALL_LOG_ENTER;
     prctl(PR_SET_NAME, VIBRATE_CONTROL_THREAD_NAME.c_str());
-    VibrateInfo info = GetCurrentVibrateInfo();
-    if (info.mode == VIBRATE_TIME) {
-        int32_t ret = PlayOnce(info);
-        if (ret != SUCCESS) {
-            MISC_HILOGE("Play once vibration fail, package:%{public}s", info.packageName.c_str());
-            return false;
-        }
-    } else if (info.mode == VIBRATE_PRESET) {
-        int32_t ret = PlayEffect(info);
-        if (ret != SUCCESS) {
-            MISC_HILOGE("Play effect vibration fail, package:%{public}s", info.packageName.c_str());
-            return false;
-        }
-    } else if (info.mode == VIBRATE_CUSTOM_HD) {
-        int32_t ret = PlayCustomByHdHptic(info);
-        if (ret != SUCCESS) {
-            MISC_HILOGE("Play custom vibration by hd haptic fail, package:%{public}s", info.packageName.c_str());
-            return false;
-        }
-    } else if (info.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT || info.mode == VIBRATE_CUSTOM_COMPOSITE_TIME) {
-        int32_t ret = PlayCustomByCompositeEffect(info);
-        if (ret != SUCCESS) {
-            MISC_HILOGE("Play custom vibration by composite effect fail, package:%{public}s", info.packageName.c_str());
-            return false;
-        }
+    VibrateCommand command;
+    if (!WaitForCommand(command)) {
+        MISC_HILOGI("Vibrator thread exit");
+        return false;
     }
-    return false;
-}
-
-int32_t VibratorThread::PlayOnce(const VibrateInfo &info)
-{
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
-    int32_t ret = VibratorDevice.StartOnce(static_cast<uint32_t>(info.duration));
-    if (ret != SUCCESS) {
-        MISC_HILOGE("StartOnce fail, duration:%{public}d", info.duration);
-        return ERROR;
+    StopDeviceVibration();
+    if (command.type == VibrateCommandType::STOP) {
+        return true;
     }
-    cv_.wait_for(vibrateLck, std::chrono::milliseconds(info.duration), [this] { return exitFlag_.load(); });
-    VibratorDevice.Stop(HDF_VIBRATOR_MODE_ONCE);
-    if (exitFlag_) {
-        MISC_HILOGD("Stop duration:%{public}d, package:%{public}s", info.duration, info.packageName.c_str());
-        return SUCCESS;
+    StartPlaybackClock();
+    const VibrateInfo &info = *command.info;
+    int32_t ret = ERROR;
+    if (command.plan != nullptr) {
+        ret = PlayPlan(info, *command.plan);
     }
-    return SUCCESS;
+    if (ret != SUCCESS) {
+        MISC_HILOGE("Play vibration fail, mode:%{public}s, package:%{public}s",
+            GetVibrateModeName(info.mode).c_str(), info.packageName.c_str());
+    }
+    DumpHelper->SavePlaybackDrift(info, playbackDrift_);
+    uint64_t sequence = command.sequence;
+    activeSequence_.compare_exchange_strong(sequence, 0);
+    return true;
 }
 
-int32_t VibratorThread::PlayEffect(const VibrateInfo &info)
+int32_t VibratorThread::PlayPlan(const VibrateInfo &info, const PlaybackPlan &plan)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
-    for (int32_t i = 0; i < info.count; ++i) {
-        std::string effect = info.effect;
-        int32_t ret = VibratorDevice.Start(effect);
+    int32_t leadTime = plan.compositeEffects.empty() ? 0 : GetCompositeLeadTime(plan.compositeMode);
+    int32_t lastStepTime = 0;
+    for (const auto &step : plan.steps) {
+        int32_t stepTime = step.time;
+        if (step.type == PlaybackStepType::ENABLE_COMPOSITE_EFFECT) {
+            // Composite chunks are submitted ahead of their boundary so the HDI start latency is hidden.
+            stepTime = std::max(stepTime - leadTime, 0);
+        }
+        WaitUntil(stepTime);
+        if (IsInterrupted()) {
+            VibratorDevice.Stop(plan.stopMode);
+            MISC_HILOGD("Stop vibration, mode:%{public}s, package:%{public}s", GetVibrateModeName(info.mode).c_str(),
+                info.packageName.c_str());
+            return SUCCESS;
+        }
+        int32_t ret = ExecuteStep(plan, step);
         if (ret != SUCCESS) {
-            MISC_HILOGE("Vibrate effect %{public}s failed, ", effect.c_str());
+            MISC_HILOGE("Execute playback step fail, type:%{public}d", static_cast<int32_t>(step.type));
             return ERROR;
         }
-        cv_.wait_for(vibrateLck, std::chrono::milliseconds(info.duration), [this] { return exitFlag_.load(); });
-        VibratorDevice.Stop(HDF_VIBRATOR_MODE_PRESET);
-        if (exitFlag_) {
-            MISC_HILOGD("Stop effect:%{public}s, package:%{public}s", effect.c_str(), info.packageName.c_str());
-            return SUCCESS;
+        lastStepTime = step.time;
+    }
+    if (plan.duration > lastStepTime) {
+        WaitUntil(plan.duration);
+        if (IsInterrupted()) {
+            VibratorDevice.Stop(plan.stopMode);
+            MISC_HILOGD("Stop vibration, mode:%{public}s, package:%{public}s", GetVibrateModeName(info.mode).c_str(),
+                info.packageName.c_str());
         }
     }
     return SUCCESS;
 }
 
-int32_t VibratorThread::PlayCustomByHdHptic(const VibrateInfo &info)
+int32_t VibratorThread::ExecuteStep(const PlaybackPlan &plan, const PlaybackStep &step)
 {
-    std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
-    const std::vector<VibratePattern> &patterns = info.package.patterns;
-    size_t patternSize = patterns.size();
-    for (size_t i = 0; i < patternSize; ++i) {
-        int32_t delayTime;
-        if (i == 0) {
-            delayTime = patterns[i].startTime;
-        } else {
-            delayTime = patterns[i].startTime - patterns[i - 1].startTime;
+    switch (step.type) {
+        case PlaybackStepType::START_ONCE: {
+            return VibratorDevice.StartOnce(static_cast<uint32_t>(step.value));
         }
-        cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return exitFlag_.load(); });
-        if (exitFlag_) {
-            MISC_HILOGD("Stop hd haptic, package:%{public}s", info.packageName.c_str());
-            return SUCCESS;
+        case PlaybackStepType::START_EFFECT: {
+            return VibratorDevice.Start(plan.effect);
+        }
+        case PlaybackStepType::START_BY_INTENSITY: {
+            return VibratorDevice.StartByIntensity(plan.effect, step.value);
+        }
+        case PlaybackStepType::PLAY_PATTERN: {
+            return VibratorDevice.PlayPattern(*plan.package, plan.package->patterns[step.index]);
+        }
+        case PlaybackStepType::ENABLE_COMPOSITE_EFFECT: {
+            auto submitTime = std::chrono::steady_clock::now();
+            int32_t ret = VibratorDevice.EnableCompositeEffect(plan.compositeEffects[step.index]);
+            UpdateCompositeSubmitLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - submitTime).count());
+            return ret;
+        }
+        case PlaybackStepType::STOP: {
+            return VibratorDevice.Stop(static_cast<HdfVibratorMode>(step.value));
+        }
+        default: {
+            MISC_HILOGE("Unknown playback step type");
+            return ERROR;
         }
     }
-    return SUCCESS;
 }
 
-int32_t VibratorThread::PlayCustomByCompositeEffect(const VibrateInfo &info)
+int32_t VibratorThread::GetCompositeLeadTime(int32_t compositeMode)
 {
-    CustomVibrationMatcher matcher;
-    HdfCompositeEffect hdfCompositeEffect;
-    if (info.mode == VIBRATE_CUSTOM_COMPOSITE_EFFECT) {
-        hdfCompositeEffect.type = HDF_EFFECT_TYPE_PRIMITIVE;
-        int32_t ret = matcher.TransformEffect(info.package, hdfCompositeEffect.compositeEffects);
-        if (ret != SUCCESS) {
-            MISC_HILOGE("Transform pattern to predefined wave fail");
-            return ERROR;
-        }
-    } else if (info.mode == VIBRATE_CUSTOM_COMPOSITE_TIME) {
-        hdfCompositeEffect.type = HDF_EFFECT_TYPE_TIME;
-        int32_t ret = matcher.TransformTime(info.package, hdfCompositeEffect.compositeEffects);
-        if (ret != SUCCESS) {
-            MISC_HILOGE("Transform pattern to time series fail");
-            return ERROR;
-        }
+    int32_t delayTime = 0;
+    if (VibratorDevice.GetDelayTime(compositeMode, delayTime) != SUCCESS) {
+        MISC_HILOGW("GetDelayTime failed, submit chunks without lead time");
+        delayTime = 0;
+    }
+    return std::max(delayTime, 0) + static_cast<int32_t>(GetCompositeSubmitLatency() / US_PER_MS);
+}
+
+bool VibratorThread::StartVibrate(const VibrateInfo &info, std::shared_ptr<const PlaybackPlan> plan)
+{
+    auto vibration = std::make_shared<const VibrateInfo>(info);
+    auto previousVibration = std::atomic_exchange(&currentVibration_, vibration);
+    uint64_t sequence = ++commandSequence_;
+    // Mark the vibration active before the worker can see it, so a fast finish cannot be overwritten.
+    uint64_t previous = activeSequence_.exchange(sequence);
+    VibrateCommand command = {
+        .type = VibrateCommandType::PLAY,
+        .sequence = sequence,
+        .info = vibration,
+        .plan = plan
+    };
+    if (!PostCommand(std::move(command))) {
+        // The vibration never reaches the worker, so neither the snapshot nor the sequence may show it.
+        activeSequence_.compare_exchange_strong(sequence, previous);
+        std::atomic_compare_exchange_strong(&currentVibration_, &vibration, previousVibration);
+        return false;
+    }
+    return true;
+}
+
+bool VibratorThread::StopVibrate()
+{
+    activeSequence_.store(0);
+    VibrateCommand command = {
+        .type = VibrateCommandType::STOP,
+        .sequence = ++commandSequence_
+    };
+    return PostCommand(std::move(command));
+}
+
+bool VibratorThread::IsVibrating() const
+{
+    return (activeSequence_.load() != 0);
+}
+
+bool VibratorThread::PostCommand(VibrateCommand &&command)
+{
+    if (!commandQueue_.Push(std::move(command))) {
+        MISC_HILOGE("Vibrate command queue is full");
+        return false;
+    }
+    {
+        // Pairs with the predicate check in the worker so the notification cannot be lost.
+        std::lock_guard<std::mutex> vibrateLck(vibrateMutex_);
     }
-    return PlayCompositeEffect(info, hdfCompositeEffect);
+    cv_.notify_one();
+    return true;
 }
 
-int32_t VibratorThread::PlayCompositeEffect(const VibrateInfo &info, const HdfCompositeEffect &hdfCompositeEffect)
+bool VibratorThread::WaitForCommand(VibrateCommand &command)
 {
     std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
-    HdfCompositeEffect effectsPart;
-    effectsPart.type = hdfCompositeEffect.type;
-    size_t effectSize = hdfCompositeEffect.compositeEffects.size();
-    int32_t delayTime = 0;
-    for (size_t i = 0; i < effectSize; ++i) {
-        effectsPart.compositeEffects.push_back(hdfCompositeEffect.compositeEffects[i]);
-        if (effectsPart.type == HDF_EFFECT_TYPE_TIME) {
-            delayTime += hdfCompositeEffect.compositeEffects[i].timeEffect.delay;
-        } else if (effectsPart.type == HDF_EFFECT_TYPE_PRIMITIVE) {
-            delayTime += hdfCompositeEffect.compositeEffects[i].primitiveEffect.delay;
-        } else {
-            MISC_HILOGE("Effect type is valid");
-            return ERROR;
-        }
-        if ((effectsPart.compositeEffects.size() >= COMPOSITE_EFFECT_PART) || (i == (effectSize - 1))) {
-            int32_t ret = VibratorDevice.EnableCompositeEffect(effectsPart);
-            if (ret != SUCCESS) {
-                MISC_HILOGE("EnableCompositeEffect failed");
-                return ERROR;
-            }
-            cv_.wait_for(vibrateLck, std::chrono::milliseconds(delayTime), [this] { return exitFlag_.load(); });
-            delayTime = 0;
-            effectsPart.compositeEffects.clear();
-        }
-        if (exitFlag_) {
-            VibratorDevice.Stop(HDF_VIBRATOR_MODE_PRESET);
-            MISC_HILOGD("Stop composite effect part, package:%{public}s", info.packageName.c_str());
-            return SUCCESS;
+    cv_.wait(vibrateLck, [this] { return exitFlag_.load() || !commandQueue_.Empty(); });
+    if (exitFlag_) {
+        return false;
+    }
+    // Only the newest command matters, older ones have already been superseded.
+    VibrateCommand next;
+    while (commandQueue_.Pop(next)) {
+        command = std::move(next);
+    }
+    return true;
+}
+
+void VibratorThread::StartPlaybackClock()
+{
+    playbackStart_ = std::chrono::steady_clock::now();
+    playbackDrift_ = {};
+}
+
+void VibratorThread::WaitUntil(int32_t offsetTime)
+{
+    auto deadline = playbackStart_ + std::chrono::milliseconds(offsetTime);
+    {
+        std::unique_lock<std::mutex> vibrateLck(vibrateMutex_);
+        if (cv_.wait_until(vibrateLck, deadline, [this] { return IsInterrupted(); })) {
+            return;
         }
     }
-    return SUCCESS;
+    int64_t lateness = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - deadline).count();
+    lateness = std::max<int64_t>(lateness, 0);
+    ++playbackDrift_.stepCount;
+    playbackDrift_.totalLatenessUs += lateness;
+    playbackDrift_.maxLatenessUs = std::max(playbackDrift_.maxLatenessUs, lateness);
 }
 
-void VibratorThread::UpdateVibratorEffect(const VibrateInfo &info)
+bool VibratorThread::IsInterrupted() const
 {
-    std::unique_lock<std::mutex> lck(currentVibrationMutex_);
-    currentVibration_ = info;
+    return (exitFlag_.load() || !commandQueue_.Empty());
 }
 
-VibrateInfo VibratorThread::GetCurrentVibrateInfo()
+void VibratorThread::StopDeviceVibration()
 {
-    std::unique_lock<std::mutex> lck(currentVibrationMutex_);
-    return currentVibration_;
+#ifdef OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+    if (VibratorDevice.IsVibratorRunning()) {
+        VibratorDevice.Stop(HDF_VIBRATOR_MODE_PRESET);
+    }
+#endif // OHOS_BUILD_ENABLE_VIBRATOR_CUSTOM
+}
+
+std::shared_ptr<const VibrateInfo> VibratorThread::GetCurrentVibrateInfo() const
+{
+    return std::atomic_load(&currentVibration_);
 }
 
 void VibratorThread::SetExitStatus(bool status)
@@ -199,6 +252,9 @@ void VibratorThread::SetExitStatus(bool status)
 void VibratorThread::WakeUp()
 {
     MISC_HILOGD("Notify the vibratorThread");
+    {
+        std::lock_guard<std::mutex> vibrateLck(vibrateMutex_);
+    }
     cv_.notify_one();
 }
 }  // namespace Sensors
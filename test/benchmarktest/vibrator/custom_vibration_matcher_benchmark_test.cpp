@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "custom_vibration_matcher.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "CustomVibrationMatcherBenchmarkTest"
+
+using namespace OHOS::Sensors;
+
+namespace {
+const std::map<int32_t, std::vector<int32_t>> TRANSIENT_VIBRATION_INFOS = {
+    {0x28, {0x4d, 0x4d, 0x0b}}, {0x2c, {0x2a, 0x64, 0x07}}, {0x30, {0x44, 0x52, 0x16}},
+    {0x3c, {0x45, 0x34, 0x0a}}, {0x40, {0x2e, 0x43, 0x0a}}, {0x48, {0x51, 0x52, 0x0a}},
+    {0x4c, {0x3a, 0x0c, 0x0f}}, {0x50, {0x64, 0x20, 0x14}}, {0x54, {0x55, 0x34, 0x1c}},
+    {0x5c, {0x32, 0x0c, 0x13}}, {0x60, {0x12, 0x07, 0x0a}}
+};
+constexpr int32_t TRANSIENT_GRADE_NUM = 4;
+constexpr float TRANSIENT_GRADE_GAIN = 0.25;
+constexpr float INTENSITY_WEIGHT = 0.5;
+constexpr float FREQUENCY_WEIGHT = 0.5;
+constexpr float WEIGHT_SUM_INIT = 100;
+constexpr int32_t VALUE_MAX = 100;
+constexpr int32_t TRANSIENT_TRACK_SIZE = 1024;
+constexpr int32_t SLICE_STEP = 50;
+constexpr int32_t CURVE_POINT_NUM = 16;
+constexpr int32_t CURVE_NUM = 64;
+
+// The search ProcessTransientEvent ran for every event before the match table, kept verbatim as the reference.
+int32_t ReferenceTransientMatch(int32_t intensity, int32_t frequency)
+{
+    int32_t matchId = 0;
+    float minWeightSum = WEIGHT_SUM_INIT;
+    for (const auto &transientInfo : TRANSIENT_VIBRATION_INFOS) {
+        int32_t id = transientInfo.first;
+        const std::vector<int32_t> &info = transientInfo.second;
+        float frequencyDistance = std::abs(frequency - info[1]);
+        for (int32_t j = 0; j < TRANSIENT_GRADE_NUM; ++j) {
+            float intensityDistance = std::abs(intensity - info[0] * (1 - j * TRANSIENT_GRADE_GAIN));
+            float weightSum = INTENSITY_WEIGHT * intensityDistance + FREQUENCY_WEIGHT * frequencyDistance;
+            if (weightSum < minWeightSum) {
+                minWeightSum = weightSum;
+                matchId = id + j;
+            }
+        }
+    }
+    return matchId;
+}
+
+// The interpolation and slicing loop ProcessContinuousEvent ran before the batched kernel, kept verbatim.
+int32_t ReferenceInterpolation(int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t x)
+{
+    if (x1 == x2) {
+        return y1;
+    }
+    float delta_y = static_cast<float>(y2 - y1);
+    float delta_x = static_cast<float>(x2 - x1);
+    return y1 + delta_y / delta_x * (x - x1);
+}
+
+std::vector<VibrateSlice> ReferenceSliceCurve(const std::vector<VibrateCurvePoint> &curve)
+{
+    std::vector<VibrateSlice> slices;
+    int32_t endTime = curve.back().time;
+    int32_t curTime = curve.front().time;
+    int32_t curIntensity = curve.front().intensity;
+    int32_t curFrequency = curve.front().frequency;
+    int32_t nextTime = 0;
+    int32_t i = 0;
+    while (curTime < endTime) {
+        if ((endTime - curTime) >= (2 * SLICE_STEP)) {
+            nextTime = curTime + SLICE_STEP;
+        } else {
+            nextTime = endTime;
+        }
+        while (curve[i].time < nextTime) {
+            ++i;
+        }
+        if (i < 1) {
+            curTime = nextTime;
+            continue;
+        }
+        int32_t nextIntensity = ReferenceInterpolation(curve[i - 1].time, curve[i].time, curve[i - 1].intensity,
+            curve[i].intensity, nextTime);
+        int32_t nextFrequency = ReferenceInterpolation(curve[i - 1].time, curve[i].time, curve[i - 1].frequency,
+            curve[i].frequency, nextTime);
+        slices.push_back({
+            .time = curTime,
+            .duration = nextTime - curTime,
+            .intensity = (curIntensity + nextIntensity) / 2,
+            .frequency = (curFrequency + nextFrequency) / 2,
+        });
+        curTime = nextTime;
+        curIntensity = nextIntensity;
+        curFrequency = nextFrequency;
+    }
+    return slices;
+}
+
+// Continuous events of the given duration, each with a curve of evenly spaced random points.
+std::vector<std::vector<VibrateCurvePoint>> MakeCurves(int32_t duration)
+{
+    std::mt19937 engine(0);
+    std::uniform_int_distribution<int32_t> value(0, VALUE_MAX);
+    std::vector<std::vector<VibrateCurvePoint>> curves(CURVE_NUM);
+    for (auto &curve : curves) {
+        for (int32_t i = 0; i < CURVE_POINT_NUM; ++i) {
+            curve.push_back({ .time = duration * i / (CURVE_POINT_NUM - 1), .intensity = value(engine),
+                .frequency = value(engine) });
+        }
+    }
+    return curves;
+}
+
+// Intensity and frequency pairs of a dense transient track.
+std::vector<std::pair<int32_t, int32_t>> MakeTransientTrack()
+{
+    std::mt19937 engine(0);
+    std::uniform_int_distribution<int32_t> value(0, VALUE_MAX);
+    std::vector<std::pair<int32_t, int32_t>> track(TRANSIENT_TRACK_SIZE);
+    for (auto &event : track) {
+        event = { value(engine), value(engine) };
+    }
+    return track;
+}
+}  // namespace
+
+static void TransientMatchSearch(benchmark::State &state)
+{
+    auto track = MakeTransientTrack();
+    for (auto _ : state) {
+        for (const auto &event : track) {
+            benchmark::DoNotOptimize(ReferenceTransientMatch(event.first, event.second));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * TRANSIENT_TRACK_SIZE);
+}
+BENCHMARK(TransientMatchSearch);
+
+static void TransientMatchTable(benchmark::State &state)
+{
+    CustomVibrationMatcher::InitTransientMatchTable();
+    auto track = MakeTransientTrack();
+    for (auto _ : state) {
+        for (const auto &event : track) {
+            benchmark::DoNotOptimize(CustomVibrationMatcher::MatchTransientEffect(event.first, event.second));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * TRANSIENT_TRACK_SIZE);
+}
+BENCHMARK(TransientMatchTable);
+
+static void SliceCurveScalar(benchmark::State &state)
+{
+    auto curves = MakeCurves(static_cast<int32_t>(state.range(0)));
+    for (auto _ : state) {
+        for (const auto &curve : curves) {
+            benchmark::DoNotOptimize(ReferenceSliceCurve(curve));
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * CURVE_NUM);
+}
+BENCHMARK(SliceCurveScalar)->Arg(500)->Arg(5000);
+
+static void SliceCurveBatch(benchmark::State &state)
+{
+    auto curves = MakeCurves(static_cast<int32_t>(state.range(0)));
+    std::vector<int32_t> lanes;
+    std::vector<VibrateSlice> slices;
+    for (auto _ : state) {
+        for (const auto &curve : curves) {
+            slices.clear();
+            CustomVibrationMatcher::SliceCurve(ArrayView<VibrateCurvePoint>(curve.data(), curve.size()), lanes,
+                slices);
+            benchmark::DoNotOptimize(slices.data());
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * CURVE_NUM);
+}
+BENCHMARK(SliceCurveBatch)->Arg(500)->Arg(5000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "file_utils.h"
+#include "mapped_file_view.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "FileReadBenchmarkTest"
+
+using namespace OHOS::Sensors;
+
+namespace {
+const std::string TEST_FILE_PATH = "/data/local/tmp/file_read_benchmark_test";
+constexpr int64_t READ_DATA_BUFF_SIZE = 256;
+constexpr size_t LINE_SIZE = 64;
+
+// The fdopen and fgets ReadFd of the baseline, kept verbatim as the reference. It closes the fd it is given.
+std::string ReferenceReadFd(const RawFileDescriptor &rawFd)
+{
+    if (rawFd.fd < 0) {
+        MISC_HILOGE("fd is invalid, fd:%{public}d", rawFd.fd);
+        return {};
+    }
+    int64_t fdSize = GetFileSize(rawFd.fd);
+    if ((rawFd.offset < 0) || (rawFd.offset > fdSize)) {
+        MISC_HILOGE("offset is invalid, offset:%{public}" PRId64, rawFd.offset);
+        return {};
+    }
+    if ((rawFd.length <= 0) || (rawFd.length > fdSize - rawFd.offset)) {
+        MISC_HILOGE("length is invalid, length:%{public}" PRId64, rawFd.length);
+        return {};
+    }
+    FILE *fp = fdopen(rawFd.fd, "r");
+    CHKPS(fp);
+    if (fseek(fp, rawFd.offset, SEEK_SET) != 0) {
+        MISC_HILOGE("fseek failed, errno:%{public}d", errno);
+        if (fclose(fp) != 0) {
+            MISC_HILOGW("Close file failed, errno:%{public}d", errno);
+        }
+        return {};
+    }
+    std::string dataStr;
+    char buf[READ_DATA_BUFF_SIZE] = { '\0' };
+    int64_t alreadyRead = 0;
+    while (alreadyRead < rawFd.length) {
+        int64_t onceRead = std::min(rawFd.length - alreadyRead, READ_DATA_BUFF_SIZE - 1);
+        fgets(buf, onceRead + 1, fp);
+        dataStr += buf;
+        alreadyRead = ftell(fp) - rawFd.offset;
+    }
+    if (fclose(fp) != 0) {
+        MISC_HILOGW("Close file failed after read, errno:%{public}d", errno);
+    }
+    return dataStr;
+}
+
+// Text of the given size in LINE_SIZE lines, the shape of a formatted vibration file.
+std::string MakeContent(size_t size)
+{
+    std::string content(size, 'a');
+    for (size_t i = LINE_SIZE - 1; i < size; i += LINE_SIZE) {
+        content[i] = '\n';
+    }
+    return content;
+}
+
+// Writes the test file and returns its fd, or -1 after marking the benchmark failed.
+int32_t CreateTestFile(benchmark::State &state, const std::string &content)
+{
+    int32_t fd = open(TEST_FILE_PATH.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    if ((fd < 0) || (write(fd, content.data(), content.size()) != static_cast<ssize_t>(content.size()))) {
+        state.SkipWithError("Write test file failed");
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+void RemoveTestFile(benchmark::State &state, int32_t fd, size_t size)
+{
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+    close(fd);
+    unlink(TEST_FILE_PATH.c_str());
+}
+
+// Every variant hands the data to the same consumer, so mapped pages are faulted in as well.
+size_t Consume(std::string_view data)
+{
+    return static_cast<size_t>(std::count(data.begin(), data.end(), '\n'));
+}
+}  // namespace
+
+static void ReadFdFgets(benchmark::State &state)
+{
+    size_t size = static_cast<size_t>(state.range(0));
+    int32_t fd = CreateTestFile(state, MakeContent(size));
+    if (fd < 0) {
+        return;
+    }
+    for (auto _ : state) {
+        // The reference closes the fd it reads, as the baseline did with the caller's fd.
+        RawFileDescriptor rawFd = { .fd = dup(fd), .offset = 0, .length = static_cast<int64_t>(size) };
+        std::string data = ReferenceReadFd(rawFd);
+        if (data.size() != size) {
+            state.SkipWithError("Read failed");
+            break;
+        }
+        benchmark::DoNotOptimize(Consume(data));
+    }
+    RemoveTestFile(state, fd, size);
+}
+BENCHMARK(ReadFdFgets)->RangeMultiplier(4)->Range(1 << 10, 1 << 20);
+
+static void ReadFdPread(benchmark::State &state)
+{
+    size_t size = static_cast<size_t>(state.range(0));
+    int32_t fd = CreateTestFile(state, MakeContent(size));
+    if (fd < 0) {
+        return;
+    }
+    RawFileDescriptor rawFd = { .fd = fd, .offset = 0, .length = static_cast<int64_t>(size) };
+    for (auto _ : state) {
+        std::string data = ReadFd(rawFd);
+        if (data.size() != size) {
+            state.SkipWithError("Read failed");
+            break;
+        }
+        benchmark::DoNotOptimize(Consume(data));
+    }
+    RemoveTestFile(state, fd, size);
+}
+BENCHMARK(ReadFdPread)->RangeMultiplier(4)->Range(1 << 10, 1 << 22);
+
+// The view the client decoders use for their own files; windows below 1 MiB are read with pread.
+static void MappedFileViewMap(benchmark::State &state)
+{
+    size_t size = static_cast<size_t>(state.range(0));
+    int32_t fd = CreateTestFile(state, MakeContent(size));
+    if (fd < 0) {
+        return;
+    }
+    RawFileDescriptor rawFd = { .fd = fd, .offset = 0, .length = static_cast<int64_t>(size) };
+    for (auto _ : state) {
+        MappedFileView view;
+        if ((view.Map(rawFd, true) != SUCCESS) || (view.GetData().size() != size)) {
+            state.SkipWithError("Map failed");
+            break;
+        }
+        benchmark::DoNotOptimize(Consume(view.GetData()));
+    }
+    RemoveTestFile(state, fd, size);
+}
+BENCHMARK(MappedFileViewMap)->RangeMultiplier(4)->Range(1 << 10, 1 << 22);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sensors_errors.h"
+#include "vibrator_infos.h"
+
+#undef LOG_TAG
+#define LOG_TAG "FlatVibratePackageBenchmarkTest"
+
+using namespace OHOS::Sensors;
+
+namespace {
+constexpr int32_t EVENT_INTERVAL = 100;
+constexpr int32_t EVENT_DURATION = 50;
+constexpr int32_t PATTERN_INTERVAL = 20000;
+constexpr int32_t CURVE_POINT_NUM = 4;
+size_t g_allocCount = 0;
+
+// Alternates transient and continuous events; every continuous event has a four point curve.
+VibratePackage MakePackage(int32_t patternNum, int32_t eventNum)
+{
+    VibratePackage package;
+    for (int32_t p = 0; p < patternNum; ++p) {
+        VibratePattern pattern;
+        pattern.startTime = p * PATTERN_INTERVAL;
+        for (int32_t i = 0; i < eventNum; ++i) {
+            VibrateEvent event;
+            event.time = i * EVENT_INTERVAL;
+            event.intensity = i % 100;
+            event.frequency = i % 100;
+            if (i % 2 == 0) {
+                event.tag = EVENT_TAG_TRANSIENT;
+                event.duration = EVENT_DURATION;
+                pattern.events.push_back(event);
+                continue;
+            }
+            event.tag = EVENT_TAG_CONTINUOUS;
+            event.duration = EVENT_DURATION;
+            for (int32_t j = 0; j < CURVE_POINT_NUM; ++j) {
+                event.points.push_back({ .time = j * EVENT_DURATION / (CURVE_POINT_NUM - 1), .intensity = 100,
+                    .frequency = 0 });
+            }
+            pattern.events.push_back(event);
+        }
+        pattern.patternDuration = eventNum * EVENT_INTERVAL;
+        package.patterns.push_back(pattern);
+    }
+    package.packageDuration = (patternNum - 1) * PATTERN_INTERVAL + eventNum * EVENT_INTERVAL;
+    return package;
+}
+
+// Runs copy once per iteration and reports the heap allocations it made as allocs per copy.
+template<typename Package>
+void CopyPackage(benchmark::State &state, const Package &package)
+{
+    size_t allocCount = 0;
+    for (auto _ : state) {
+        size_t before = g_allocCount;
+        Package copy = package;
+        allocCount += g_allocCount - before;
+        benchmark::DoNotOptimize(copy);
+    }
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocCount),
+        benchmark::Counter::kAvgIterations);
+}
+}  // namespace
+
+void *operator new(size_t size)
+{
+    ++g_allocCount;
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// The copy VibrateInfo, the playback plan and the matcher each made before the flat package.
+static void CopyNestedPackage(benchmark::State &state)
+{
+    CopyPackage(state, MakePackage(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1))));
+}
+BENCHMARK(CopyNestedPackage)->Args({ 1, 16 })->Args({ 1, 128 })->Args({ 8, 16 });
+
+static void CopyFlatPackage(benchmark::State &state)
+{
+    CopyPackage(state, FlatVibratePackage::Flatten(MakePackage(static_cast<int32_t>(state.range(0)),
+        static_cast<int32_t>(state.range(1)))));
+}
+BENCHMARK(CopyFlatPackage)->Args({ 1, 16 })->Args({ 1, 128 })->Args({ 8, 16 });
+
+// Paid once per decoded effect, when the service flattens the decoder's package.
+static void FlattenPackage(benchmark::State &state)
+{
+    VibratePackage package = MakePackage(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+    size_t allocCount = 0;
+    for (auto _ : state) {
+        size_t before = g_allocCount;
+        FlatVibratePackage flat = FlatVibratePackage::Flatten(package);
+        allocCount += g_allocCount - before;
+        benchmark::DoNotOptimize(flat);
+    }
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocCount),
+        benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(FlattenPackage)->Args({ 1, 16 })->Args({ 1, 128 })->Args({ 8, 16 });
+
+BENCHMARK_MAIN();
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "binary_haptic_format.h"
+#include "binary_vibrator_decoder.h"
+#include "default_vibrator_decoder.h"
+#include "default_vibrator_stream_decoder.h"
+#include "he_vibrator_decoder.h"
+#include "he_vibrator_stream_decoder.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HapticDecoderBenchmarkTest"
+
+using namespace OHOS::Sensors;
+
+namespace {
+const std::string TEST_FILE_PATH = "/data/local/tmp/haptic_decoder_benchmark_test";
+constexpr int32_t EVENT_INTERVAL = 100;
+constexpr int32_t EVENT_DURATION = 50;
+constexpr int32_t HE_PATTERN_EVENT_NUM = 16;
+constexpr int32_t HE_PATTERN_INTERVAL = 2000;
+
+// Alternates transient and continuous events; every continuous event has a four point curve.
+std::string MakeEvents(int32_t eventNum, const std::string &timeKey)
+{
+    std::string events;
+    for (int32_t i = 0; i < eventNum; ++i) {
+        if (i > 0) {
+            events += ",";
+        }
+        std::string time = std::to_string(i * EVENT_INTERVAL);
+        if (i % 2 == 0) {
+            events += R"({"Event":{"Type":"transient",")" + timeKey + R"(":)" + time +
+                R"(,"Parameters":{"Frequency":31,"Intensity":100}}})";
+            continue;
+        }
+        events += R"({"Event":{"Type":"continuous",")" + timeKey + R"(":)" + time + R"(,"Duration":)" +
+            std::to_string(EVENT_DURATION) + R"(,"Parameters":{"Frequency":30,"Intensity":38,"Curve":[)"
+            R"({"Time":0,"Frequency":0,"Intensity":0},{"Time":10,"Frequency":10,"Intensity":0.5},)"
+            R"({"Time":40,"Frequency":-10,"Intensity":1},{"Time":50,"Frequency":0,"Intensity":0}]}}})";
+    }
+    return events;
+}
+
+std::string MakeJsonFile(int32_t eventNum)
+{
+    return R"({"MetaData":{"Version":1.0,"ChannelNumber":1},"Channels":[{"Parameters":{"Index":0},"Pattern":[)" +
+        MakeEvents(eventNum, "StartTime") + "]}]}";
+}
+
+std::string MakeHeFile(int32_t patternNum)
+{
+    std::string patterns;
+    for (int32_t i = 0; i < patternNum; ++i) {
+        if (i > 0) {
+            patterns += ",";
+        }
+        patterns += R"({"AbsoluteTime":)" + std::to_string(i * HE_PATTERN_INTERVAL) + R"(,"Pattern":[)" +
+            MakeEvents(HE_PATTERN_EVENT_NUM, "RelativeTime") + "]}";
+    }
+    return R"({"Metadata":{"Version":2},"PatternList":[)" + patterns + "]}";
+}
+
+// The .ohb container haptic_converter writes for the same effect.
+std::string MakeBinaryFile(int32_t patternNum)
+{
+    HEVibratorStreamDecoder decoder;
+    VibratePackage pkg;
+    std::vector<uint8_t> buffer;
+    if ((decoder.DecodeBuffer(MakeHeFile(patternNum), pkg) != SUCCESS) ||
+        (EncodeBinaryHaptic(pkg, buffer) != SUCCESS)) {
+        return "";
+    }
+    return std::string(buffer.begin(), buffer.end());
+}
+
+template<typename Decoder>
+void DecodeFile(benchmark::State &state, const std::string &content)
+{
+    int32_t fd = open(TEST_FILE_PATH.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    if ((fd < 0) || (write(fd, content.data(), content.size()) != static_cast<ssize_t>(content.size()))) {
+        state.SkipWithError("Write test file failed");
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
+    }
+    RawFileDescriptor rawFd = { .fd = fd, .offset = 0, .length = static_cast<int64_t>(content.size()) };
+    for (auto _ : state) {
+        Decoder decoder;
+        VibratePackage pkg;
+        if (decoder.DecodeEffect(rawFd, pkg) != SUCCESS) {
+            state.SkipWithError("Decode failed");
+            break;
+        }
+        benchmark::DoNotOptimize(pkg);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(content.size()));
+    close(fd);
+    unlink(TEST_FILE_PATH.c_str());
+}
+}  // namespace
+
+// The cJSON based decoders, kept as the reference implementation.
+static void DecodeJsonReference(benchmark::State &state)
+{
+    DecodeFile<DefaultVibratorDecoder>(state, MakeJsonFile(static_cast<int32_t>(state.range(0))));
+}
+BENCHMARK(DecodeJsonReference)->Arg(16)->Arg(128);
+
+static void DecodeJsonStream(benchmark::State &state)
+{
+    DecodeFile<DefaultVibratorStreamDecoder>(state, MakeJsonFile(static_cast<int32_t>(state.range(0))));
+}
+BENCHMARK(DecodeJsonStream)->Arg(16)->Arg(128);
+
+static void DecodeHeReference(benchmark::State &state)
+{
+    DecodeFile<HEVibratorDecoder>(state, MakeHeFile(static_cast<int32_t>(state.range(0))));
+}
+BENCHMARK(DecodeHeReference)->Arg(1)->Arg(8);
+
+static void DecodeHeStream(benchmark::State &state)
+{
+    DecodeFile<HEVibratorStreamDecoder>(state, MakeHeFile(static_cast<int32_t>(state.range(0))));
+}
+BENCHMARK(DecodeHeStream)->Arg(1)->Arg(8);
+
+// Bytes per second are of the .ohb file, compare the time per iteration with the .he decoders.
+static void DecodeHeBinary(benchmark::State &state)
+{
+    DecodeFile<BinaryVibratorDecoder>(state, MakeBinaryFile(static_cast<int32_t>(state.range(0))));
+}
+BENCHMARK(DecodeHeBinary)->Arg(1)->Arg(8);
+
+BENCHMARK_MAIN();
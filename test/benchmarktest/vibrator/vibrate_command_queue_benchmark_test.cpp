@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "vibrate_command_queue.h"
+
+using namespace OHOS::Sensors;
+
+namespace {
+constexpr size_t COMMAND_QUEUE_CAPACITY = 16;
+
+// Lets the posting thread wait until the playback side has taken the request.
+class Handoff {
+public:
+    void Done()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++handled_;
+        }
+        cv_.notify_one();
+    }
+    void WaitFor(uint64_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this, count] { return handled_ >= count; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint64_t handled_ = 0;
+};
+
+// The old dispatch: every request stops and joins the previous playback thread and starts a new one.
+class ThreadPerRequestDispatcher {
+public:
+    ~ThreadPerRequestDispatcher()
+    {
+        StopVibrateThread();
+    }
+    void StartVibrateThread(std::shared_ptr<const VibrateInfo> info, Handoff &handoff)
+    {
+        StopVibrateThread();
+        thread_ = std::thread([info, &handoff] {
+            benchmark::DoNotOptimize(info->mode);
+            handoff.Done();
+        });
+    }
+
+private:
+    void StopVibrateThread()
+    {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    std::thread thread_;
+};
+
+// The dispatch of VibratorThread: post to the command queue of the persistent worker.
+class QueueDispatcher {
+public:
+    explicit QueueDispatcher(Handoff &handoff) : worker_([this, &handoff] { Run(handoff); }) {}
+    ~QueueDispatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            exitFlag_ = true;
+        }
+        cv_.notify_one();
+        worker_.join();
+    }
+    bool StartVibrate(std::shared_ptr<const VibrateInfo> info)
+    {
+        VibrateCommand command = {
+            .type = VibrateCommandType::PLAY,
+            .sequence = ++commandSequence_,
+            .info = std::move(info),
+        };
+        if (!commandQueue_.Push(std::move(command))) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+private:
+    void Run(Handoff &handoff)
+    {
+        while (true) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return exitFlag_.load() || !commandQueue_.Empty(); });
+            if (exitFlag_) {
+                return;
+            }
+            VibrateCommand command;
+            VibrateCommand next;
+            while (commandQueue_.Pop(next)) {
+                command = std::move(next);
+            }
+            lock.unlock();
+            benchmark::DoNotOptimize(command.info->mode);
+            handoff.Done();
+        }
+    }
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<bool> exitFlag_ = false;
+    std::atomic<uint64_t> commandSequence_ = 0;
+    MpscQueue<VibrateCommand, COMMAND_QUEUE_CAPACITY> commandQueue_;
+    std::thread worker_;
+};
+
+std::shared_ptr<const VibrateInfo> MakeInfo()
+{
+    VibrateInfo info;
+    info.mode = VibrateMode::TIME;
+    info.duration = 100;
+    return std::make_shared<const VibrateInfo>(info);
+}
+}  // namespace
+
+// Time from a binder thread accepting a vibration until the playback side holds it.
+static void DispatchThreadPerRequest(benchmark::State &state)
+{
+    std::shared_ptr<const VibrateInfo> info = MakeInfo();
+    Handoff handoff;
+    ThreadPerRequestDispatcher dispatcher;
+    uint64_t posted = 0;
+    for (auto _ : state) {
+        dispatcher.StartVibrateThread(info, handoff);
+        handoff.WaitFor(++posted);
+    }
+}
+BENCHMARK(DispatchThreadPerRequest)->UseRealTime();
+
+static void DispatchCommandQueue(benchmark::State &state)
+{
+    std::shared_ptr<const VibrateInfo> info = MakeInfo();
+    Handoff handoff;
+    QueueDispatcher dispatcher(handoff);
+    uint64_t posted = 0;
+    for (auto _ : state) {
+        if (!dispatcher.StartVibrate(info)) {
+            state.SkipWithError("Vibrate command queue is full");
+            break;
+        }
+        handoff.WaitFor(++posted);
+    }
+}
+BENCHMARK(DispatchCommandQueue)->UseRealTime();
+
+// Queue cost alone: one push and one pop of a play command on the same thread.
+static void CommandQueuePushPop(benchmark::State &state)
+{
+    std::shared_ptr<const VibrateInfo> info = MakeInfo();
+    MpscQueue<VibrateCommand, COMMAND_QUEUE_CAPACITY> queue;
+    VibrateCommand command;
+    for (auto _ : state) {
+        queue.Push(VibrateCommand { .type = VibrateCommandType::PLAY, .sequence = 1, .info = info });
+        queue.Pop(command);
+        benchmark::DoNotOptimize(command.sequence);
+    }
+}
+BENCHMARK(CommandQueuePushPop);
+
+BENCHMARK_MAIN();
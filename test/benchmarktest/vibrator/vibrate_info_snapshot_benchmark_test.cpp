@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "vibrator_infos.h"
+
+using namespace OHOS::Sensors;
+
+namespace {
+constexpr int32_t POINT_COUNT = 4;
+
+// VibrateInfo as it was when the current vibration was copied under a mutex.
+struct ReferenceVibrateInfo {
+    std::string mode;
+    std::string packageName;
+    int32_t pid = -1;
+    int32_t uid = -1;
+    int32_t usage = 0;
+    int32_t duration = 0;
+    std::string effect;
+    int32_t count = 0;
+    VibratePackage package;
+};
+
+// The read side of the old VibratorThread, kept verbatim as the reference.
+class ReferenceVibratorThread {
+public:
+    void UpdateVibratorEffect(const ReferenceVibrateInfo &info)
+    {
+        std::unique_lock<std::mutex> lck(currentVibrationMutex_);
+        currentVibration_ = info;
+    }
+    ReferenceVibrateInfo GetCurrentVibrateInfo()
+    {
+        std::unique_lock<std::mutex> lck(currentVibrationMutex_);
+        return currentVibration_;
+    }
+
+private:
+    std::mutex currentVibrationMutex_;
+    ReferenceVibrateInfo currentVibration_;
+};
+
+// The read side of VibratorThread: publish with atomic_store, read with atomic_load.
+class SnapshotVibratorThread {
+public:
+    void StartVibrate(const VibrateInfo &info)
+    {
+        std::atomic_store(&currentVibration_, std::make_shared<const VibrateInfo>(info));
+    }
+    std::shared_ptr<const VibrateInfo> GetCurrentVibrateInfo() const
+    {
+        return std::atomic_load(&currentVibration_);
+    }
+
+private:
+    std::shared_ptr<const VibrateInfo> currentVibration_ = std::make_shared<const VibrateInfo>();
+};
+
+VibratePackage MakePackage(int32_t eventCount)
+{
+    VibratePattern pattern;
+    for (int32_t i = 0; i < eventCount; ++i) {
+        VibrateEvent event;
+        event.tag = EVENT_TAG_CONTINUOUS;
+        event.time = i * 100;
+        event.duration = 80;
+        event.intensity = 50;
+        event.frequency = 30;
+        for (int32_t j = 0; j < POINT_COUNT; ++j) {
+            event.points.push_back({ j * 20, 50 + j, j });
+        }
+        pattern.events.push_back(event);
+    }
+    VibratePackage package;
+    package.patterns.push_back(pattern);
+    return package;
+}
+
+ReferenceVibrateInfo MakeReferenceInfo(int32_t eventCount)
+{
+    ReferenceVibrateInfo info;
+    info.mode = VIBRATE_CUSTOM_HD;
+    info.packageName = "com.example.benchmark";
+    info.pid = 1;
+    info.uid = 1;
+    info.usage = USAGE_TOUCH;
+    info.package = MakePackage(eventCount);
+    return info;
+}
+
+VibrateInfo MakeInfo(int32_t eventCount)
+{
+    VibrateInfo info;
+    info.mode = VibrateMode::CUSTOM_HD;
+    info.packageName = InternedString::Intern("com.example.benchmark");
+    info.pid = 1;
+    info.uid = 1;
+    info.usage = USAGE_TOUCH;
+    info.package = std::make_shared<const FlatVibratePackage>(FlatVibratePackage::Flatten(MakePackage(eventCount)));
+    return info;
+}
+
+ReferenceVibratorThread g_referenceThread;
+SnapshotVibratorThread g_snapshotThread;
+}  // namespace
+
+/*
+ * Admission reads the current vibration once per request (priority check, StopVibrator(mode),
+ * death observer). Args: events in the current custom vibration; Threads: concurrent readers.
+ */
+static void GetCurrentVibrateInfoMutexCopy(benchmark::State &state)
+{
+    if (state.thread_index() == 0) {
+        g_referenceThread.UpdateVibratorEffect(MakeReferenceInfo(static_cast<int32_t>(state.range(0))));
+    }
+    for (auto _ : state) {
+        ReferenceVibrateInfo info = g_referenceThread.GetCurrentVibrateInfo();
+        benchmark::DoNotOptimize(info.usage);
+    }
+}
+BENCHMARK(GetCurrentVibrateInfoMutexCopy)->Arg(1)->Arg(16)->Arg(128)->ThreadRange(1, 4)->UseRealTime();
+
+static void GetCurrentVibrateInfoSnapshot(benchmark::State &state)
+{
+    if (state.thread_index() == 0) {
+        g_snapshotThread.StartVibrate(MakeInfo(static_cast<int32_t>(state.range(0))));
+    }
+    for (auto _ : state) {
+        std::shared_ptr<const VibrateInfo> info = g_snapshotThread.GetCurrentVibrateInfo();
+        benchmark::DoNotOptimize(info->usage);
+    }
+}
+BENCHMARK(GetCurrentVibrateInfoSnapshot)->Arg(1)->Arg(16)->Arg(128)->ThreadRange(1, 4)->UseRealTime();
+
+BENCHMARK_MAIN();
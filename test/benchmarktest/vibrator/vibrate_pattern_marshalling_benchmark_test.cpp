@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "message_parcel.h"
+
+#include "sensors_errors.h"
+#include "vibrator_infos.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratePatternMarshallingBenchmarkTest"
+
+using namespace OHOS;
+using namespace OHOS::Sensors;
+
+namespace {
+constexpr int32_t POINT_COUNT = 4;
+
+/*
+ * The per-field VibratePattern::Marshalling and Unmarshalling the packed format replaced, kept
+ * verbatim as the reference except that the event limit is the wire limit, so that both run
+ * at every size.
+ */
+bool ReferenceMarshalling(const VibratePattern &pattern, Parcel &parcel)
+{
+    const auto &events = pattern.events;
+    if (!parcel.WriteInt32(pattern.startTime)) {
+        MISC_HILOGE("Write pattern's startTime failed");
+        return false;
+    }
+    if (!parcel.WriteInt32(pattern.patternDuration)) {
+        MISC_HILOGE("Write patternDuration failed");
+        return false;
+    }
+    if (!parcel.WriteInt32(static_cast<int32_t>(events.size()))) {
+        MISC_HILOGE("Write events's size failed");
+        return false;
+    }
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (!parcel.WriteInt32(static_cast<int32_t>(events[i].tag))) {
+            MISC_HILOGE("Write tag failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(events[i].time)) {
+            MISC_HILOGE("Write events's time failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(events[i].duration)) {
+            MISC_HILOGE("Write duration failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(events[i].intensity)) {
+            MISC_HILOGE("Write intensity failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(events[i].frequency)) {
+            MISC_HILOGE("Write frequency failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(events[i].index)) {
+            MISC_HILOGE("Write index failed");
+            return false;
+        }
+        if (!parcel.WriteInt32(static_cast<int32_t>(events[i].points.size()))) {
+            MISC_HILOGE("Write points's size failed");
+            return false;
+        }
+        for (size_t j = 0; j < events[i].points.size(); ++j) {
+            if (!parcel.WriteInt32(events[i].points[j].time)) {
+                MISC_HILOGE("Write points's time failed");
+                return false;
+            }
+            if (!parcel.WriteInt32(events[i].points[j].intensity)) {
+                MISC_HILOGE("Write points's intensity failed");
+                return false;
+            }
+            if (!parcel.WriteInt32(events[i].points[j].frequency)) {
+                MISC_HILOGE("Write points's frequency failed");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::optional<VibratePattern> ReferenceUnmarshalling(Parcel &data)
+{
+    VibratePattern pattern;
+    if (!(data.ReadInt32(pattern.startTime))) {
+        MISC_HILOGE("Read time failed");
+        return std::nullopt;
+    }
+    if (!(data.ReadInt32(pattern.patternDuration))) {
+        MISC_HILOGE("Read duration failed");
+        return std::nullopt;
+    }
+    int32_t eventSize { 0 };
+    if (!(data.ReadInt32(eventSize))) {
+        MISC_HILOGE("Read eventSize failed");
+        return std::nullopt;
+    }
+    if (eventSize > MAX_PATTERN_WIRE_EVENT_SIZE) {
+        MISC_HILOGE("eventSize exceed the maximum");
+        return std::nullopt;
+    }
+    for (int32_t i = 0; i < eventSize; ++i) {
+        VibrateEvent event;
+        int32_t tag { -1 };
+        if (!data.ReadInt32(tag)) {
+            MISC_HILOGE("Read type failed");
+            return std::nullopt;
+        }
+        event.tag = static_cast<VibrateTag>(tag);
+        if (!data.ReadInt32(event.time)) {
+            MISC_HILOGE("Read events's time failed");
+            return std::nullopt;
+        }
+        if (!data.ReadInt32(event.duration)) {
+            MISC_HILOGE("Read duration failed");
+            return std::nullopt;
+        }
+        if (!data.ReadInt32(event.intensity)) {
+            MISC_HILOGE("Read intensity failed");
+            return std::nullopt;
+        }
+        if (!data.ReadInt32(event.frequency)) {
+            MISC_HILOGE("Read frequency failed");
+            return std::nullopt;
+        }
+        if (!data.ReadInt32(event.index)) {
+            MISC_HILOGE("Read index failed");
+            return std::nullopt;
+        }
+        int32_t pointSize { 0 };
+        if (!data.ReadInt32(pointSize)) {
+            MISC_HILOGE("Read pointSize failed");
+            return std::nullopt;
+        }
+        if (pointSize > MAX_POINT_SIZE) {
+            MISC_HILOGE("pointSize exceed the maximum");
+            return std::nullopt;
+        }
+        pattern.events.emplace_back(event);
+        for (int32_t j = 0; j < pointSize; ++j) {
+            VibrateCurvePoint point;
+            if (!data.ReadInt32(point.time)) {
+                MISC_HILOGE("Read points's time failed");
+                return std::nullopt;
+            }
+            if (!data.ReadInt32(point.intensity)) {
+                MISC_HILOGE("Read points's intensity failed");
+                return std::nullopt;
+            }
+            if (!data.ReadInt32(point.frequency)) {
+                MISC_HILOGE("Read points's frequency failed");
+                return std::nullopt;
+            }
+            pattern.events[i].points.emplace_back(point);
+        }
+    }
+    return pattern;
+}
+
+VibratePattern MakePattern(int32_t eventCount)
+{
+    VibratePattern pattern;
+    for (int32_t i = 0; i < eventCount; ++i) {
+        VibrateEvent event;
+        event.tag = EVENT_TAG_CONTINUOUS;
+        event.time = i * 100;
+        event.duration = 80;
+        event.intensity = 50;
+        event.frequency = 30;
+        event.index = i;
+        for (int32_t j = 0; j < POINT_COUNT; ++j) {
+            event.points.push_back({ j * 20, 50 + j, j });
+        }
+        pattern.events.push_back(event);
+    }
+    return pattern;
+}
+}  // namespace
+
+// Proxy write and stub read of one PlayPattern request. Args: events in the pattern.
+static void PatternMarshallingPerField(benchmark::State &state)
+{
+    VibratePattern pattern = MakePattern(static_cast<int32_t>(state.range(0)));
+    for (auto _ : state) {
+        MessageParcel data;
+        if (!ReferenceMarshalling(pattern, data)) {
+            state.SkipWithError("Marshalling failed");
+            break;
+        }
+        auto decoded = ReferenceUnmarshalling(data);
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+BENCHMARK(PatternMarshallingPerField)->RangeMultiplier(4)->Range(16, MAX_PATTERN_WIRE_EVENT_SIZE);
+
+static void PatternMarshallingPacked(benchmark::State &state)
+{
+    VibratePattern pattern = MakePattern(static_cast<int32_t>(state.range(0)));
+    for (auto _ : state) {
+        MessageParcel data;
+        std::vector<uint8_t> buffer;
+        if ((!pattern.Encode(buffer)) || (!data.WriteUint32(static_cast<uint32_t>(buffer.size()))) ||
+            (!data.WriteRawData(buffer.data(), buffer.size()))) {
+            state.SkipWithError("Encode failed");
+            break;
+        }
+        uint32_t size = 0;
+        data.ReadUint32(size);
+        const uint8_t *raw = static_cast<const uint8_t *>(data.ReadRawData(size));
+        VibratePattern decoder;
+        auto decoded = decoder.Decode(raw, size);
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+BENCHMARK(PatternMarshallingPacked)->RangeMultiplier(4)->Range(16, MAX_PATTERN_WIRE_EVENT_SIZE);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "sensors_errors.h"
+#include "vibrator_agent.h"
+#include "vibrator_infos.h"
+#include "vibrator_service_client.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorPackageConvertBenchmarkTest"
+
+using namespace OHOS::Sensors;
+
+namespace {
+constexpr int32_t EVENT_INTERVAL = 100;
+constexpr int32_t EVENT_DURATION = 50;
+constexpr int32_t PATTERN_INTERVAL = 20000;
+constexpr int32_t CURVE_POINT_NUM = 4;
+size_t g_mallocCount = 0;
+
+// The per-array ConvertVibratePackage of the baseline, kept verbatim as the reference.
+int32_t ReferenceConvertVibratePackage(const VibratePackage& inPkg,
+    VibratorPackage &outPkg)
+{
+    inPkg.Dump();
+    int32_t patternSize = static_cast<int32_t>(inPkg.patterns.size());
+    VibratorPattern *patterns = (VibratorPattern *)malloc(sizeof(VibratorPattern) * patternSize);
+    CHKPR(patterns, ERROR);
+    outPkg.patternNum = patternSize;
+    int32_t clientPatternDuration = 0;
+    for (int32_t i = 0; i < patternSize; ++i) {
+        patterns[i].time = inPkg.patterns[i].startTime;
+        auto vibrateEvents = inPkg.patterns[i].events;
+        int32_t eventSize = static_cast<int32_t>(vibrateEvents.size());
+        patterns[i].eventNum = eventSize;
+        VibratorEvent *events = (VibratorEvent *)malloc(sizeof(VibratorEvent) * eventSize);
+        if (events == nullptr) {
+            free(patterns);
+            patterns = nullptr;
+            return ERROR;
+        }
+        for (int32_t j = 0; j < eventSize; ++j) {
+            events[j].type = static_cast<VibratorEventType >(vibrateEvents[j].tag);
+            events[j].time = vibrateEvents[j].time;
+            events[j].duration = vibrateEvents[j].duration;
+            events[j].intensity = vibrateEvents[j].intensity;
+            events[j].frequency = vibrateEvents[j].frequency;
+            events[j].index = vibrateEvents[j].index;
+            auto vibratePoints = vibrateEvents[j].points;
+            events[j].pointNum = static_cast<int32_t>(vibratePoints.size());
+            VibratorCurvePoint *points = (VibratorCurvePoint *)malloc(sizeof(VibratorCurvePoint) * events[j].pointNum);
+            if (points == nullptr) {
+                free(patterns);
+                patterns = nullptr;
+                free(events);
+                events = nullptr;
+                return ERROR;
+            }
+            for (int32_t k = 0; k < events[j].pointNum; ++k) {
+                points[k].time = vibratePoints[k].time;
+                points[k].intensity  = vibratePoints[k].intensity;
+                points[k].frequency  = vibratePoints[k].frequency;
+            }
+            events[j].points = points;
+            clientPatternDuration += events[j].duration;
+        }
+        patterns[i].events = events;
+        patterns[i].patternDuration = clientPatternDuration;
+    }
+    outPkg.patterns = patterns;
+    outPkg.packageDuration = inPkg.packageDuration;
+    return ERR_OK;
+}
+
+int32_t ReferenceFreeVibratorPackage(VibratorPackage &package)
+{
+    int32_t patternSize = package.patternNum;
+    if ((patternSize <= 0) || (package.patterns == nullptr)) {
+        MISC_HILOGW("Patterns is not need to free, pattern size:%{public}d", patternSize);
+        return ERROR;
+    }
+    auto patterns = package.patterns;
+    for (int32_t i = 0; i < patternSize; ++i) {
+        int32_t eventNum = patterns[i].eventNum;
+        if ((eventNum <= 0) || (patterns[i].events == nullptr)) {
+            MISC_HILOGW("Events is not need to free, event size:%{public}d", eventNum);
+            continue;
+        }
+        auto events = patterns[i].events;
+        for (int32_t j = 0; j < eventNum; ++j) {
+            if (events[j].points != nullptr) {
+                free(events[j].points);
+                events[j].points = nullptr;
+            }
+        }
+        free(events);
+        events = nullptr;
+    }
+    free(patterns);
+    patterns = nullptr;
+    return ERR_OK;
+}
+
+// Alternates transient and continuous events; every continuous event has a four point curve.
+VibratePackage MakePackage(int32_t patternNum, int32_t eventNum)
+{
+    VibratePackage package;
+    for (int32_t p = 0; p < patternNum; ++p) {
+        VibratePattern pattern;
+        pattern.startTime = p * PATTERN_INTERVAL;
+        for (int32_t i = 0; i < eventNum; ++i) {
+            VibrateEvent event;
+            event.time = i * EVENT_INTERVAL;
+            event.duration = EVENT_DURATION;
+            event.intensity = i % 100;
+            event.frequency = i % 100;
+            event.tag = (i % 2 == 0) ? EVENT_TAG_TRANSIENT : EVENT_TAG_CONTINUOUS;
+            for (int32_t j = 0; (event.tag == EVENT_TAG_CONTINUOUS) && (j < CURVE_POINT_NUM); ++j) {
+                event.points.push_back({ .time = j * EVENT_DURATION / (CURVE_POINT_NUM - 1), .intensity = 100,
+                    .frequency = 0 });
+            }
+            pattern.events.push_back(event);
+        }
+        pattern.patternDuration = eventNum * EVENT_INTERVAL;
+        package.patterns.push_back(pattern);
+    }
+    package.packageDuration = (patternNum - 1) * PATTERN_INTERVAL + eventNum * EVENT_INTERVAL;
+    return package;
+}
+
+// Converts and frees the package once per iteration; with glibc also reports the mallocs per conversion.
+template<typename Convert, typename Free>
+void ConvertPackage(benchmark::State &state, Convert convert, Free release)
+{
+    VibratePackage package = MakePackage(static_cast<int32_t>(state.range(0)), static_cast<int32_t>(state.range(1)));
+    size_t mallocCount = 0;
+    for (auto _ : state) {
+        size_t before = g_mallocCount;
+        VibratorPackage outPkg = {};
+        if (convert(package, outPkg) != ERR_OK) {
+            state.SkipWithError("Convert failed");
+            break;
+        }
+        mallocCount += g_mallocCount - before;
+        benchmark::DoNotOptimize(outPkg.patterns);
+        release(outPkg);
+    }
+#if defined(__GLIBC__)
+    state.counters["mallocs"] = benchmark::Counter(static_cast<double>(mallocCount),
+        benchmark::Counter::kAvgIterations);
+#endif
+}
+}  // namespace
+
+#if defined(__GLIBC__)
+// glibc exports its allocator under these names, so the benchmark can count malloc calls in place.
+extern "C" void *__libc_malloc(size_t size);
+
+extern "C" void *malloc(size_t size)
+{
+    ++g_mallocCount;
+    return __libc_malloc(size);
+}
+#endif
+
+// The vectors the reference copies by value allocate as well; the count includes them.
+static void ConvertPerArray(benchmark::State &state)
+{
+    ConvertPackage(state, ReferenceConvertVibratePackage, ReferenceFreeVibratorPackage);
+}
+BENCHMARK(ConvertPerArray)->Args({ 1, 16 })->Args({ 1, 128 })->Args({ 8, 16 });
+
+static void ConvertSingleBlock(benchmark::State &state)
+{
+    ConvertPackage(state, VibratorServiceClient::ConvertVibratePackage,
+        [](VibratorPackage &package) { return FreeVibratorPackage(package); });
+}
+BENCHMARK(ConvertSingleBlock)->Args({ 1, 16 })->Args({ 1, 128 })->Args({ 8, 16 });
+
+BENCHMARK_MAIN();
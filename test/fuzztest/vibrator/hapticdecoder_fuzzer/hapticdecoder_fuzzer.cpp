@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hapticdecoder_fuzzer.h"
+
+#include <memory>
+#include <string_view>
+
+#include "binary_vibrator_decoder.h"
+#include "default_vibrator_stream_decoder.h"
+#include "he_vibrator_stream_decoder.h"
+#include "vibrator_decoder_creator.h"
+#include "vibrator_decoder_registry.h"
+
+namespace OHOS {
+namespace Sensors {
+void HapticDecoderFuzzTest(const uint8_t *data, size_t size)
+{
+    if (data == nullptr) {
+        return;
+    }
+    std::string_view content(reinterpret_cast<const char *>(data), size);
+    VibratePackage pkg;
+    DefaultVibratorStreamDecoder jsonDecoder;
+    jsonDecoder.DecodeBuffer(content, pkg);
+    HEVibratorStreamDecoder heDecoder;
+    heDecoder.DecodeBuffer(content, pkg);
+    BinaryVibratorDecoder binaryDecoder;
+    binaryDecoder.DecodeBuffer(content, pkg);
+    VibratorDecoderCreator::RegisterDecoders();
+    std::unique_ptr<IVibratorDecoder> decoder(VibratorDecoderRegistry::GetInstance().CreateDecoder(content));
+}
+} // namespace Sensors
+} // namespace OHOS
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    OHOS::Sensors::HapticDecoderFuzzTest(data, size);
+    return 0;
+}
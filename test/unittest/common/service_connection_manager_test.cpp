@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "service_connection_manager.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "ServiceConnectionManagerTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t REQUEST_COUNT = 4;
+}  // namespace
+
+class FakeConnectionManager : public ServiceConnectionManager {
+public:
+    FakeConnectionManager() = default;
+    ~FakeConnectionManager() override = default;
+    std::atomic_bool available = false;
+
+protected:
+    int32_t SubscribeLocked() override
+    {
+        return ERR_OK;
+    }
+
+    sptr<IRemoteObject> CheckService() override
+    {
+        if (!available.load()) {
+            return nullptr;
+        }
+        return ServiceConnectionManager::CheckService();
+    }
+};
+
+class RecordingListener : public IServiceConnectionListener {
+public:
+    explicit RecordingListener(std::vector<int32_t> &events) : events_(events) {}
+    ~RecordingListener() override = default;
+    void OnServiceConnected(const sptr<IMiscdeviceService> &proxy) override
+    {
+        events_.push_back(CONNECTED);
+    }
+    void OnServiceDisconnected() override
+    {
+        events_.push_back(DISCONNECTED);
+    }
+    static constexpr int32_t CONNECTED = -1;
+    static constexpr int32_t DISCONNECTED = -2;
+
+private:
+    std::vector<int32_t> &events_;
+};
+
+class ServiceConnectionManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: ServiceConnectionManagerTest_001
+ * @tc.desc: Connect to the miscdevice service and get its proxy
+ * @tc.type: FUNC
+ */
+HWTEST_F(ServiceConnectionManagerTest, ServiceConnectionManagerTest_001, TestSize.Level1)
+{
+    FakeConnectionManager manager;
+    manager.available = true;
+    ASSERT_EQ(manager.Connect(), ERR_OK);
+    ASSERT_NE(manager.GetProxy(), nullptr);
+    int32_t ret = manager.PostRequest([](const sptr<IMiscdeviceService> &proxy) {
+        return (proxy == nullptr) ? ERROR : ERR_OK;
+    });
+    ASSERT_EQ(ret, ERR_OK);
+}
+
+/**
+ * @tc.name: ServiceConnectionManagerTest_002
+ * @tc.desc: A request posted while the service is down is deferred, or dropped under the DROP policy
+ * @tc.type: FUNC
+ */
+HWTEST_F(ServiceConnectionManagerTest, ServiceConnectionManagerTest_002, TestSize.Level1)
+{
+    FakeConnectionManager manager;
+    ASSERT_EQ(manager.Connect(), MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+    ASSERT_EQ(manager.GetProxy(), nullptr);
+    int32_t ret = manager.PostRequest([](const sptr<IMiscdeviceService> &proxy) {
+        return ERR_OK;
+    });
+    ASSERT_EQ(ret, MISC_NATIVE_REQUEST_DEFERRED);
+    manager.SetPendingRequestPolicy(PendingRequestPolicy::DROP);
+    ret = manager.PostRequest([](const sptr<IMiscdeviceService> &proxy) {
+        return ERR_OK;
+    });
+    ASSERT_EQ(ret, MISC_NATIVE_SERVICE_UNAVAILABLE_ERR);
+}
+
+/**
+ * @tc.name: ServiceConnectionManagerTest_003
+ * @tc.desc: Queued requests are replayed in order before listeners are told about the connection
+ * @tc.type: FUNC
+ */
+HWTEST_F(ServiceConnectionManagerTest, ServiceConnectionManagerTest_003, TestSize.Level1)
+{
+    FakeConnectionManager manager;
+    std::vector<int32_t> events;
+    RecordingListener listener(events);
+    manager.AddListener(&listener);
+    for (int32_t i = 0; i < REQUEST_COUNT; ++i) {
+        int32_t ret = manager.PostRequest([i, &events](const sptr<IMiscdeviceService> &proxy) {
+            events.push_back(i);
+            return ERR_OK;
+        });
+        ASSERT_EQ(ret, MISC_NATIVE_REQUEST_DEFERRED);
+    }
+    ASSERT_TRUE(events.empty());
+    manager.available = true;
+    ASSERT_EQ(manager.Connect(), ERR_OK);
+    std::vector<int32_t> expected = { 0, 1, 2, 3, RecordingListener::CONNECTED };
+    ASSERT_EQ(events, expected);
+    manager.RemoveListener(&listener);
+}
+
+/**
+ * @tc.name: ServiceConnectionManagerTest_004
+ * @tc.desc: Queued requests older than the timeout are dropped on reconnect
+ * @tc.type: FUNC
+ */
+HWTEST_F(ServiceConnectionManagerTest, ServiceConnectionManagerTest_004, TestSize.Level1)
+{
+    FakeConnectionManager manager;
+    int32_t replayed = 0;
+    int32_t ret = manager.PostRequest([&replayed](const sptr<IMiscdeviceService> &proxy) {
+        ++replayed;
+        return ERR_OK;
+    });
+    ASSERT_EQ(ret, MISC_NATIVE_REQUEST_DEFERRED);
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(ServiceConnectionManager::PENDING_REQUEST_TIMEOUT_MS + 100));
+    manager.available = true;
+    ASSERT_EQ(manager.Connect(), ERR_OK);
+    ASSERT_EQ(replayed, 0);
+}
+
+/**
+ * @tc.name: ServiceConnectionManagerTest_005
+ * @tc.desc: Only the newest MAX_PENDING_REQUEST_COUNT requests are kept while the service is down
+ * @tc.type: FUNC
+ */
+HWTEST_F(ServiceConnectionManagerTest, ServiceConnectionManagerTest_005, TestSize.Level1)
+{
+    FakeConnectionManager manager;
+    int32_t total = static_cast<int32_t>(ServiceConnectionManager::MAX_PENDING_REQUEST_COUNT) + REQUEST_COUNT;
+    std::vector<int32_t> replayed;
+    for (int32_t i = 0; i < total; ++i) {
+        manager.PostRequest([i, &replayed](const sptr<IMiscdeviceService> &proxy) {
+            replayed.push_back(i);
+            return ERR_OK;
+        });
+    }
+    manager.available = true;
+    ASSERT_EQ(manager.Connect(), ERR_OK);
+    ASSERT_EQ(replayed.size(), ServiceConnectionManager::MAX_PENDING_REQUEST_COUNT);
+    ASSERT_EQ(replayed.front(), REQUEST_COUNT);
+    ASSERT_EQ(replayed.back(), total - 1);
+}
+
+/**
+ * @tc.name: ServiceConnectionManagerTest_006
+ * @tc.desc: Service death clears the proxy and notifies listeners
+ * @tc.type: FUNC
+ */
+HWTEST_F(ServiceConnectionManagerTest, ServiceConnectionManagerTest_006, TestSize.Level1)
+{
+    FakeConnectionManager manager;
+    std::vector<int32_t> events;
+    RecordingListener listener(events);
+    manager.AddListener(&listener);
+    manager.available = true;
+    ASSERT_EQ(manager.Connect(), ERR_OK);
+    sptr<IMiscdeviceService> proxy = manager.GetProxy();
+    ASSERT_NE(proxy, nullptr);
+    manager.available = false;
+    manager.ProcessDeathObserver(proxy->AsObject());
+    ASSERT_EQ(manager.GetProxy(), nullptr);
+    std::vector<int32_t> expected = { RecordingListener::CONNECTED, RecordingListener::DISCONNECTED };
+    ASSERT_EQ(events, expected);
+    int32_t ret = manager.PostRequest([](const sptr<IMiscdeviceService> &proxy) {
+        return ERR_OK;
+    });
+    ASSERT_EQ(ret, MISC_NATIVE_REQUEST_DEFERRED);
+    manager.RemoveListener(&listener);
+}
+}  // namespace Sensors
+}  // namespace OHOS
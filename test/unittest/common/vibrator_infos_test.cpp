@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "message_parcel.h"
+
+#include "sensors_errors.h"
+#include "vibrator_infos.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorInfosTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr size_t RAW_DATA_INLINE_SIZE = 32 * 1024;
+constexpr int32_t EVENT_INTERVAL = 10;
+constexpr int32_t SPLIT_EVENT_COUNT = 40;
+
+VibratePattern MakePattern(int32_t eventCount, int32_t pointCount)
+{
+    VibratePattern pattern;
+    for (int32_t i = 0; i < eventCount; ++i) {
+        VibrateEvent event;
+        event.tag = (i % 2 == 0) ? EVENT_TAG_CONTINUOUS : EVENT_TAG_TRANSIENT;
+        event.time = i * EVENT_INTERVAL;
+        event.duration = EVENT_INTERVAL;
+        event.intensity = i % 100;
+        event.frequency = i % 100;
+        event.index = i;
+        for (int32_t j = 0; j < pointCount; ++j) {
+            event.points.push_back({ j, j % 100, j % 100 });
+        }
+        pattern.events.push_back(event);
+    }
+    return pattern;
+}
+
+void ExpectSamePattern(const VibratePattern &lhs, const VibratePattern &rhs)
+{
+    ASSERT_EQ(lhs.startTime, rhs.startTime);
+    ASSERT_EQ(lhs.patternDuration, rhs.patternDuration);
+    ASSERT_EQ(lhs.events.size(), rhs.events.size());
+    for (size_t i = 0; i < lhs.events.size(); ++i) {
+        const VibrateEvent &left = lhs.events[i];
+        const VibrateEvent &right = rhs.events[i];
+        ASSERT_EQ(left.tag, right.tag);
+        ASSERT_EQ(left.time, right.time);
+        ASSERT_EQ(left.duration, right.duration);
+        ASSERT_EQ(left.intensity, right.intensity);
+        ASSERT_EQ(left.frequency, right.frequency);
+        ASSERT_EQ(left.index, right.index);
+        ASSERT_EQ(left.points.size(), right.points.size());
+        for (size_t j = 0; j < left.points.size(); ++j) {
+            ASSERT_EQ(left.points[j].time, right.points[j].time);
+            ASSERT_EQ(left.points[j].intensity, right.points[j].intensity);
+            ASSERT_EQ(left.points[j].frequency, right.points[j].frequency);
+        }
+    }
+}
+}  // namespace
+
+class VibratorInfosTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: VibratorInfosTest_001
+ * @tc.desc: A pattern at the wire limit encodes to MAX_PATTERN_WIRE_SIZE and decodes unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorInfosTest, VibratorInfosTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorInfosTest_001 in");
+    VibratePattern pattern = MakePattern(MAX_PATTERN_WIRE_EVENT_SIZE, MAX_POINT_SIZE);
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pattern.Encode(buffer));
+    ASSERT_EQ(buffer.size(), MAX_PATTERN_WIRE_SIZE);
+    VibratePattern decoder;
+    auto decoded = decoder.Decode(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoded.has_value());
+    ExpectSamePattern(pattern, decoded.value());
+}
+
+/**
+ * @tc.name: VibratorInfosTest_002
+ * @tc.desc: A pattern over the inline raw data size round-trips through MessageParcel raw data
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorInfosTest, VibratorInfosTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorInfosTest_002 in");
+    VibratePattern pattern = MakePattern(MAX_PATTERN_WIRE_EVENT_SIZE / 2, MAX_POINT_SIZE);
+    std::vector<uint8_t> buffer;
+    ASSERT_TRUE(pattern.Encode(buffer));
+    ASSERT_GT(buffer.size(), RAW_DATA_INLINE_SIZE);
+    MessageParcel data;
+    ASSERT_TRUE(data.WriteUint32(static_cast<uint32_t>(buffer.size())));
+    ASSERT_TRUE(data.WriteRawData(buffer.data(), buffer.size()));
+    uint32_t size = 0;
+    ASSERT_TRUE(data.ReadUint32(size));
+    ASSERT_EQ(size, buffer.size());
+    const uint8_t *raw = static_cast<const uint8_t *>(data.ReadRawData(size));
+    ASSERT_NE(raw, nullptr);
+    ASSERT_EQ(memcmp(raw, buffer.data(), size), 0);
+    VibratePattern decoder;
+    auto decoded = decoder.Decode(raw, size);
+    ASSERT_TRUE(decoded.has_value());
+    ExpectSamePattern(pattern, decoded.value());
+}
+
+/**
+ * @tc.name: VibratorInfosTest_003
+ * @tc.desc: Patterns over the wire limit are rejected on both sides
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorInfosTest, VibratorInfosTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorInfosTest_003 in");
+    std::vector<uint8_t> buffer;
+    ASSERT_FALSE(MakePattern(MAX_PATTERN_WIRE_EVENT_SIZE + 1, 0).Encode(buffer));
+    ASSERT_TRUE(MakePattern(1, 0).Encode(buffer));
+    PatternWireHeader header;
+    memcpy(&header, buffer.data(), sizeof(header));
+    header.eventCount = MAX_PATTERN_WIRE_EVENT_SIZE + 1;
+    memcpy(buffer.data(), &header, sizeof(header));
+    buffer.resize(sizeof(PatternWireHeader) + header.eventCount * sizeof(EventWireRecord));
+    VibratePattern decoder;
+    ASSERT_FALSE(decoder.Decode(buffer.data(), buffer.size()).has_value());
+}
+
+/**
+ * @tc.name: VibratorInfosTest_004
+ * @tc.desc: A pattern within the HDI limit stays one pattern that starts at 0
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorInfosTest, VibratorInfosTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorInfosTest_004 in");
+    VibratePattern pattern = MakePattern(MAX_EVENT_SIZE, MAX_POINT_SIZE);
+    pattern.startTime = EVENT_INTERVAL;
+    pattern.patternDuration = EVENT_INTERVAL;
+    FlatVibratePackage package = FlatVibratePackage::Flatten(pattern, MAX_EVENT_SIZE);
+    ASSERT_EQ(package.patterns.size(), 1);
+    ASSERT_EQ(package.patterns.front().startTime, 0);
+    ASSERT_EQ(package.patterns.front().patternDuration, 0);
+    auto events = package.GetEvents(package.patterns.front());
+    ASSERT_EQ(events.size(), pattern.events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        ASSERT_EQ(events[i].time, pattern.events[i].time);
+        ASSERT_EQ(package.GetPoints(events[i]).size(), pattern.events[i].points.size());
+    }
+}
+
+/**
+ * @tc.name: VibratorInfosTest_005
+ * @tc.desc: A longer pattern is split in time order into patterns the HDI can play
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorInfosTest, VibratorInfosTest_005, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorInfosTest_005 in");
+    VibratePattern pattern = MakePattern(SPLIT_EVENT_COUNT, MAX_POINT_SIZE);
+    std::reverse(pattern.events.begin(), pattern.events.end());
+    FlatVibratePackage package = FlatVibratePackage::Flatten(pattern, MAX_EVENT_SIZE);
+    size_t expectedPatterns = (SPLIT_EVENT_COUNT + MAX_EVENT_SIZE - 1) / MAX_EVENT_SIZE;
+    ASSERT_EQ(package.patterns.size(), expectedPatterns);
+    ASSERT_EQ(package.events.size(), SPLIT_EVENT_COUNT);
+    ASSERT_EQ(package.points.size(), SPLIT_EVENT_COUNT * MAX_POINT_SIZE);
+    int32_t index = 0;
+    for (size_t i = 0; i < package.patterns.size(); ++i) {
+        const FlatVibratePattern &slice = package.patterns[i];
+        ASSERT_LE(slice.eventCount, MAX_EVENT_SIZE);
+        int32_t startTime = (i == 0) ? 0 : index * EVENT_INTERVAL;
+        ASSERT_EQ(slice.startTime, startTime);
+        for (const auto &event : package.GetEvents(slice)) {
+            ASSERT_EQ(event.index, index);
+            ASSERT_EQ(slice.startTime + event.time, index * EVENT_INTERVAL);
+            ASSERT_EQ(package.GetPoints(event).size(), MAX_POINT_SIZE);
+            ++index;
+        }
+    }
+    ASSERT_EQ(index, SPLIT_EVENT_COUNT);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -20,6 +20,7 @@
 #include "nativetoken_kit.h"
 #include "token_setproc.h"
 #include "light_agent.h"
+#include "light_err_code.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -346,5 +347,28 @@ HWTEST_F(LightAgentTest, StartLightTest_011, TestSize.Level1)
     int32_t ret = TurnOff(g_invalidLightId);
     ASSERT_EQ(ret, -1);
 }
+
+/**
+ * @tc.name: NormalizeLightErrCode_001
+ * @tc.desc: Verify a deferred request is reported as success
+ * @tc.type: FUNC
+ */
+HWTEST_F(LightAgentTest, NormalizeLightErrCode_001, TestSize.Level1)
+{
+    CALL_LOG_ENTER;
+    ASSERT_EQ(NormalizeLightErrCode(MISC_NATIVE_REQUEST_DEFERRED), SUCCESS);
+}
+
+/**
+ * @tc.name: NormalizeLightErrCode_002
+ * @tc.desc: Verify an unavailable service is reported as ERROR
+ * @tc.type: FUNC
+ */
+HWTEST_F(LightAgentTest, NormalizeLightErrCode_002, TestSize.Level1)
+{
+    CALL_LOG_ENTER;
+    ASSERT_EQ(NormalizeLightErrCode(MISC_NATIVE_SERVICE_UNAVAILABLE_ERR), ERROR);
+    ASSERT_EQ(NormalizeLightErrCode(PERMISSION_DENIED), ERROR);
+}
 }  // namespace Sensors
 }  // namespace OHOS
@@ -25,6 +25,8 @@
 
 #include "sensors_errors.h"
 #include "vibrator_agent.h"
+#include "vibrator_err_code.h"
+#include "vibrator_service_client.h"
 
 #undef LOG_TAG
 #define LOG_TAG "VibratorAgentTest"
@@ -1256,5 +1258,221 @@ HWTEST_F(VibratorAgentTest, IsHdHapticSupported_001, TestSize.Level1)
     bool ret = IsHdHapticSupported();
     MISC_HILOGI("IsHdHapticSupported:%{public}s", ret ? "true" : "false");
 }
+
+HWTEST_F(VibratorAgentTest, RegisterEffect_001, TestSize.Level1)
+{
+    MISC_HILOGI("RegisterEffect_001 in");
+    if (IsSupportVibratorCustom()) {
+        FileDescriptor fileDescriptor("/data/test/vibrator/coin_drop.json");
+        MISC_HILOGD("fd:%{public}d", fileDescriptor.fd);
+        VibratorFileDescription vfd;
+        VibratorPackage package;
+        struct stat64 statbuf = { 0 };
+        if (fstat64(fileDescriptor.fd, &statbuf) == 0) {
+            vfd.fd = fileDescriptor.fd;
+            vfd.offset = 0;
+            vfd.length = statbuf.st_size;
+            int32_t ret = PreProcess(vfd, package);
+            ASSERT_EQ(ret, 0);
+            int32_t handle = 0;
+            ret = RegisterEffect(package, handle);
+            ASSERT_EQ(ret, 0);
+            ASSERT_EQ(SetUsage(USAGE_UNKNOWN), true);
+            ret = PlayEffectHandle(handle);
+            ASSERT_EQ(ret, 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(package.packageDuration));
+            ret = ReleaseEffect(handle);
+            ASSERT_EQ(ret, 0);
+            ret = PlayEffectHandle(handle);
+            ASSERT_EQ(ret, PARAMETER_ERROR);
+            ret = ReleaseEffect(handle);
+            ASSERT_EQ(ret, PARAMETER_ERROR);
+        }
+        int32_t ret = FreeVibratorPackage(package);
+        ASSERT_EQ(ret, 0);
+        Cancel();
+    } else {
+        ASSERT_EQ(0, 0);
+    }
+}
+
+HWTEST_F(VibratorAgentTest, RegisterEffect_002, TestSize.Level1)
+{
+    MISC_HILOGI("RegisterEffect_002 in");
+    VibratorPackage package;
+    int32_t handle = 0;
+    int32_t ret = RegisterEffect(package, handle);
+    ASSERT_EQ(ret, PARAMETER_ERROR);
+}
+
+HWTEST_F(VibratorAgentTest, RegisterEffect_003, TestSize.Level1)
+{
+    MISC_HILOGI("RegisterEffect_003 in");
+    VibratorEvent event = {
+        .type = EVENT_TYPE_CONTINUOUS,
+        .time = 0,
+        .duration = 100,
+        .intensity = INTENSITY_HIGH + 1,
+        .frequency = 50,
+    };
+    VibratorPattern pattern = {
+        .time = 0,
+        .eventNum = 1,
+        .patternDuration = 100,
+        .events = &event,
+    };
+    VibratorPackage package = {
+        .patternNum = 1,
+        .packageDuration = 100,
+        .patterns = &pattern,
+    };
+    int32_t handle = 0;
+    int32_t ret = RegisterEffect(package, handle);
+    ASSERT_EQ(ret, PARAMETER_ERROR);
+}
+
+HWTEST_F(VibratorAgentTest, PlayEffectHandle_001, TestSize.Level1)
+{
+    MISC_HILOGI("PlayEffectHandle_001 in");
+    int32_t ret = PlayEffectHandle(-1);
+    ASSERT_EQ(ret, PARAMETER_ERROR);
+}
+
+HWTEST_F(VibratorAgentTest, ReleaseEffect_001, TestSize.Level1)
+{
+    MISC_HILOGI("ReleaseEffect_001 in");
+    int32_t ret = ReleaseEffect(-1);
+    ASSERT_EQ(ret, PARAMETER_ERROR);
+}
+
+HWTEST_F(VibratorAgentTest, ConvertVibratePackage_001, TestSize.Level1)
+{
+    MISC_HILOGI("ConvertVibratePackage_001 in");
+    VibratePackage pkg;
+    pkg.packageDuration = 100;
+    VibratorPackage package = {
+        .patternNum = -1,
+        .packageDuration = 0,
+        .patterns = nullptr,
+    };
+    int32_t ret = VibratorServiceClient::ConvertVibratePackage(pkg, package);
+    ASSERT_EQ(ret, ERR_OK);
+    ASSERT_EQ(package.patternNum, 0);
+    ASSERT_EQ(package.packageDuration, 100);
+    ASSERT_EQ(package.patterns, nullptr);
+    ret = FreeVibratorPackage(package);
+    ASSERT_NE(ret, SUCCESS);
+    ASSERT_EQ(package.patterns, nullptr);
+}
+
+HWTEST_F(VibratorAgentTest, ConvertVibratePackage_002, TestSize.Level1)
+{
+    MISC_HILOGI("ConvertVibratePackage_002 in");
+    // Every array at its limit, with distinct values so that a misplaced interior pointer shows up.
+    VibratePackage pkg;
+    pkg.packageDuration = MAX_PATTERN_SIZE;
+    int32_t value = 0;
+    for (int32_t i = 0; i < MAX_PATTERN_SIZE; ++i) {
+        VibratePattern pattern;
+        pattern.startTime = i;
+        for (int32_t j = 0; j < MAX_EVENT_SIZE; ++j) {
+            VibrateEvent event;
+            event.tag = EVENT_TAG_CONTINUOUS;
+            event.time = ++value;
+            event.duration = 1;
+            event.intensity = ++value;
+            event.frequency = ++value;
+            event.index = j;
+            for (int32_t k = 0; k < MAX_POINT_SIZE; ++k) {
+                event.points.push_back({ .time = ++value, .intensity = ++value, .frequency = ++value });
+            }
+            pattern.events.push_back(event);
+        }
+        pkg.patterns.push_back(pattern);
+    }
+    VibratorPackage package;
+    int32_t ret = VibratorServiceClient::ConvertVibratePackage(pkg, package);
+    ASSERT_EQ(ret, ERR_OK);
+    ASSERT_EQ(package.patternNum, MAX_PATTERN_SIZE);
+    ASSERT_EQ(package.packageDuration, pkg.packageDuration);
+    ASSERT_NE(package.patterns, nullptr);
+    const uint8_t *blockBegin = reinterpret_cast<const uint8_t *>(package.patterns);
+    const uint8_t *blockEnd = blockBegin + sizeof(VibratorPattern) * MAX_PATTERN_SIZE +
+        sizeof(VibratorEvent) * MAX_PATTERN_SIZE * MAX_EVENT_SIZE +
+        sizeof(VibratorCurvePoint) * MAX_PATTERN_SIZE * MAX_EVENT_SIZE * MAX_POINT_SIZE;
+    int32_t patternDuration = 0;
+    for (int32_t i = 0; i < MAX_PATTERN_SIZE; ++i) {
+        const VibratorPattern &pattern = package.patterns[i];
+        ASSERT_EQ(pattern.time, pkg.patterns[i].startTime);
+        ASSERT_EQ(pattern.eventNum, MAX_EVENT_SIZE);
+        const uint8_t *events = reinterpret_cast<const uint8_t *>(pattern.events);
+        ASSERT_TRUE((events >= blockBegin) && (events + sizeof(VibratorEvent) * MAX_EVENT_SIZE <= blockEnd));
+        for (int32_t j = 0; j < MAX_EVENT_SIZE; ++j) {
+            const VibrateEvent &inEvent = pkg.patterns[i].events[j];
+            const VibratorEvent &event = pattern.events[j];
+            ASSERT_EQ(event.type, EVENT_TYPE_CONTINUOUS);
+            ASSERT_EQ(event.time, inEvent.time);
+            ASSERT_EQ(event.duration, inEvent.duration);
+            ASSERT_EQ(event.intensity, inEvent.intensity);
+            ASSERT_EQ(event.frequency, inEvent.frequency);
+            ASSERT_EQ(event.index, inEvent.index);
+            ASSERT_EQ(event.pointNum, MAX_POINT_SIZE);
+            const uint8_t *points = reinterpret_cast<const uint8_t *>(event.points);
+            ASSERT_TRUE((points >= blockBegin) && (points + sizeof(VibratorCurvePoint) * MAX_POINT_SIZE <= blockEnd));
+            for (int32_t k = 0; k < MAX_POINT_SIZE; ++k) {
+                ASSERT_EQ(event.points[k].time, inEvent.points[k].time);
+                ASSERT_EQ(event.points[k].intensity, inEvent.points[k].intensity);
+                ASSERT_EQ(event.points[k].frequency, inEvent.points[k].frequency);
+            }
+            patternDuration += inEvent.duration;
+        }
+        ASSERT_EQ(pattern.patternDuration, patternDuration);
+    }
+    ret = FreeVibratorPackage(package);
+    ASSERT_EQ(ret, SUCCESS);
+    ASSERT_EQ(package.patternNum, 0);
+    ASSERT_EQ(package.patterns, nullptr);
+}
+
+HWTEST_F(VibratorAgentTest, ConvertVibratePackage_003, TestSize.Level1)
+{
+    MISC_HILOGI("ConvertVibratePackage_003 in");
+    // Patterns without events and events without points get no interior pointer.
+    VibratePackage pkg;
+    pkg.patterns.resize(2);
+    VibrateEvent event;
+    event.tag = EVENT_TAG_TRANSIENT;
+    event.duration = 48;
+    pkg.patterns[1].events.push_back(event);
+    VibratorPackage package;
+    int32_t ret = VibratorServiceClient::ConvertVibratePackage(pkg, package);
+    ASSERT_EQ(ret, ERR_OK);
+    ASSERT_EQ(package.patternNum, 2);
+    ASSERT_EQ(package.patterns[0].eventNum, 0);
+    ASSERT_EQ(package.patterns[0].events, nullptr);
+    ASSERT_EQ(package.patterns[1].eventNum, 1);
+    ASSERT_EQ(package.patterns[1].events[0].type, EVENT_TYPE_TRANSIENT);
+    ASSERT_EQ(package.patterns[1].events[0].pointNum, 0);
+    ASSERT_EQ(package.patterns[1].events[0].points, nullptr);
+    ret = FreeVibratorPackage(package);
+    ASSERT_EQ(ret, SUCCESS);
+}
+
+HWTEST_F(VibratorAgentTest, NormalizeVibratorErrCode_001, TestSize.Level1)
+{
+    MISC_HILOGI("NormalizeVibratorErrCode_001 in");
+    // A request queued until the service is back has been accepted.
+    ASSERT_EQ(NormalizeVibratorErrCode(MISC_NATIVE_REQUEST_DEFERRED), SUCCESS);
+}
+
+HWTEST_F(VibratorAgentTest, NormalizeVibratorErrCode_002, TestSize.Level1)
+{
+    MISC_HILOGI("NormalizeVibratorErrCode_002 in");
+    ASSERT_EQ(NormalizeVibratorErrCode(MISC_NATIVE_SERVICE_UNAVAILABLE_ERR), DEVICE_OPERATION_FAILED);
+    ASSERT_EQ(NormalizeVibratorErrCode(PERMISSION_DENIED), PERMISSION_DENIED);
+    ASSERT_EQ(NormalizeVibratorErrCode(PARAMETER_ERROR), PARAMETER_ERROR);
+    ASSERT_EQ(NormalizeVibratorErrCode(IS_NOT_SUPPORTED), IS_NOT_SUPPORTED);
+    ASSERT_EQ(NormalizeVibratorErrCode(ERROR), DEVICE_OPERATION_FAILED);
+}
 }  // namespace Sensors
 }  // namespace OHOS
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "curve_interpolation.h"
+#include "custom_vibration_matcher.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "CustomVibrationMatcherTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+const std::map<int32_t, std::vector<int32_t>> TRANSIENT_VIBRATION_INFOS = {
+    {0x28, {0x4d, 0x4d, 0x0b}}, {0x2c, {0x2a, 0x64, 0x07}}, {0x30, {0x44, 0x52, 0x16}},
+    {0x3c, {0x45, 0x34, 0x0a}}, {0x40, {0x2e, 0x43, 0x0a}}, {0x48, {0x51, 0x52, 0x0a}},
+    {0x4c, {0x3a, 0x0c, 0x0f}}, {0x50, {0x64, 0x20, 0x14}}, {0x54, {0x55, 0x34, 0x1c}},
+    {0x5c, {0x32, 0x0c, 0x13}}, {0x60, {0x12, 0x07, 0x0a}}
+};
+constexpr int32_t TRANSIENT_GRADE_NUM = 4;
+constexpr float TRANSIENT_GRADE_GAIN = 0.25;
+constexpr float INTENSITY_WEIGHT = 0.5;
+constexpr float FREQUENCY_WEIGHT = 0.5;
+constexpr float WEIGHT_SUM_INIT = 100;
+constexpr int32_t VALUE_MIN = 0;
+constexpr int32_t VALUE_MAX = 100;
+constexpr int32_t OUT_OF_RANGE_MARGIN = 30;
+constexpr int32_t SLICE_STEP = 50;
+constexpr int32_t DELTA_TIME_MAX = 64;
+constexpr int32_t START_VALUE_STEP = 25;
+constexpr int32_t CURVE_NUM = 200;
+constexpr int32_t CURVE_POINT_MAX = 1000;
+constexpr int32_t CURVE_STEP_MAX = 40;
+
+// The search ProcessTransientEvent ran for every event before the table, kept verbatim as the reference.
+int32_t ReferenceTransientMatch(int32_t intensity, int32_t frequency)
+{
+    int32_t matchId = 0;
+    float minWeightSum = WEIGHT_SUM_INIT;
+    for (const auto &transientInfo : TRANSIENT_VIBRATION_INFOS) {
+        int32_t id = transientInfo.first;
+        const std::vector<int32_t> &info = transientInfo.second;
+        float frequencyDistance = std::abs(frequency - info[1]);
+        for (int32_t j = 0; j < TRANSIENT_GRADE_NUM; ++j) {
+            float intensityDistance = std::abs(intensity - info[0] * (1 - j * TRANSIENT_GRADE_GAIN));
+            float weightSum = INTENSITY_WEIGHT * intensityDistance + FREQUENCY_WEIGHT * frequencyDistance;
+            if (weightSum < minWeightSum) {
+                minWeightSum = weightSum;
+                matchId = id + j;
+            }
+        }
+    }
+    return matchId;
+}
+
+// The interpolation the matcher used before InterpolateLinear, kept verbatim as the reference.
+int32_t ReferenceInterpolation(int32_t x1, int32_t x2, int32_t y1, int32_t y2, int32_t x)
+{
+    if (x1 == x2) {
+        return y1;
+    }
+    float delta_y = static_cast<float>(y2 - y1);
+    float delta_x = static_cast<float>(x2 - x1);
+    return y1 + delta_y / delta_x * (x - x1);
+}
+
+// The slicing loop ProcessContinuousEvent ran before the batched kernel, kept as the reference.
+std::vector<VibrateSlice> ReferenceSliceCurve(const std::vector<VibrateCurvePoint> &curve)
+{
+    std::vector<VibrateSlice> slices;
+    int32_t endTime = curve.back().time;
+    int32_t curTime = curve.front().time;
+    int32_t curIntensity = curve.front().intensity;
+    int32_t curFrequency = curve.front().frequency;
+    int32_t nextTime = 0;
+    int32_t i = 0;
+    while (curTime < endTime) {
+        if ((endTime - curTime) >= (2 * SLICE_STEP)) {
+            nextTime = curTime + SLICE_STEP;
+        } else {
+            nextTime = endTime;
+        }
+        while (curve[i].time < nextTime) {
+            ++i;
+        }
+        if (i < 1) {
+            curTime = nextTime;
+            continue;
+        }
+        int32_t nextIntensity = ReferenceInterpolation(curve[i - 1].time, curve[i].time, curve[i - 1].intensity,
+            curve[i].intensity, nextTime);
+        int32_t nextFrequency = ReferenceInterpolation(curve[i - 1].time, curve[i].time, curve[i - 1].frequency,
+            curve[i].frequency, nextTime);
+        slices.push_back({
+            .time = curTime,
+            .duration = nextTime - curTime,
+            .intensity = (curIntensity + nextIntensity) / 2,
+            .frequency = (curFrequency + nextFrequency) / 2,
+        });
+        curTime = nextTime;
+        curIntensity = nextIntensity;
+        curFrequency = nextFrequency;
+    }
+    return slices;
+}
+}  // namespace
+
+class CustomVibrationMatcherTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: TransientMatchTest_001
+ * @tc.desc: Before and after the match table is built, every intensity and frequency matches the reference search
+ * @tc.type: FUNC
+ */
+HWTEST_F(CustomVibrationMatcherTest, TransientMatchTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("TransientMatchTest_001 in");
+    for (int32_t intensity = VALUE_MIN; intensity <= VALUE_MAX; ++intensity) {
+        for (int32_t frequency = VALUE_MIN; frequency <= VALUE_MAX; ++frequency) {
+            ASSERT_EQ(CustomVibrationMatcher::MatchTransientEffect(intensity, frequency),
+                ReferenceTransientMatch(intensity, frequency)) << intensity << "," << frequency;
+        }
+    }
+    CustomVibrationMatcher::InitTransientMatchTable();
+    for (int32_t intensity = VALUE_MIN; intensity <= VALUE_MAX; ++intensity) {
+        for (int32_t frequency = VALUE_MIN; frequency <= VALUE_MAX; ++frequency) {
+            ASSERT_EQ(CustomVibrationMatcher::MatchTransientEffect(intensity, frequency),
+                ReferenceTransientMatch(intensity, frequency)) << intensity << "," << frequency;
+        }
+    }
+}
+
+/**
+ * @tc.name: TransientMatchTest_002
+ * @tc.desc: Values outside the table still match the reference search
+ * @tc.type: FUNC
+ */
+HWTEST_F(CustomVibrationMatcherTest, TransientMatchTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("TransientMatchTest_002 in");
+    CustomVibrationMatcher::InitTransientMatchTable();
+    for (int32_t intensity = VALUE_MIN - OUT_OF_RANGE_MARGIN; intensity <= VALUE_MAX + OUT_OF_RANGE_MARGIN;
+        ++intensity) {
+        for (int32_t frequency = VALUE_MIN - OUT_OF_RANGE_MARGIN; frequency <= VALUE_MAX + OUT_OF_RANGE_MARGIN;
+            ++frequency) {
+            ASSERT_EQ(CustomVibrationMatcher::MatchTransientEffect(intensity, frequency),
+                ReferenceTransientMatch(intensity, frequency)) << intensity << "," << frequency;
+        }
+    }
+}
+
+/**
+ * @tc.name: CurveInterpolationTest_001
+ * @tc.desc: The scalar and the batched interpolation equal the original formula, vertical segments included
+ * @tc.type: FUNC
+ */
+HWTEST_F(CustomVibrationMatcherTest, CurveInterpolationTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("CurveInterpolationTest_001 in");
+    std::vector<int32_t> x1;
+    std::vector<int32_t> x2;
+    std::vector<int32_t> y1;
+    std::vector<int32_t> y2;
+    std::vector<int32_t> x;
+    for (int32_t deltaTime = 0; deltaTime <= DELTA_TIME_MAX; ++deltaTime) {
+        for (int32_t start = VALUE_MIN; start <= VALUE_MAX; start += START_VALUE_STEP) {
+            for (int32_t end = VALUE_MIN; end <= VALUE_MAX; ++end) {
+                for (int32_t offset = 0; offset <= deltaTime; ++offset) {
+                    x1.push_back(SLICE_STEP);
+                    x2.push_back(SLICE_STEP + deltaTime);
+                    y1.push_back(start);
+                    y2.push_back(end);
+                    x.push_back(SLICE_STEP + offset);
+                }
+            }
+        }
+    }
+    std::vector<int32_t> y(x.size());
+    InterpolateLinearBatch(x1.data(), x2.data(), y1.data(), y2.data(), x.data(), y.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        int32_t expected = ReferenceInterpolation(x1[i], x2[i], y1[i], y2[i], x[i]);
+        ASSERT_EQ(InterpolateLinear(x1[i], x2[i], y1[i], y2[i], x[i]), expected) << i;
+        ASSERT_EQ(y[i], expected) << i;
+    }
+}
+
+/**
+ * @tc.name: SliceCurveTest_001
+ * @tc.desc: Slicing long, dense curves through the batched kernel gives the slices of the scalar loop, reusing one scratch buffer
+ * @tc.type: FUNC
+ */
+HWTEST_F(CustomVibrationMatcherTest, SliceCurveTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("SliceCurveTest_001 in");
+    std::mt19937 engine(CURVE_NUM);
+    std::uniform_int_distribution<int32_t> value(VALUE_MIN, VALUE_MAX);
+    std::uniform_int_distribution<int32_t> step(0, CURVE_STEP_MAX);
+    std::uniform_int_distribution<int32_t> length(1, CURVE_POINT_MAX);
+    std::vector<int32_t> lanes;
+    for (int32_t n = 0; n < CURVE_NUM; ++n) {
+        std::vector<VibrateCurvePoint> curve;
+        int32_t time = 0;
+        int32_t pointNum = length(engine);
+        for (int32_t i = 0; i < pointNum; ++i) {
+            curve.push_back({ .time = time, .intensity = value(engine), .frequency = value(engine) });
+            time += step(engine);
+        }
+        std::vector<VibrateSlice> slices;
+        CustomVibrationMatcher::SliceCurve(ArrayView<VibrateCurvePoint>(curve.data(), curve.size()), lanes, slices);
+        std::vector<VibrateSlice> expected = ReferenceSliceCurve(curve);
+        ASSERT_EQ(slices.size(), expected.size()) << n;
+        for (size_t i = 0; i < slices.size(); ++i) {
+            ASSERT_EQ(slices[i].time, expected[i].time) << n << "," << i;
+            ASSERT_EQ(slices[i].duration, expected[i].duration) << n << "," << i;
+            ASSERT_EQ(slices[i].intensity, expected[i].intensity) << n << "," << i;
+            ASSERT_EQ(slices[i].frequency, expected[i].frequency) << n << "," << i;
+        }
+    }
+}
+
+/**
+ * @tc.name: MergeCurveTest_001
+ * @tc.desc: Points at the same time are merged with the right curve's point at that time, not at the left index
+ * @tc.type: FUNC
+ */
+HWTEST_F(CustomVibrationMatcherTest, MergeCurveTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("MergeCurveTest_001 in");
+    // The left curve starts earlier, so when the times first meet its index is ahead of the right one.
+    std::vector<VibrateCurvePoint> left = {
+        { .time = 0, .intensity = 10, .frequency = 10 },
+        { .time = 10, .intensity = 10, .frequency = 10 },
+        { .time = 20, .intensity = 10, .frequency = 10 },
+        { .time = 30, .intensity = 10, .frequency = 10 },
+    };
+    std::vector<VibrateCurvePoint> right = {
+        { .time = 20, .intensity = 80, .frequency = 50 },
+        { .time = 30, .intensity = 90, .frequency = 70 },
+        { .time = 40, .intensity = 5, .frequency = -50 },
+        { .time = 50, .intensity = 6, .frequency = -60 },
+        { .time = 60, .intensity = 7, .frequency = -70 },
+    };
+    std::vector<VibrateCurvePoint> expected = {
+        { .time = 0, .intensity = 10, .frequency = 10 },
+        { .time = 10, .intensity = 10, .frequency = 10 },
+        { .time = 20, .intensity = 80, .frequency = 30 },
+        { .time = 30, .intensity = 90, .frequency = 40 },
+        { .time = 40, .intensity = 5, .frequency = -50 },
+        { .time = 50, .intensity = 6, .frequency = -60 },
+        { .time = 60, .intensity = 7, .frequency = -70 },
+    };
+    std::vector<VibrateCurvePoint> merged = CustomVibrationMatcher::MergeCurve(
+        ArrayView<VibrateCurvePoint>(left.data(), left.size()),
+        ArrayView<VibrateCurvePoint>(right.data(), right.size()));
+    ASSERT_EQ(merged.size(), expected.size());
+    for (size_t i = 0; i < merged.size(); ++i) {
+        ASSERT_EQ(merged[i].time, expected[i].time) << i;
+        ASSERT_EQ(merged[i].intensity, expected[i].intensity) << i;
+        ASSERT_EQ(merged[i].frequency, expected[i].frequency) << i;
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
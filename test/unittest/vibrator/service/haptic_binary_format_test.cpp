@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "binary_haptic_format.h"
+#include "binary_vibrator_decoder.h"
+#include "default_vibrator_stream_decoder.h"
+#include "haptic_decoder_test_utils.h"
+#include "he_vibrator_stream_decoder.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HapticBinaryFormatTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+// The last start time the container accepts, 30 minutes into the effect.
+constexpr int32_t LONG_TIMELINE_END = 1800000;
+constexpr int32_t LONG_TIMELINE_STEP = 450000;
+
+std::string MakeLongTimelineHe(int32_t endTime)
+{
+    std::string patterns;
+    for (int32_t time = 0; time <= endTime; time += LONG_TIMELINE_STEP) {
+        int32_t absoluteTime = (time + LONG_TIMELINE_STEP > endTime) ? endTime : time;
+        if (!patterns.empty()) {
+            patterns += ",";
+        }
+        patterns += R"({"AbsoluteTime":)" + std::to_string(absoluteTime) + R"(,"Pattern":[)"
+            R"({"Event":{"Type":"transient","RelativeTime":0,"Parameters":{"Intensity":60,"Frequency":5}}},)"
+            R"({"Event":{"Type":"continuous","RelativeTime":100,"Duration":100,"Parameters":{"Intensity":80,)"
+            R"("Frequency":50,"Curve":[{"Time":0,"Intensity":0,"Frequency":0},{"Time":20,"Intensity":0.5,)"
+            R"("Frequency":10},{"Time":60,"Intensity":1,"Frequency":-10},{"Time":100,"Intensity":0,)"
+            R"("Frequency":0}]}}}]})";
+        if (absoluteTime == endTime) {
+            break;
+        }
+    }
+    return R"({"Metadata":{"Version":2},"PatternList":[)" + patterns + "]}";
+}
+
+template<typename Stream>
+void CheckBinaryRoundTrip(const std::vector<std::string> &seeds)
+{
+    size_t accepted = 0;
+    for (const auto &content : MakeCorpus(seeds)) {
+        Stream stream;
+        VibratePackage textPackage;
+        if (stream.DecodeBuffer(content, textPackage) != SUCCESS) {
+            continue;
+        }
+        std::vector<uint8_t> buffer;
+        ASSERT_EQ(EncodeBinaryHaptic(textPackage, buffer), SUCCESS) << content;
+        TestFile file(std::string(buffer.begin(), buffer.end()));
+        ASSERT_GE(file.GetRawFd().fd, 0);
+        BinaryVibratorDecoder decoder;
+        VibratePackage binaryPackage;
+        ASSERT_EQ(decoder.DecodeEffect(file.GetRawFd(), binaryPackage), SUCCESS) << content;
+        ASSERT_TRUE(IsSamePackage(textPackage, binaryPackage)) << content;
+        ++accepted;
+    }
+    ASSERT_GE(accepted, seeds.size());
+}
+}  // namespace
+
+class HapticBinaryFormatTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: BinaryFormatTest_001
+ * @tc.desc: A converted .ohb container decodes to the same package as its .json or .he source
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticBinaryFormatTest, BinaryFormatTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("BinaryFormatTest_001 in");
+    CheckBinaryRoundTrip<DefaultVibratorStreamDecoder>(JSON_SEEDS);
+    CheckBinaryRoundTrip<HEVibratorStreamDecoder>(HE_SEEDS);
+}
+
+/**
+ * @tc.name: BinaryFormatTest_002
+ * @tc.desc: Truncated or inconsistent .ohb containers are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticBinaryFormatTest, BinaryFormatTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("BinaryFormatTest_002 in");
+    HEVibratorStreamDecoder stream;
+    VibratePackage textPackage;
+    ASSERT_EQ(stream.DecodeBuffer(HE_SEEDS[0], textPackage), SUCCESS);
+    std::vector<uint8_t> buffer;
+    ASSERT_EQ(EncodeBinaryHaptic(textPackage, buffer), SUCCESS);
+    BinaryVibratorDecoder decoder;
+    VibratePackage pkg;
+    for (size_t length = 0; length < buffer.size(); ++length) {
+        std::string_view truncated(reinterpret_cast<const char *>(buffer.data()), length);
+        ASSERT_NE(decoder.DecodeBuffer(truncated, pkg), SUCCESS) << length;
+        ASSERT_TRUE(pkg.patterns.empty());
+    }
+    size_t offset = sizeof(BinaryHapticHeader) + sizeof(BinaryPatternRecord);
+    std::vector<uint8_t> corrupted = buffer;
+    BinaryEventRecord event;
+    std::copy_n(corrupted.data() + offset, sizeof(event), reinterpret_cast<uint8_t *>(&event));
+    ++event.firstPoint;
+    std::copy_n(reinterpret_cast<const uint8_t *>(&event), sizeof(event), corrupted.data() + offset);
+    std::string_view data(reinterpret_cast<const char *>(corrupted.data()), corrupted.size());
+    ASSERT_NE(decoder.DecodeBuffer(data, pkg), SUCCESS);
+    corrupted = buffer;
+    corrupted[0] ^= 0xFF;
+    data = std::string_view(reinterpret_cast<const char *>(corrupted.data()), corrupted.size());
+    ASSERT_NE(decoder.DecodeBuffer(data, pkg), SUCCESS);
+    data = std::string_view(reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    ASSERT_EQ(decoder.DecodeBuffer(data, pkg), SUCCESS);
+    ASSERT_TRUE(IsSamePackage(textPackage, pkg));
+}
+
+/**
+ * @tc.name: BinaryFormatTest_003
+ * @tc.desc: Well-formed .ohb containers with out-of-range values or above the size cap are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticBinaryFormatTest, BinaryFormatTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("BinaryFormatTest_003 in");
+    HEVibratorStreamDecoder stream;
+    VibratePackage textPackage;
+    ASSERT_EQ(stream.DecodeBuffer(HE_SEEDS[0], textPackage), SUCCESS);
+    std::vector<uint8_t> buffer;
+    ASSERT_EQ(EncodeBinaryHaptic(textPackage, buffer), SUCCESS);
+    size_t offset = sizeof(BinaryHapticHeader) + sizeof(BinaryPatternRecord);
+    std::vector<uint8_t> corrupted = buffer;
+    BinaryEventRecord event;
+    std::copy_n(corrupted.data() + offset, sizeof(event), reinterpret_cast<uint8_t *>(&event));
+    event.intensity = INT32_MAX;
+    std::copy_n(reinterpret_cast<const uint8_t *>(&event), sizeof(event), corrupted.data() + offset);
+    BinaryVibratorDecoder decoder;
+    VibratePackage pkg;
+    std::string_view data(reinterpret_cast<const char *>(corrupted.data()), corrupted.size());
+    ASSERT_NE(decoder.DecodeBuffer(data, pkg), SUCCESS);
+    ASSERT_TRUE(pkg.patterns.empty());
+    std::vector<uint8_t> oversized(static_cast<size_t>(MAX_BINARY_HAPTIC_SIZE) + 1, 0);
+    std::copy_n(buffer.data(), buffer.size(), oversized.data());
+    std::string_view oversizedData(reinterpret_cast<const char *>(oversized.data()), oversized.size());
+    ASSERT_NE(decoder.DecodeBuffer(oversizedData, pkg), SUCCESS);
+    VibratePackage hugePackage = textPackage;
+    hugePackage.patterns.assign(MAX_PATTERN_SIZE, textPackage.patterns.front());
+    ASSERT_NE(EncodeBinaryHaptic(hugePackage, buffer), SUCCESS);
+}
+
+/**
+ * @tc.name: BinaryFormatTest_004
+ * @tc.desc: A .he file up to the last start time round-trips, later patterns and empty patterns are not encoded
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticBinaryFormatTest, BinaryFormatTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("BinaryFormatTest_004 in");
+    TestFile heFile(MakeLongTimelineHe(LONG_TIMELINE_END), TEST_FILE_PATH + ".he");
+    ASSERT_GE(heFile.GetRawFd().fd, 0);
+    HEVibratorStreamDecoder stream;
+    VibratePackage textPackage;
+    ASSERT_EQ(stream.DecodeEffect(heFile.GetRawFd(), textPackage), SUCCESS);
+    ASSERT_EQ(textPackage.patterns.back().startTime, LONG_TIMELINE_END);
+    std::vector<uint8_t> buffer;
+    ASSERT_EQ(EncodeBinaryHaptic(textPackage, buffer), SUCCESS);
+    TestFile binaryFile(std::string(buffer.begin(), buffer.end()));
+    ASSERT_GE(binaryFile.GetRawFd().fd, 0);
+    BinaryVibratorDecoder decoder;
+    VibratePackage binaryPackage;
+    ASSERT_EQ(decoder.DecodeEffect(binaryFile.GetRawFd(), binaryPackage), SUCCESS);
+    ASSERT_TRUE(IsSamePackage(textPackage, binaryPackage));
+    VibratePackage latePackage;
+    ASSERT_EQ(stream.DecodeBuffer(MakeLongTimelineHe(LONG_TIMELINE_END + 1), latePackage), SUCCESS);
+    ASSERT_NE(EncodeBinaryHaptic(latePackage, buffer), SUCCESS);
+    VibratePackage emptyPackage = textPackage;
+    emptyPackage.patterns.back().events.clear();
+    ASSERT_NE(EncodeBinaryHaptic(emptyPackage, buffer), SUCCESS);
+    emptyPackage.patterns.clear();
+    ASSERT_NE(EncodeBinaryHaptic(emptyPackage, buffer), SUCCESS);
+}
+}  // namespace Sensors
+}  // namespace OHOS
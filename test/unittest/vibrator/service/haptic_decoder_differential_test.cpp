@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "default_vibrator_decoder.h"
+#include "default_vibrator_stream_decoder.h"
+#include "file_utils.h"
+#include "haptic_decoder_test_utils.h"
+#include "he_vibrator_decoder.h"
+#include "he_vibrator_stream_decoder.h"
+#include "json_stream_reader.h"
+#include "mapped_file_view.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HapticDecoderDifferentialTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+// Pushed by resource/ohos_test.xml from test/unittest/vibrator/native/resource/json_file and he_file.
+const std::string CORPUS_DIR = "/data/test/vibrator/";
+const std::vector<std::string> JSON_CORPUS_VALID_FILES = {
+    "coin_drop.json",
+    "on_carpet.json",
+    "test_128_event.json",
+};
+const std::vector<std::string> JSON_CORPUS_FILES = {
+    "coin_drop.json",
+    "on_carpet.json",
+    "test_128_event.json",
+    "test_129_event.json",
+    "test_big_file_size.json",
+    "test_event_overlap_1.json",
+    "test_event_overlap_2.json",
+    "test_invalid_duration.json",
+    "test_invalid_frequency.json",
+    "test_invalid_intensity.json",
+    "test_invalid_startTime.json",
+    "test_invalid_type.json",
+};
+const std::vector<std::string> HE_CORPUS_VALID_FILES = {
+    "continuous_transient.he",
+    "pattern_list.he",
+};
+const std::vector<std::string> HE_CORPUS_FILES = {
+    "continuous_transient.he",
+    "pattern_list.he",
+    "test_invalid_version.he",
+};
+
+std::string ReadCorpusFile(const std::string &name)
+{
+    std::string content;
+    int32_t fd = open((CORPUS_DIR + name).c_str(), O_RDONLY);
+    if (fd < 0) {
+        return content;
+    }
+    int64_t size = GetFileSize(fd);
+    if (size > 0) {
+        content.resize(static_cast<size_t>(size));
+        if (PreadFully(fd, 0, content.data(), content.size()) != SUCCESS) {
+            content.clear();
+        }
+    }
+    close(fd);
+    return content;
+}
+
+template<typename Reference, typename Stream>
+void CheckDifferential(const std::vector<std::string> &seeds)
+{
+    size_t accepted = 0;
+    for (const auto &content : MakeCorpus(seeds)) {
+        TestFile file(content);
+        ASSERT_GE(file.GetRawFd().fd, 0);
+        Reference reference;
+        Stream stream;
+        VibratePackage referencePackage;
+        VibratePackage streamPackage;
+        int32_t referenceRet = reference.DecodeEffect(file.GetRawFd(), referencePackage);
+        int32_t streamRet = stream.DecodeEffect(file.GetRawFd(), streamPackage);
+        ASSERT_EQ(referenceRet, streamRet) << content;
+        if (referenceRet == SUCCESS) {
+            ASSERT_TRUE(IsSamePackage(referencePackage, streamPackage)) << content;
+            ++accepted;
+        }
+    }
+    ASSERT_GE(accepted, seeds.size());
+}
+
+// Decodes every corpus file with both decoders, then the digit and truncation mutations of the valid ones.
+template<typename Reference, typename Stream>
+void CheckCorpusFiles(const std::vector<std::string> &files, const std::vector<std::string> &validFiles)
+{
+    for (const auto &name : files) {
+        int32_t fd = open((CORPUS_DIR + name).c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0) << name;
+        RawFileDescriptor rawFd = { .fd = fd, .offset = 0, .length = GetFileSize(fd) };
+        Reference reference;
+        Stream stream;
+        VibratePackage referencePackage;
+        VibratePackage streamPackage;
+        int32_t referenceRet = reference.DecodeEffect(rawFd, referencePackage);
+        int32_t streamRet = stream.DecodeEffect(rawFd, streamPackage);
+        close(fd);
+        ASSERT_EQ(referenceRet, streamRet) << name;
+        if (referenceRet == SUCCESS) {
+            ASSERT_TRUE(IsSamePackage(referencePackage, streamPackage)) << name;
+        }
+        if (std::find(validFiles.begin(), validFiles.end(), name) != validFiles.end()) {
+            ASSERT_EQ(streamRet, SUCCESS) << name;
+        }
+    }
+    std::vector<std::string> seeds;
+    for (const auto &name : validFiles) {
+        seeds.push_back(ReadCorpusFile(name));
+        ASSERT_FALSE(seeds.back().empty()) << name;
+    }
+    CheckDifferential<Reference, Stream>(seeds);
+}
+}  // namespace
+
+class HapticDecoderDifferentialTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: DifferentialTest_001
+ * @tc.desc: The streaming .json decoder agrees with the cJSON based decoder on every mutated input
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticDecoderDifferentialTest, DifferentialTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("DifferentialTest_001 in");
+    CheckDifferential<DefaultVibratorDecoder, DefaultVibratorStreamDecoder>(JSON_SEEDS);
+}
+
+/**
+ * @tc.name: DifferentialTest_002
+ * @tc.desc: The streaming .he decoder agrees with the cJSON based decoder on every mutated input
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticDecoderDifferentialTest, DifferentialTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("DifferentialTest_002 in");
+    CheckDifferential<HEVibratorDecoder, HEVibratorStreamDecoder>(HE_SEEDS);
+}
+
+/**
+ * @tc.name: DifferentialTest_003
+ * @tc.desc: The caller's fd stays open and keeps its file position after decoding
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticDecoderDifferentialTest, DifferentialTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("DifferentialTest_003 in");
+    TestFile file(HE_SEEDS[0]);
+    ASSERT_GE(file.GetRawFd().fd, 0);
+    off_t position = lseek(file.GetRawFd().fd, 0, SEEK_CUR);
+    HEVibratorStreamDecoder decoder;
+    VibratePackage pkg;
+    ASSERT_EQ(decoder.DecodeEffect(file.GetRawFd(), pkg), SUCCESS);
+    ASSERT_EQ(lseek(file.GetRawFd().fd, 0, SEEK_CUR), position);
+    ASSERT_EQ(decoder.DecodeEffect(file.GetRawFd(), pkg), SUCCESS);
+}
+
+/**
+ * @tc.name: DifferentialTest_004
+ * @tc.desc: The streaming .json decoder agrees with the cJSON based decoder on the committed haptic files
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticDecoderDifferentialTest, DifferentialTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("DifferentialTest_004 in");
+    CheckCorpusFiles<DefaultVibratorDecoder, DefaultVibratorStreamDecoder>(JSON_CORPUS_FILES, JSON_CORPUS_VALID_FILES);
+}
+
+/**
+ * @tc.name: DifferentialTest_005
+ * @tc.desc: Numbers longer than 63 characters are cut short like cJSON does, leaving a syntax error
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticDecoderDifferentialTest, DifferentialTest_005, TestSize.Level1)
+{
+    MISC_HILOGI("DifferentialTest_005 in");
+    std::string longNumber = "[1" + std::string(70, '0') + "]";
+    JsonStreamReader reader(longNumber);
+    bool hasElement = false;
+    ASSERT_TRUE(reader.EnterArray());
+    ASSERT_TRUE(reader.NextElement(hasElement));
+    ASSERT_TRUE(hasElement);
+    double value = 0.0;
+    ASSERT_TRUE(reader.ReadNumber(value));
+    ASSERT_DOUBLE_EQ(value, 1e62);
+    ASSERT_FALSE(reader.NextElement(hasElement));
+    std::string exactNumber = "[1" + std::string(62, '0') + "]";
+    JsonStreamReader exactReader(exactNumber);
+    ASSERT_TRUE(exactReader.EnterArray());
+    ASSERT_TRUE(exactReader.NextElement(hasElement));
+    ASSERT_TRUE(exactReader.ReadNumber(value));
+    ASSERT_DOUBLE_EQ(value, 1e62);
+    ASSERT_TRUE(exactReader.NextElement(hasElement));
+    ASSERT_FALSE(hasElement);
+}
+
+/**
+ * @tc.name: DifferentialTest_006
+ * @tc.desc: The streaming .he decoder agrees with the cJSON based decoder on the committed haptic files
+ * @tc.type: FUNC
+ */
+HWTEST_F(HapticDecoderDifferentialTest, DifferentialTest_006, TestSize.Level1)
+{
+    MISC_HILOGI("DifferentialTest_006 in");
+    CheckCorpusFiles<HEVibratorDecoder, HEVibratorStreamDecoder>(HE_CORPUS_FILES, HE_CORPUS_VALID_FILES);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HAPTIC_DECODER_TEST_UTILS_H
+#define HAPTIC_DECODER_TEST_UTILS_H
+
+#include <cctype>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "raw_file_descriptor.h"
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+// Shared by the haptic decoder, .ohb format and decoder registry tests.
+inline const std::string TEST_FILE_PATH = "/data/local/tmp/haptic_decoder_test";
+constexpr size_t TRUNCATE_STEP = 7;
+
+inline const std::vector<std::string> JSON_SEEDS = {
+    R"({"MetaData":{"Create":"2023-01-09","Description":"a haptic testcase","Version":1.0,"ChannelNumber":1},
+    "Channels":[{"Parameters":{"Index":0},"Pattern":[
+    {"Event":{"Type":"transient","StartTime":0,"Parameters":{"Frequency":31,"Intensity":100}}},
+    {"Event":{"Type":"continuous","StartTime":40,"Duration":54,"Parameters":{"Frequency":30,"Intensity":38,
+    "Curve":[{"Time":0,"Frequency":0,"Intensity":0},{"Time":1,"Frequency":0,"Intensity":1},
+    {"Time":40,"Frequency":0,"Intensity":1},{"Time":54,"Frequency":0,"Intensity":0}]}}},
+    {"Event":{"Type":"transient","StartTime":103,"Parameters":{"Frequency":69,"Intensity":79}}}]}]})",
+    R"({"Channels":[{"Pattern":[
+    {"Event":{"Parameters":{"Curve":[{"Intensity":0.5,"Time":30,"Frequency":-20},{"Time":0,"Frequency":0,"Intensity":0},
+    {"Time":90,"Frequency":10,"Intensity":0.25},{"Time":60,"Frequency":5,"Intensity":0.75}],"Intensity":70,"Frequency":20},
+    "StartTime":300,"Duration":90,"Type":"continuous"}},
+    {"Event":{"Type":"transient","StartTime":10,"Duration":"ignored","Parameters":{"Frequency":40,"Intensity":50,
+    "Curve":"ignored"}}}],"Parameters":{"Index":1}},
+    {"Parameters":{"Index":2},"Pattern":[{"Event":{"Type":"transient","StartTime":5,"Parameters":{"Frequency":1,
+    "Intensity":2}}}]}],
+    "metadata":{"channelnumber":2,"version":1},"MetaData":{"Version":2}} trailing)",
+};
+
+inline const std::vector<std::string> HE_SEEDS = {
+    R"({"Metadata":{"Version":1},"Pattern":[
+    {"Event":{"Type":"continuous","RelativeTime":0,"Duration":100,"Parameters":{"Intensity":80,"Frequency":50,
+    "Curve":[{"Time":0,"Intensity":0,"Frequency":0},{"Time":20,"Intensity":0.5,"Frequency":10},
+    {"Time":60,"Intensity":1,"Frequency":-10},{"Time":100,"Intensity":0,"Frequency":0}]}}},
+    {"Event":{"Type":"transient","RelativeTime":150,"Index":2,"Parameters":{"Intensity":60,"Frequency":-1}}}]})",
+    R"({"PatternList":[{"Pattern":[{"Event":{"Parameters":{"Curve":[{"Time":0,"Intensity":0,"Frequency":0},
+    {"Time":20,"Intensity":0.5,"Frequency":10},{"Time":60,"Intensity":1,"Frequency":-10},
+    {"Time":100,"Intensity":0,"Frequency":0}],"Intensity":80,"Frequency":50},"Duration":100,"RelativeTime":0,
+    "Type":"continuous"}}],"AbsoluteTime":5},{"AbsoluteTime":300,"Pattern":[{"Event":{"Type":"transient",
+    "RelativeTime":0,"Parameters":{"Intensity":60,"Frequency":"x"}}}]}],
+    "Pattern":{"ignored":true},"METADATA":{"version":2.7}} trailing)",
+    "\xEF\xBB\xBF {\"Metadata\":{\"Version\":1},\"x\":[[[\"\\u00e9\\ud83d\\ude00\\n\"]]],\"Pattern\":[{\"Event\":"
+    "{\"Type\":\"transient\",\"RelativeTime\":0,\"Parameters\":{\"Intensity\":60,\"Frequency\":5}}}],"
+    "\"Pattern\":\"duplicate\"}",
+};
+
+class TestFile {
+public:
+    explicit TestFile(const std::string &content, const std::string &path = TEST_FILE_PATH) : path_(path)
+    {
+        fd_ = open(path_.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+        if ((fd_ >= 0) && (write(fd_, content.data(), content.size()) != static_cast<ssize_t>(content.size()))) {
+            close(fd_);
+            fd_ = -1;
+        }
+        rawFd_ = { .fd = fd_, .offset = 0, .length = static_cast<int64_t>(content.size()) };
+    }
+    ~TestFile()
+    {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+        unlink(path_.c_str());
+    }
+    const RawFileDescriptor &GetRawFd() const
+    {
+        return rawFd_;
+    }
+
+private:
+    std::string path_;
+    int32_t fd_ = -1;
+    RawFileDescriptor rawFd_;
+};
+
+inline bool IsSamePackage(const VibratePackage &lhs, const VibratePackage &rhs)
+{
+    if ((lhs.packageDuration != rhs.packageDuration) || (lhs.patterns.size() != rhs.patterns.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.patterns.size(); ++i) {
+        const VibratePattern &left = lhs.patterns[i];
+        const VibratePattern &right = rhs.patterns[i];
+        if ((left.startTime != right.startTime) || (left.patternDuration != right.patternDuration) ||
+            (left.events.size() != right.events.size())) {
+            return false;
+        }
+        for (size_t j = 0; j < left.events.size(); ++j) {
+            const VibrateEvent &a = left.events[j];
+            const VibrateEvent &b = right.events[j];
+            if ((a.tag != b.tag) || (a.time != b.time) || (a.duration != b.duration) ||
+                (a.intensity != b.intensity) || (a.frequency != b.frequency) || (a.index != b.index) ||
+                (a.points.size() != b.points.size())) {
+                return false;
+            }
+            for (size_t k = 0; k < a.points.size(); ++k) {
+                if ((a.points[k].time != b.points[k].time) || (a.points[k].intensity != b.points[k].intensity) ||
+                    (a.points[k].frequency != b.points[k].frequency)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Mutations that only touch digits or cut the file short, so every input stays inside the reference's defined
+// behavior: the cJSON based decoder reads mismatched value types through NAN casts and a null std::string.
+inline std::vector<std::string> MakeCorpus(const std::vector<std::string> &seeds)
+{
+    std::vector<std::string> corpus;
+    for (const auto &seed : seeds) {
+        corpus.push_back(seed);
+        for (size_t i = 0; i < seed.size(); ++i) {
+            if (isdigit(static_cast<unsigned char>(seed[i])) == 0) {
+                continue;
+            }
+            for (char digit : { '0', '1', '9' }) {
+                if (seed[i] != digit) {
+                    std::string mutated = seed;
+                    mutated[i] = digit;
+                    corpus.push_back(std::move(mutated));
+                }
+            }
+        }
+        for (size_t length = 1; length < seed.size(); length += TRUNCATE_STEP) {
+            corpus.push_back(seed.substr(0, length));
+        }
+    }
+    return corpus;
+}
+
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // HAPTIC_DECODER_TEST_UTILS_H
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "sensors_errors.h"
+#include "vibrate_package_checker.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratePackageCheckerTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+VibrateEvent MakeContinuousEvent(int32_t time)
+{
+    VibrateEvent event;
+    event.tag = EVENT_TAG_CONTINUOUS;
+    event.time = time;
+    event.duration = 100;
+    event.intensity = 80;
+    event.frequency = 50;
+    event.points = {
+        { .time = 0, .intensity = 0, .frequency = 0 },
+        { .time = 30, .intensity = 100, .frequency = 20 },
+        { .time = 60, .intensity = 50, .frequency = -20 },
+        { .time = 100, .intensity = 0, .frequency = 0 },
+    };
+    return event;
+}
+
+VibrateEvent MakeTransientEvent(int32_t time)
+{
+    VibrateEvent event;
+    event.tag = EVENT_TAG_TRANSIENT;
+    event.time = time;
+    event.duration = 48;
+    event.intensity = 100;
+    event.frequency = 120;
+    return event;
+}
+
+VibratePackage MakePackage()
+{
+    VibratePackage package;
+    VibratePattern pattern;
+    pattern.events = { MakeContinuousEvent(0), MakeTransientEvent(200) };
+    package.patterns.push_back(pattern);
+    pattern.startTime = 500;
+    package.patterns.push_back(pattern);
+    return package;
+}
+}  // namespace
+
+class VibratePackageCheckerTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: VibratePackageCheckerTest_001
+ * @tc.desc: A package within the ranges of the JSON decoders is accepted
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratePackageCheckerTest, VibratePackageCheckerTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("VibratePackageCheckerTest_001 in");
+    EXPECT_TRUE(VibratePackageChecker::CheckPackage(MakePackage()));
+}
+
+/**
+ * @tc.name: VibratePackageCheckerTest_002
+ * @tc.desc: Empty packages, empty patterns and oversized patterns are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratePackageCheckerTest, VibratePackageCheckerTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("VibratePackageCheckerTest_002 in");
+    VibratePackage package;
+    EXPECT_FALSE(VibratePackageChecker::CheckPackage(package));
+    package.patterns.emplace_back();
+    EXPECT_FALSE(VibratePackageChecker::CheckPackage(package));
+    package.patterns.front().events.assign(MAX_EVENT_SIZE + 1, MakeTransientEvent(0));
+    EXPECT_FALSE(VibratePackageChecker::CheckPackage(package));
+}
+
+/**
+ * @tc.name: VibratePackageCheckerTest_003
+ * @tc.desc: Events and patterns out of time order are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratePackageCheckerTest, VibratePackageCheckerTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("VibratePackageCheckerTest_003 in");
+    VibratePackage package = MakePackage();
+    std::swap(package.patterns[0].events[0], package.patterns[0].events[1]);
+    EXPECT_FALSE(VibratePackageChecker::CheckPackage(package));
+    package = MakePackage();
+    package.patterns[0].startTime = 1000;
+    EXPECT_FALSE(VibratePackageChecker::CheckPackage(package));
+}
+
+/**
+ * @tc.name: VibratePackageCheckerTest_004
+ * @tc.desc: Event values outside the decoder ranges are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratePackageCheckerTest, VibratePackageCheckerTest_004, TestSize.Level1)
+{
+    MISC_HILOGI("VibratePackageCheckerTest_004 in");
+    VibrateEvent event = MakeContinuousEvent(0);
+    event.time = -1;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.duration = 5001;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.intensity = 101;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.frequency = 101;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.index = 3;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.tag = EVENT_TAG_UNKNOWN;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeTransientEvent(0);
+    event.frequency = 151;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeTransientEvent(0);
+    event.points = MakeContinuousEvent(0).points;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+}
+
+/**
+ * @tc.name: VibratePackageCheckerTest_005
+ * @tc.desc: Curves with a bad point count, out of order or out of range points are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratePackageCheckerTest, VibratePackageCheckerTest_005, TestSize.Level1)
+{
+    MISC_HILOGI("VibratePackageCheckerTest_005 in");
+    VibrateEvent event = MakeContinuousEvent(0);
+    event.points.pop_back();
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.points.assign(MAX_POINT_SIZE + 1, event.points.front());
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    std::swap(event.points[1], event.points[2]);
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.points.back().time = event.duration + 1;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.points[1].intensity = 101;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.points[1].frequency = -101;
+    EXPECT_FALSE(VibratePackageChecker::CheckEvent(event));
+    event = MakeContinuousEvent(0);
+    event.points.clear();
+    EXPECT_TRUE(VibratePackageChecker::CheckEvent(event));
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "sensors_errors.h"
+#include "vibration_admission_policy.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationAdmissionPolicyTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+static_assert(LookupAdmission({ .usage = USAGE_UNKNOWN, .isVibrating = true, .currentUsage = USAGE_ALARM }) ==
+    IGNORE_ALARM, "A running alarm must not be preempted");
+
+// The if-chain the priority manager used before the table, kept verbatim as the reference.
+VibrateStatus ReferenceAdmission(const AdmissionState &state)
+{
+    int32_t usage = state.usage;
+    if ((usage == USAGE_ALARM || usage == USAGE_RING || usage == USAGE_NOTIFICATION
+        || usage == USAGE_COMMUNICATION) && state.isRingerSilent) {
+        return IGNORE_RINGER_MODE;
+    }
+    if ((usage == USAGE_TOUCH || usage == USAGE_MEDIA || usage == USAGE_UNKNOWN
+        || usage == USAGE_PHYSICAL_FEEDBACK || usage == USAGE_SIMULATE_REALITY) && state.isFeedbackOff) {
+        return IGNORE_FEEDBACK;
+    }
+    if (!state.isVibrating) {
+        return VIBRATION;
+    }
+    if (state.isLoop) {
+        return VIBRATION;
+    }
+    if (state.currentUsage == USAGE_ALARM) {
+        return IGNORE_ALARM;
+    }
+    if (state.isCurrentLoop) {
+        return IGNORE_REPEAT;
+    }
+    if ((state.currentUsage != usage) && (usage == USAGE_UNKNOWN)) {
+        return IGNORE_UNKNOWN;
+    }
+    return VIBRATION;
+}
+}  // namespace
+
+class VibrationAdmissionPolicyTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: AdmissionTableTest_001
+ * @tc.desc: Every entry of the admission table matches the reference priority rules
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationAdmissionPolicyTest, AdmissionTableTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("AdmissionTableTest_001 in");
+    size_t checked = 0;
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        for (int32_t currentUsage = 0; currentUsage < USAGE_MAX; ++currentUsage) {
+            for (uint32_t flags = 0; flags < (1U << 5); ++flags) {
+                AdmissionState state;
+                state.usage = usage;
+                state.currentUsage = currentUsage;
+                state.isLoop = ((flags & 1U) != 0);
+                state.isVibrating = ((flags & 2U) != 0);
+                state.isCurrentLoop = state.isVibrating && ((flags & 4U) != 0);
+                state.isRingerSilent = ((flags & 8U) != 0);
+                state.isFeedbackOff = ((flags & 16U) != 0);
+                ASSERT_EQ(LookupAdmission(state), ReferenceAdmission(state)) << "usage:" << usage <<
+                    ", current usage:" << currentUsage << ", flags:" << flags;
+                ++checked;
+            }
+        }
+    }
+    ASSERT_GT(checked, ADMISSION_TABLE_SIZE);
+}
+
+/**
+ * @tc.name: AdmissionTableTest_002
+ * @tc.desc: Every combination maps to its own table entry
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationAdmissionPolicyTest, AdmissionTableTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("AdmissionTableTest_002 in");
+    std::vector<bool> visited(ADMISSION_TABLE_SIZE, false);
+    for (int32_t usage = 0; usage < USAGE_MAX; ++usage) {
+        for (size_t current = 0; current < ADMISSION_CURRENT_STATES; ++current) {
+            for (uint32_t flags = 0; flags < (1U << 3); ++flags) {
+                AdmissionState state;
+                state.usage = usage;
+                state.isVibrating = (current != 0);
+                state.currentUsage = state.isVibrating ? static_cast<int32_t>((current - 1) / 2) : USAGE_UNKNOWN;
+                state.isCurrentLoop = state.isVibrating && (((current - 1) % 2) != 0);
+                state.isLoop = ((flags & 1U) != 0);
+                state.isRingerSilent = ((flags & 2U) != 0);
+                state.isFeedbackOff = ((flags & 4U) != 0);
+                size_t index = GetAdmissionIndex(state);
+                ASSERT_LT(index, ADMISSION_TABLE_SIZE);
+                ASSERT_FALSE(visited[index]);
+                visited[index] = true;
+            }
+        }
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
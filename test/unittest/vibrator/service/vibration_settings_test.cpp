@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "sensors_errors.h"
+#include "vibration_admission_policy.h"
+#include "vibration_settings.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibrationSettingsTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr int32_t SLOW_LOAD_MS = 200;
+constexpr int32_t WAIT_STEP_MS = 10;
+constexpr int32_t WAIT_TIMEOUT_MS = 3000;
+
+// Admission of an idle vibrator against the settings, as the priority manager decides it.
+VibrateStatus AdmitIdle(const VibrationSettings &settings, int32_t usage)
+{
+    SettingsSnapshot snapshot = settings.Get();
+    AdmissionState state;
+    state.usage = usage;
+    state.isRingerSilent = (snapshot.ringerMode == RINGER_MODE_SILENT);
+    state.isFeedbackOff = (snapshot.feedback == FEEDBACK_MODE_OFF);
+    return LookupAdmission(state);
+}
+
+template<typename Predicate>
+bool WaitFor(Predicate predicate)
+{
+    for (int32_t waited = 0; waited < WAIT_TIMEOUT_MS; waited += WAIT_STEP_MS) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_STEP_MS));
+    }
+    return predicate();
+}
+}  // namespace
+
+class VibrationSettingsTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: VibrationSettingsTest_001
+ * @tc.desc: A vibration issued right after Start in silent mode is ignored, even when the load is slow
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationSettingsTest, VibrationSettingsTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("VibrationSettingsTest_001 in");
+    VibrationSettings settings([](SettingsSnapshot &snapshot) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(SLOW_LOAD_MS));
+        snapshot.ringerMode = RINGER_MODE_SILENT;
+        snapshot.feedback = FEEDBACK_MODE_OFF;
+        return ERR_OK;
+    });
+    ASSERT_EQ(settings.Start(), ERR_OK);
+    ASSERT_EQ(AdmitIdle(settings, USAGE_RING), IGNORE_RINGER_MODE);
+    ASSERT_EQ(AdmitIdle(settings, USAGE_NOTIFICATION), IGNORE_RINGER_MODE);
+    ASSERT_EQ(AdmitIdle(settings, USAGE_TOUCH), IGNORE_FEEDBACK);
+}
+
+/**
+ * @tc.name: VibrationSettingsTest_002
+ * @tc.desc: Before any load succeeds the defaults apply, and a failed first load is retried in background
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationSettingsTest, VibrationSettingsTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("VibrationSettingsTest_002 in");
+    std::atomic<int32_t> loadCount = 0;
+    VibrationSettings settings([&loadCount](SettingsSnapshot &snapshot) {
+        if (++loadCount == 1) {
+            snapshot.ringerMode = RINGER_MODE_SILENT;
+            return MISC_NO_INIT_ERR;
+        }
+        snapshot.ringerMode = RINGER_MODE_SILENT;
+        return ERR_OK;
+    });
+    ASSERT_EQ(settings.Start(), MISC_NO_INIT_ERR);
+    SettingsSnapshot snapshot = settings.Get();
+    ASSERT_EQ(snapshot.ringerMode, RINGER_MODE_NORMAL);
+    ASSERT_EQ(snapshot.feedback, FEEDBACK_MODE_ON);
+    ASSERT_EQ(AdmitIdle(settings, USAGE_RING), VIBRATION);
+    ASSERT_TRUE(WaitFor([&settings] { return AdmitIdle(settings, USAGE_RING) == IGNORE_RINGER_MODE; }));
+    ASSERT_EQ(loadCount.load(), 2);
+}
+
+/**
+ * @tc.name: VibrationSettingsTest_003
+ * @tc.desc: A refresh request reloads the settings on the worker
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibrationSettingsTest, VibrationSettingsTest_003, TestSize.Level1)
+{
+    MISC_HILOGI("VibrationSettingsTest_003 in");
+    std::atomic<int32_t> ringerMode = RINGER_MODE_NORMAL;
+    VibrationSettings settings([&ringerMode](SettingsSnapshot &snapshot) {
+        snapshot.ringerMode = ringerMode.load();
+        return ERR_OK;
+    });
+    ASSERT_EQ(settings.Start(), ERR_OK);
+    ASSERT_EQ(AdmitIdle(settings, USAGE_ALARM), VIBRATION);
+    ringerMode = RINGER_MODE_SILENT;
+    settings.RequestRefresh();
+    ASSERT_TRUE(WaitFor([&settings] { return AdmitIdle(settings, USAGE_ALARM) == IGNORE_RINGER_MODE; }));
+    settings.Stop();
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "binary_haptic_format.h"
+#include "binary_vibrator_decoder.h"
+#include "default_vibrator_stream_decoder.h"
+#include "haptic_decoder_test_utils.h"
+#include "he_vibrator_stream_decoder.h"
+#include "sensors_errors.h"
+#include "vibrator_decoder_creator.h"
+#include "vibrator_decoder_registry.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorDecoderRegistryTest"
+
+namespace OHOS {
+namespace Sensors {
+using namespace testing::ext;
+
+namespace {
+constexpr size_t PADDING_SIZE = 37;
+}  // namespace
+
+class VibratorDecoderRegistryTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: VibratorDecoderRegistryTest_001
+ * @tc.desc: The registry picks the decoder from the content of an offset window, whatever the file is called
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorDecoderRegistryTest, VibratorDecoderRegistryTest_001, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorDecoderRegistryTest_001 in");
+    HEVibratorStreamDecoder stream;
+    VibratePackage textPackage;
+    ASSERT_EQ(stream.DecodeBuffer(HE_SEEDS[0], textPackage), SUCCESS);
+    std::vector<uint8_t> buffer;
+    ASSERT_EQ(EncodeBinaryHaptic(textPackage, buffer), SUCCESS);
+    const std::string padding(PADDING_SIZE, '#');
+    VibratorDecoderCreator::RegisterDecoders();
+    auto &registry = VibratorDecoderRegistry::GetInstance();
+    auto checkContent = [&registry, &padding](const std::string &content, auto *expected) {
+        TestFile file(padding + content + padding);
+        ASSERT_GE(file.GetRawFd().fd, 0);
+        RawFileDescriptor window = { .fd = file.GetRawFd().fd, .offset = static_cast<int64_t>(padding.size()),
+            .length = static_cast<int64_t>(content.size()) };
+        std::unique_ptr<IVibratorDecoder> decoder(registry.CreateDecoder(window));
+        ASSERT_NE(decoder, nullptr) << content;
+        ASSERT_NE(dynamic_cast<decltype(expected)>(decoder.get()), nullptr) << content;
+        VibratePackage pkg;
+        ASSERT_EQ(decoder->DecodeEffect(window, pkg), SUCCESS) << content;
+    };
+    for (const auto &seed : JSON_SEEDS) {
+        checkContent(seed, static_cast<DefaultVibratorStreamDecoder *>(nullptr));
+    }
+    for (const auto &seed : HE_SEEDS) {
+        checkContent(seed, static_cast<HEVibratorStreamDecoder *>(nullptr));
+    }
+    checkContent(std::string(buffer.begin(), buffer.end()), static_cast<BinaryVibratorDecoder *>(nullptr));
+    ASSERT_EQ(registry.CreateDecoder(std::string_view("{\"MetaData\":{\"Version\":1}}")), nullptr);
+    std::unique_ptr<IVibratorDecoder> cutShort(registry.CreateDecoder(std::string_view("{\"Channels\":[{\"Pa")));
+    ASSERT_NE(dynamic_cast<DefaultVibratorStreamDecoder *>(cutShort.get()), nullptr);
+    ASSERT_EQ(registry.CreateDecoder(std::string_view("OHH")), nullptr);
+}
+
+/**
+ * @tc.name: VibratorDecoderRegistryTest_002
+ * @tc.desc: Without a match in the probe head, the registry probes the whole window and then uses the extension
+ * @tc.type: FUNC
+ */
+HWTEST_F(VibratorDecoderRegistryTest, VibratorDecoderRegistryTest_002, TestSize.Level1)
+{
+    MISC_HILOGI("VibratorDecoderRegistryTest_002 in");
+    VibratorDecoderCreator::RegisterDecoders();
+    auto &registry = VibratorDecoderRegistry::GetInstance();
+    std::string description(VibratorDecoderRegistry::PROBE_SIZE, 'a');
+    std::string lateKey = R"({"MetaData":{"Description":")" + description + R"(","Version":1,"ChannelNumber":1},)" +
+        JSON_SEEDS[0].substr(JSON_SEEDS[0].find("\"Channels\""));
+    TestFile lateKeyFile(lateKey);
+    ASSERT_GE(lateKeyFile.GetRawFd().fd, 0);
+    std::unique_ptr<IVibratorDecoder> lateKeyDecoder(registry.CreateDecoder(lateKeyFile.GetRawFd()));
+    ASSERT_NE(dynamic_cast<DefaultVibratorStreamDecoder *>(lateKeyDecoder.get()), nullptr);
+    VibratePackage pkg;
+    ASSERT_EQ(lateKeyDecoder->DecodeEffect(lateKeyFile.GetRawFd(), pkg), SUCCESS);
+    const std::string unknown = R"({"Metadata":{"Version":1}})";
+    TestFile heFile(unknown, TEST_FILE_PATH + ".he");
+    ASSERT_GE(heFile.GetRawFd().fd, 0);
+    std::unique_ptr<IVibratorDecoder> heDecoder(registry.CreateDecoder(heFile.GetRawFd()));
+    ASSERT_NE(dynamic_cast<HEVibratorStreamDecoder *>(heDecoder.get()), nullptr);
+    TestFile noExtensionFile(unknown);
+    ASSERT_GE(noExtensionFile.GetRawFd().fd, 0);
+    ASSERT_EQ(registry.CreateDecoder(noExtensionFile.GetRawFd()), nullptr);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ARRAY_VIEW_H
+#define ARRAY_VIEW_H
+
+#include <cstddef>
+
+namespace OHOS {
+namespace Sensors {
+// Non-owning view of a contiguous run of T, the subset of std::span the service needs.
+template<typename T>
+class ArrayView {
+public:
+    ArrayView() = default;
+    ArrayView(const T *data, size_t size) : data_(data), size_(size) {}
+    ~ArrayView() = default;
+    const T *begin() const
+    {
+        return data_;
+    }
+    const T *end() const
+    {
+        return data_ + size_;
+    }
+    const T &operator[](size_t index) const
+    {
+        return data_[index];
+    }
+    const T &front() const
+    {
+        return data_[0];
+    }
+    const T &back() const
+    {
+        return data_[size_ - 1];
+    }
+    const T *data() const
+    {
+        return data_;
+    }
+    size_t size() const
+    {
+        return size_;
+    }
+    bool empty() const
+    {
+        return (size_ == 0);
+    }
+
+private:
+    const T *data_ = nullptr;
+    size_t size_ = 0;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // ARRAY_VIEW_H
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CAPABILITY_PAGE_H
+#define CAPABILITY_PAGE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "light_info_ipc.h"
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+constexpr uint32_t CAPABILITY_PAGE_MAGIC = 0x4353494D;
+constexpr uint32_t CAPABILITY_PAGE_VERSION = 1;
+constexpr size_t CAPABILITY_NAME_SIZE = 64;
+constexpr size_t MAX_CAPABILITY_EFFECT_COUNT = 64;
+constexpr size_t MAX_CAPABILITY_LIGHT_COUNT = 16;
+
+struct EffectCapability {
+    int32_t duration = 0;
+    bool isSupportEffect = false;
+};
+
+struct CapabilitySnapshot {
+    uint32_t generation = 0;
+    VibratorCapacity capacity;
+    bool hasDelayTime = false;
+    int32_t delayTime = 0;
+    std::unordered_map<std::string, EffectCapability> effects;
+    std::vector<LightInfoIPC> lights;
+};
+
+struct CapabilityEffectEntry {
+    char name[CAPABILITY_NAME_SIZE];
+    int32_t duration;
+    int32_t isSupportEffect;
+};
+
+struct CapabilityLightEntry {
+    char name[CAPABILITY_NAME_SIZE];
+    int32_t lightId;
+    int32_t lightNumber;
+    int32_t lightType;
+    int32_t reserved;
+};
+
+struct CapabilityPageBody {
+    int32_t isSupportHdHaptic;
+    int32_t isSupportPresetMapping;
+    int32_t isSupportTimeDelay;
+    int32_t hasDelayTime;
+    int32_t delayTime;
+    uint32_t effectCount;
+    uint32_t lightCount;
+    CapabilityEffectEntry effects[MAX_CAPABILITY_EFFECT_COUNT];
+    CapabilityLightEntry lights[MAX_CAPABILITY_LIGHT_COUNT];
+};
+
+/*
+ * Layout of the read-only page the service shares with every client. generation is odd
+ * while the service rewrites the body and grows on each publish, so a reader can detect
+ * both a torn copy and a cached view that an HDI reconnect has made stale.
+ */
+struct CapabilityPageLayout {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> generation;
+    CapabilityPageBody body;
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Generation must be lock free across processes");
+
+void WriteCapabilityPage(CapabilityPageLayout &page, const CapabilitySnapshot &snapshot);
+std::optional<CapabilitySnapshot> ReadCapabilityPage(const CapabilityPageLayout &page);
+uint32_t GetCapabilityPageGeneration(const CapabilityPageLayout &page);
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // CAPABILITY_PAGE_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <string>
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Handle to a string stored once in a process-wide table. Copies are pointer copies and
+ * equality is pointer equality. Interned strings live until the process exits.
+ */
+class InternedString {
+public:
+    InternedString();
+    ~InternedString() = default;
+    static InternedString Intern(const std::string &value);
+    const std::string &Str() const
+    {
+        return *value_;
+    }
+    // Same spelling as std::string so log sites read the same for both.
+    const char *c_str() const
+    {
+        return value_->c_str();
+    }
+    bool Empty() const
+    {
+        return value_->empty();
+    }
+    bool operator==(const InternedString &other) const
+    {
+        return value_ == other.value_;
+    }
+    bool operator!=(const InternedString &other) const
+    {
+        return value_ != other.value_;
+    }
+
+private:
+    explicit InternedString(const std::string *value) : value_(value) {}
+    const std::string *value_;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // INTERNED_STRING_H
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JSON_STREAM_READER_H
+#define JSON_STREAM_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "sensors_errors.h"
+
+namespace OHOS {
+namespace Sensors {
+enum class JsonValueType {
+    INVALID = 0,
+    OBJECT,
+    ARRAY,
+    STRING,
+    NUMBER,
+    BOOLEAN,
+    NULL_VALUE,
+};
+
+/*
+ * Single-pass pull tokenizer over an in-memory JSON document. It accepts exactly what
+ * cJSON_ParseWithLength accepts (lenient whitespace, leading BOM, trailing data after the
+ * root value, the same nesting limit, numbers cut at 63 characters as in cJSON releases that
+ * parse numbers through a fixed 64-byte buffer), so decoders built on it agree with the cJSON based
+ * ones. Every read method returns false on a syntax error, after which the reader must
+ * not be used again.
+ */
+class JsonStreamReader {
+public:
+    explicit JsonStreamReader(std::string_view data, size_t depth = 0);
+    ~JsonStreamReader() = default;
+    JsonValueType PeekType();
+    bool EnterObject();
+    // Sets hasMember to false once the closing brace has been consumed.
+    bool NextMember(std::string &key, bool &hasMember);
+    bool EnterArray();
+    // Sets hasElement to false once the closing bracket has been consumed.
+    bool NextElement(bool &hasElement);
+    bool ReadNumber(double &value);
+    bool ReadString(std::string &value);
+    bool SkipValue();
+    // Skips the next value and returns its raw text, so that it can be replayed later.
+    bool CaptureValue(std::string_view &raw);
+    size_t GetDepth() const;
+    // Enters the next object and hands every key to onMember, which must consume the value.
+    template<typename Callback>
+    int32_t ForEachMember(Callback &&onMember);
+    // Enters the next array and hands every index to onElement, which must consume the value.
+    template<typename Callback>
+    int32_t ForEachElement(Callback &&onElement);
+    static bool KeyEquals(const std::string &key, const char *name);
+    // True when one of names is a member of the root object before the first syntax error or the end of data,
+    // so it also works on a document cut short by a probe window.
+    static bool HasRootMember(std::string_view data, std::initializer_list<const char *> names);
+    static int32_t ToInt(double value);
+
+private:
+    void SkipWhitespace();
+    bool ParseString(std::string *value);
+    uint32_t ParseHex4(size_t offset) const;
+    bool NextMemberKey(std::string *key, bool &hasMember);
+    bool ParseLiteral();
+    bool EnterContainer(char open, bool isObject);
+    std::string_view data_;
+    size_t pos_ = 0;
+    size_t depth_ = 0;
+    bool first_ = false;
+    std::vector<bool> containers_;
+};
+
+template<typename Callback>
+int32_t JsonStreamReader::ForEachMember(Callback &&onMember)
+{
+    if (!EnterObject()) {
+        return ERROR;
+    }
+    std::string key;
+    bool hasMember = false;
+    while (true) {
+        if (!NextMember(key, hasMember)) {
+            return ERROR;
+        }
+        if (!hasMember) {
+            return SUCCESS;
+        }
+        int32_t ret = onMember(key);
+        if (ret != SUCCESS) {
+            return ret;
+        }
+    }
+}
+
+template<typename Callback>
+int32_t JsonStreamReader::ForEachElement(Callback &&onElement)
+{
+    if (!EnterArray()) {
+        return ERROR;
+    }
+    bool hasElement = false;
+    for (size_t index = 0;; ++index) {
+        if (!NextElement(hasElement)) {
+            return ERROR;
+        }
+        if (!hasElement) {
+            return SUCCESS;
+        }
+        int32_t ret = onElement(index);
+        if (ret != SUCCESS) {
+            return ret;
+        }
+    }
+}
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // JSON_STREAM_READER_H
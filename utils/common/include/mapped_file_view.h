@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MAPPED_FILE_VIEW_H
+#define MAPPED_FILE_VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "raw_file_descriptor.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Read-only view of the (offset, length) window of a caller-owned fd. The window is
+ * mapped only when the fd is trusted or is a memfd sealed against shrinking, and read
+ * with pread otherwise; the fd is never closed, duplicated or repositioned, so the caller
+ * can keep using it afterwards.
+ */
+class MappedFileView {
+public:
+    MappedFileView() = default;
+    ~MappedFileView();
+    MappedFileView(const MappedFileView &) = delete;
+    MappedFileView &operator=(const MappedFileView &) = delete;
+    // trustedFd: no other process can truncate the file while it is mapped, e.g. the client
+    // decoding its own file. Fds received over IPC must not be marked trusted.
+    int32_t Map(const RawFileDescriptor &rawFd, bool trustedFd = false);
+    void Unmap();
+    std::string_view GetData() const;
+
+private:
+    int32_t MapWindow(const RawFileDescriptor &rawFd);
+    int32_t ReadWindow(const RawFileDescriptor &rawFd);
+    void *mapAddr_ = nullptr;
+    size_t mapSize_ = 0;
+    std::string buffer_;
+    std::string_view data_;
+};
+
+int32_t PreadFully(int32_t fd, int64_t offset, char *buf, size_t length);
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // MAPPED_FILE_VIEW_H
@@ -92,6 +92,8 @@ enum {
     MISC_NO_INIT_ERR = MISC_NATIVE_SAM_ERR + 1,
     MISC_INVALID_OPERATION_ERR = MISC_NO_INIT_ERR + 1,
     MISC_NAME_NOT_FOUND_ERR = MISC_INVALID_OPERATION_ERR + 1,
+    MISC_NATIVE_SERVICE_UNAVAILABLE_ERR = MISC_NAME_NOT_FOUND_ERR + 1,
+    MISC_NATIVE_REQUEST_DEFERRED = MISC_NATIVE_SERVICE_UNAVAILABLE_ERR + 1,
 };
 
 class InnerFunctionTracer {
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATE_PACKAGE_CHECKER_H
+#define VIBRATE_PACKAGE_CHECKER_H
+
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Value checks for decoded effects that did not come through a JSON decoder, such as binary
+ * containers and packages registered over IPC. The ranges are the union of what the .json and
+ * .he decoders accept, so anything they produce passes.
+ */
+class VibratePackageChecker {
+public:
+    VibratePackageChecker() = default;
+    ~VibratePackageChecker() = default;
+    static bool CheckPackage(const VibratePackage &package);
+    static bool CheckPattern(const VibratePattern &pattern);
+    static bool CheckEvent(const VibrateEvent &event);
+
+private:
+    static bool CheckCurve(const VibrateEvent &event);
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATE_PACKAGE_CHECKER_H
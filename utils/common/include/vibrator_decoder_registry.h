@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIBRATOR_DECODER_REGISTRY_H
+#define VIBRATOR_DECODER_REGISTRY_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "raw_file_descriptor.h"
+
+namespace OHOS {
+namespace Sensors {
+class IVibratorDecoder;
+// Returns true when head, the first bytes of the effect window, belongs to the decoder's format.
+using VibratorDecoderProbe = bool (*)(std::string_view head);
+using VibratorDecoderCreate = IVibratorDecoder *(*)();
+
+/*
+ * Picks a haptic decoder from the content of the (offset, length) window instead of the
+ * file name, so memfds and asset-packed effects work too. Decoder libraries export a
+ * Register*Decoder function that VibratorDecoderCreator calls in a fixed order; selection
+ * reads the head of the window once and asks the probes in that order. When no probe
+ * matches the head, the whole window is probed, and then the file extension decides.
+ */
+class VibratorDecoderRegistry {
+public:
+    static constexpr size_t PROBE_SIZE = 4096;
+    // Largest window probed in full, the size cap shared by every haptic file format.
+    static constexpr size_t FULL_PROBE_MAX_SIZE = 64 * 1024;
+    static VibratorDecoderRegistry &GetInstance();
+    void Register(const char *name, const char *extension, VibratorDecoderProbe probe, VibratorDecoderCreate create);
+    IVibratorDecoder *CreateDecoder(const RawFileDescriptor &rawFd) const;
+    IVibratorDecoder *CreateDecoder(std::string_view head) const;
+    IVibratorDecoder *CreateDecoderByExtension(const std::string &extension) const;
+
+private:
+    VibratorDecoderRegistry() = default;
+    ~VibratorDecoderRegistry() = default;
+    struct Entry {
+        const char *name = nullptr;
+        const char *extension = nullptr;
+        VibratorDecoderProbe probe = nullptr;
+        VibratorDecoderCreate create = nullptr;
+    };
+    mutable std::mutex entriesMutex_;
+    std::vector<Entry> entries_;
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // VIBRATOR_DECODER_REGISTRY_H
@@ -16,21 +16,46 @@
 #ifndef VIBRATOR_INFOS_H
 #define VIBRATOR_INFOS_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "parcel.h"
+
+#include "array_view.h"
+#include "interned_string.h"
 namespace OHOS {
 namespace Sensors {
+// Per-pattern limits of the HDI; the decoders split longer effects into several patterns.
 constexpr int32_t MAX_EVENT_SIZE = 16;
 constexpr int32_t MAX_POINT_SIZE = 16;
+constexpr int32_t MAX_PATTERN_SIZE = 1024;
+// Events one PlayPattern request may carry; the service splits it into patterns of MAX_EVENT_SIZE.
+constexpr int32_t MAX_PATTERN_WIRE_EVENT_SIZE = 4096;
+constexpr uint32_t PATTERN_WIRE_VERSION = 1;
 const std::string VIBRATE_BUTT = "butt";
 const std::string VIBRATE_TIME = "time";
 const std::string VIBRATE_PRESET = "preset";
 const std::string VIBRATE_CUSTOM_HD = "custom.hd";
 const std::string VIBRATE_CUSTOM_COMPOSITE_EFFECT = "custom.composite.effect";
 const std::string VIBRATE_CUSTOM_COMPOSITE_TIME = "custom.composite.time";
+const std::string VIBRATE_PRIMITIVE = "primitive";
+
+enum class VibrateMode : int32_t {
+    BUTT = 0,
+    TIME,
+    PRESET,
+    CUSTOM_HD,
+    CUSTOM_COMPOSITE_EFFECT,
+    CUSTOM_COMPOSITE_TIME,
+    PRIMITIVE,
+};
+
+const std::string &GetVibrateModeName(VibrateMode mode);
+VibrateMode ParseVibrateMode(const std::string &name);
 
 enum VibrateUsage {
     USAGE_UNKNOWN = 0,
@@ -82,6 +107,38 @@ struct VibrateEvent {
     std::vector<VibrateCurvePoint> points;
 };
 
+/*
+ * Packed wire layout of a VibratePattern: one header, eventCount event records, then the
+ * curve points of every event in event order. Bump PATTERN_WIRE_VERSION on any change.
+ */
+struct PatternWireHeader {
+    uint32_t version = PATTERN_WIRE_VERSION;
+    int32_t startTime = 0;
+    int32_t patternDuration = 0;
+    uint32_t eventCount = 0;
+    uint32_t pointCount = 0;
+};
+
+struct EventWireRecord {
+    int32_t tag = 0;
+    int32_t time = 0;
+    int32_t duration = 0;
+    int32_t intensity = 0;
+    int32_t frequency = 0;
+    int32_t index = 0;
+    uint32_t pointCount = 0;
+};
+
+struct CurvePointWireRecord {
+    int32_t time = 0;
+    int32_t intensity = 0;
+    int32_t frequency = 0;
+};
+
+// Over the 32KB inline limit of MessageParcel::WriteRawData, so long patterns travel in ashmem.
+constexpr size_t MAX_PATTERN_WIRE_SIZE = sizeof(PatternWireHeader) +
+    MAX_PATTERN_WIRE_EVENT_SIZE * (sizeof(EventWireRecord) + MAX_POINT_SIZE * sizeof(CurvePointWireRecord));
+
 struct VibratePattern {
     bool operator<(const VibratePattern &rhs) const
     {
@@ -91,6 +148,8 @@ struct VibratePattern {
     int32_t patternDuration = 0;
     std::vector<VibrateEvent> events;
     void Dump() const;
+    bool Encode(std::vector<uint8_t> &buffer) const;
+    std::optional<VibratePattern> Decode(const uint8_t *buffer, size_t size);
     bool Marshalling(Parcel &parcel) const;
     std::optional<VibratePattern> Unmarshalling(Parcel &data);
 };
@@ -99,6 +158,52 @@ struct VibratePackage {
     std::vector<VibratePattern> patterns;
     int32_t packageDuration = 0;
     void Dump() const;
+    bool Marshalling(Parcel &parcel) const;
+    std::optional<VibratePackage> Unmarshalling(Parcel &data);
+};
+
+struct FlatVibrateEvent {
+    VibrateTag tag = EVENT_TAG_UNKNOWN;
+    int32_t time = 0;
+    int32_t duration = 0;
+    int32_t intensity = 0;
+    int32_t frequency = 0;
+    int32_t index = 0;
+    uint32_t firstPoint = 0;
+    uint32_t pointCount = 0;
+};
+
+struct FlatVibratePattern {
+    int32_t startTime = 0;
+    int32_t patternDuration = 0;
+    uint32_t firstEvent = 0;
+    uint32_t eventCount = 0;
+};
+
+/*
+ * VibratePackage flattened into three arrays: patterns own a range of events and events a
+ * range of the shared point pool. Flatten sizes every array once, so a package costs three
+ * allocations however many events it has, and copying it costs the same. The service keeps
+ * effects in this form from decoding to the HDI call.
+ */
+struct FlatVibratePackage {
+    int32_t packageDuration = 0;
+    // FNV-1a of the package as flattened; copies and parameter merges keep the value of their source.
+    uint64_t contentHash = 0;
+    std::vector<FlatVibratePattern> patterns;
+    std::vector<FlatVibrateEvent> events;
+    std::vector<VibrateCurvePoint> points;
+    static FlatVibratePackage Flatten(const VibratePackage &package);
+    /*
+     * Splits a pattern played on its own into patterns of at most eventCapacity events in time
+     * order. The first starts at 0 with the event times unchanged; each later one starts at the
+     * time of its first event, and its event times count from there.
+     */
+    static FlatVibratePackage Flatten(const VibratePattern &pattern, size_t eventCapacity);
+    ArrayView<FlatVibrateEvent> GetEvents(const FlatVibratePattern &pattern) const;
+    ArrayView<VibrateCurvePoint> GetPoints(const FlatVibrateEvent &event) const;
+    size_t GetHeapBytes() const;
+    void Dump() const;
 };
 
 struct VibratorCapacity {
@@ -119,15 +224,17 @@ struct VibrateSlice {
 };
 
 struct VibrateInfo {
-    std::string mode;
-    std::string packageName;
+    VibrateMode mode = VibrateMode::BUTT;
+    InternedString packageName;
     int32_t pid = -1;
     int32_t uid = -1;
     int32_t usage = 0;
     int32_t duration = 0;
     std::string effect;
     int32_t count = 0;
-    VibratePackage package;
+    int32_t intensity = 0;
+    // Shared with the decoded-effect cache or a registered handle unless parameters were merged into it.
+    std::shared_ptr<const FlatVibratePackage> package = nullptr;
 };
 
 struct VibrateParameter {
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "capability_page.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "CapabilityPage"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int32_t MAX_READ_RETRY = 8;
+
+void CopyName(const std::string &source, char (&target)[CAPABILITY_NAME_SIZE])
+{
+    size_t length = std::min(source.size(), CAPABILITY_NAME_SIZE - 1);
+    std::copy_n(source.data(), length, target);
+    target[length] = '\0';
+}
+
+std::string LoadName(const char (&source)[CAPABILITY_NAME_SIZE])
+{
+    return std::string(source, strnlen(source, CAPABILITY_NAME_SIZE));
+}
+
+void FillBody(const CapabilitySnapshot &snapshot, CapabilityPageBody &body)
+{
+    body = {};
+    body.isSupportHdHaptic = snapshot.capacity.isSupportHdHaptic ? 1 : 0;
+    body.isSupportPresetMapping = snapshot.capacity.isSupportPresetMapping ? 1 : 0;
+    body.isSupportTimeDelay = snapshot.capacity.isSupportTimeDelay ? 1 : 0;
+    body.hasDelayTime = snapshot.hasDelayTime ? 1 : 0;
+    body.delayTime = snapshot.delayTime;
+    for (const auto &[name, effect] : snapshot.effects) {
+        if ((body.effectCount >= MAX_CAPABILITY_EFFECT_COUNT) || (name.size() >= CAPABILITY_NAME_SIZE)) {
+            MISC_HILOGW("Effect not published, effect:%{public}s", name.c_str());
+            continue;
+        }
+        CapabilityEffectEntry &entry = body.effects[body.effectCount++];
+        CopyName(name, entry.name);
+        entry.duration = effect.duration;
+        entry.isSupportEffect = effect.isSupportEffect ? 1 : 0;
+    }
+    for (const auto &light : snapshot.lights) {
+        if (body.lightCount >= MAX_CAPABILITY_LIGHT_COUNT) {
+            MISC_HILOGW("Light not published, lightId:%{public}d", light.GetLightId());
+            continue;
+        }
+        CapabilityLightEntry &entry = body.lights[body.lightCount++];
+        CopyName(light.GetLightName(), entry.name);
+        entry.lightId = light.GetLightId();
+        entry.lightNumber = light.GetLightNumber();
+        entry.lightType = light.GetLightType();
+    }
+}
+
+std::optional<CapabilitySnapshot> ParseBody(const CapabilityPageBody &body)
+{
+    if ((body.effectCount > MAX_CAPABILITY_EFFECT_COUNT) || (body.lightCount > MAX_CAPABILITY_LIGHT_COUNT)) {
+        MISC_HILOGE("Invalid capability page, effectCount:%{public}u, lightCount:%{public}u",
+            body.effectCount, body.lightCount);
+        return std::nullopt;
+    }
+    CapabilitySnapshot snapshot;
+    snapshot.capacity.isSupportHdHaptic = (body.isSupportHdHaptic != 0);
+    snapshot.capacity.isSupportPresetMapping = (body.isSupportPresetMapping != 0);
+    snapshot.capacity.isSupportTimeDelay = (body.isSupportTimeDelay != 0);
+    snapshot.hasDelayTime = (body.hasDelayTime != 0);
+    snapshot.delayTime = body.delayTime;
+    for (uint32_t i = 0; i < body.effectCount; ++i) {
+        const CapabilityEffectEntry &entry = body.effects[i];
+        snapshot.effects[LoadName(entry.name)] = {
+            .duration = entry.duration,
+            .isSupportEffect = (entry.isSupportEffect != 0),
+        };
+    }
+    for (uint32_t i = 0; i < body.lightCount; ++i) {
+        const CapabilityLightEntry &entry = body.lights[i];
+        LightInfoIPC light;
+        light.SetLightName(LoadName(entry.name));
+        light.SetLightId(entry.lightId);
+        light.SetLightNumber(entry.lightNumber);
+        light.SetLightType(entry.lightType);
+        snapshot.lights.push_back(light);
+    }
+    return snapshot;
+}
+}  // namespace
+
+void WriteCapabilityPage(CapabilityPageLayout &page, const CapabilitySnapshot &snapshot)
+{
+    CapabilityPageBody body;
+    FillBody(snapshot, body);
+    uint32_t generation = page.generation.load(std::memory_order_relaxed);
+    if ((generation & 1) != 0) {
+        ++generation;
+    }
+    page.magic = CAPABILITY_PAGE_MAGIC;
+    page.version = CAPABILITY_PAGE_VERSION;
+    page.generation.store(generation + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&page.body, &body, sizeof(body));
+    page.generation.store(generation + 2, std::memory_order_release);
+}
+
+std::optional<CapabilitySnapshot> ReadCapabilityPage(const CapabilityPageLayout &page)
+{
+    if ((page.magic != CAPABILITY_PAGE_MAGIC) || (page.version != CAPABILITY_PAGE_VERSION)) {
+        MISC_HILOGE("Unsupported capability page, magic:%{public}u, version:%{public}u", page.magic, page.version);
+        return std::nullopt;
+    }
+    CapabilityPageBody body;
+    for (int32_t retry = 0; retry < MAX_READ_RETRY; ++retry) {
+        uint32_t before = page.generation.load(std::memory_order_acquire);
+        if ((before & 1) != 0) {
+            continue;
+        }
+        std::memcpy(&body, &page.body, sizeof(body));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (page.generation.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+        std::optional<CapabilitySnapshot> snapshot = ParseBody(body);
+        if (snapshot.has_value()) {
+            snapshot->generation = before;
+        }
+        return snapshot;
+    }
+    MISC_HILOGW("Capability page is being rewritten, retry later");
+    return std::nullopt;
+}
+
+uint32_t GetCapabilityPageGeneration(const CapabilityPageLayout &page)
+{
+    return page.generation.load(std::memory_order_acquire);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -16,9 +16,11 @@
 
 #include <cerrno>
 #include <cinttypes>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "mapped_file_view.h"
 #include "securec.h"
 #include "sensors_errors.h"
 
@@ -30,7 +32,6 @@ namespace Sensors {
 namespace {
 const std::string CONFIG_DIR = "/vendor/etc/vibrator/";
 constexpr int32_t FILE_SIZE_MAX = 0x5000;
-constexpr int64_t READ_DATA_BUFF_SIZE = 256;
 constexpr int32_t INVALID_FILE_SIZE = -1;
 constexpr int32_t FILE_PATH_MAX = 1024;
 }  // namespace
@@ -62,15 +63,19 @@ std::string ReadJsonFile(const std::string &filePath)
         MISC_HILOGE("File size out of read range");
         return {};
     }
-    FILE *fp = fopen(realPath, "r");
-    CHKPS(fp);
-    std::string dataStr;
-    char buf[READ_DATA_BUFF_SIZE] = { '\0' };
-    while (fgets(buf, sizeof(buf), fp) != nullptr) {
-        dataStr += buf;
+    int32_t fd = open(realPath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        MISC_HILOGE("Open file failed, errno:%{public}d", errno);
+        return {};
     }
-    if (fclose(fp) != 0) {
-        MISC_HILOGW("Close file failed");
+    RawFileDescriptor rawFd = {
+        .fd = fd,
+        .offset = 0,
+        .length = GetFileSize(fd)
+    };
+    std::string dataStr = ReadFd(rawFd);
+    if (close(fd) != 0) {
+        MISC_HILOGW("Close file failed, errno:%{public}d", errno);
     }
     return dataStr;
 }
@@ -194,27 +199,12 @@ std::string ReadFd(const RawFileDescriptor &rawFd)
         MISC_HILOGE("length is invalid, length:%{public}" PRId64, rawFd.length);
         return {};
     }
-    FILE *fp = fdopen(rawFd.fd, "r");
-    CHKPS(fp);
-    if (fseek(fp, rawFd.offset, SEEK_SET) != 0) {
-        MISC_HILOGE("fseek failed, errno:%{public}d", errno);
-        if (fclose(fp) != 0) {
-            MISC_HILOGW("Close file failed, errno:%{public}d", errno);
-        }
+    // pread leaves both the fd and its file position untouched, the caller still owns it.
+    std::string dataStr(static_cast<size_t>(rawFd.length), '\0');
+    if (PreadFully(rawFd.fd, rawFd.offset, dataStr.data(), dataStr.size()) != SUCCESS) {
+        MISC_HILOGE("Read fd failed, fd:%{public}d", rawFd.fd);
         return {};
     }
-    std::string dataStr;
-    char buf[READ_DATA_BUFF_SIZE] = { '\0' };
-    int64_t alreadyRead = 0;
-    while (alreadyRead < rawFd.length) {
-        int64_t onceRead = std::min(rawFd.length - alreadyRead, READ_DATA_BUFF_SIZE - 1);
-        fgets(buf, onceRead + 1, fp);
-        dataStr += buf;
-        alreadyRead = ftell(fp) - rawFd.offset;
-    }
-    if (fclose(fp) != 0) {
-        MISC_HILOGW("Close file failed after read, errno:%{public}d", errno);
-    }
     return dataStr;
 }
 
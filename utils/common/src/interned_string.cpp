@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "interned_string.h"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+// Node based, so element addresses stay valid while the table grows.
+std::unordered_set<std::string> &GetInternTable()
+{
+    static std::unordered_set<std::string> internTable;
+    return internTable;
+}
+
+const std::string &GetEmptyString()
+{
+    static const std::string emptyString;
+    return emptyString;
+}
+
+std::mutex &GetInternMutex()
+{
+    static std::mutex internMutex;
+    return internMutex;
+}
+}  // namespace
+
+InternedString::InternedString() : value_(&GetEmptyString()) {}
+
+InternedString InternedString::Intern(const std::string &value)
+{
+    if (value.empty()) {
+        return InternedString();
+    }
+    std::lock_guard<std::mutex> internLock(GetInternMutex());
+    auto it = GetInternTable().insert(value).first;
+    return InternedString(&*it);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -19,6 +19,7 @@
 #include <unistd.h>
 
 #include "file_utils.h"
+#include "mapped_file_view.h"
 #include "sensors_errors.h"
 
 #undef LOG_TAG
@@ -34,17 +35,18 @@ JsonParser::JsonParser(const std::string &filePath)
         MISC_HILOGE("Read json file fail");
         return;
     }
-    cJson_ = cJSON_Parse(jsonStr.c_str());
+    cJson_ = cJSON_ParseWithLength(jsonStr.data(), jsonStr.size());
 }
 
 JsonParser::JsonParser(const RawFileDescriptor &rawFd)
 {
-    std::string jsonStr = ReadFd(rawFd);
-    if (jsonStr.empty()) {
-        MISC_HILOGE("Read fd fail");
+    MappedFileView view;
+    if (view.Map(rawFd) != SUCCESS) {
+        MISC_HILOGE("Map fd fail");
         return;
     }
-    cJson_ = cJSON_Parse(jsonStr.c_str());
+    std::string_view jsonStr = view.GetData();
+    cJson_ = cJSON_ParseWithLength(jsonStr.data(), jsonStr.size());
 }
 
 JsonParser::~JsonParser()
@@ -0,0 +1,479 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "json_stream_reader.h"
+
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+// Same limit as CJSON_NESTING_LIMIT.
+constexpr size_t NESTING_LIMIT = 1000;
+// Size of the stack buffer cJSON's parse_number copies a number into, including the terminator.
+constexpr size_t NUMBER_BUFFER_SIZE = 64;
+constexpr std::string_view UTF8_BOM = "\xEF\xBB\xBF";
+constexpr size_t ESCAPE_LENGTH = 2;
+constexpr size_t HEX4_LENGTH = 4;
+constexpr size_t UNICODE_ESCAPE_LENGTH = ESCAPE_LENGTH + HEX4_LENGTH;
+constexpr uint32_t HEX_LETTER_BASE = 10;
+constexpr uint32_t HEX_DIGIT_BITS = 4;
+constexpr uint32_t HIGH_SURROGATE_MIN = 0xD800;
+constexpr uint32_t HIGH_SURROGATE_MAX = 0xDBFF;
+constexpr uint32_t LOW_SURROGATE_MIN = 0xDC00;
+constexpr uint32_t LOW_SURROGATE_MAX = 0xDFFF;
+constexpr uint32_t SURROGATE_MASK = 0x3FF;
+constexpr uint32_t SURROGATE_SHIFT = 10;
+constexpr uint32_t SUPPLEMENTARY_BASE = 0x10000;
+constexpr uint32_t CODEPOINT_MAX = 0x10FFFF;
+
+bool IsNumberStart(char c)
+{
+    return (c == '-') || (std::isdigit(static_cast<unsigned char>(c)) != 0);
+}
+
+bool IsNumberChar(char c)
+{
+    return (std::isdigit(static_cast<unsigned char>(c)) != 0) || (c == '+') || (c == '-') || (c == 'e') ||
+        (c == 'E') || (c == '.');
+}
+
+bool DecodeSimpleEscape(char escape, char &out)
+{
+    switch (escape) {
+        case 'b': {
+            out = '\b';
+            return true;
+        }
+        case 'f': {
+            out = '\f';
+            return true;
+        }
+        case 'n': {
+            out = '\n';
+            return true;
+        }
+        case 'r': {
+            out = '\r';
+            return true;
+        }
+        case 't': {
+            out = '\t';
+            return true;
+        }
+        case '\"':
+        case '\\':
+        case '/': {
+            out = escape;
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+void AppendUtf8(std::string &out, uint32_t codepoint)
+{
+    if (codepoint < 0x80) {
+        out.push_back(static_cast<char>(codepoint));
+    } else if (codepoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    }
+}
+}  // namespace
+
+JsonStreamReader::JsonStreamReader(std::string_view data, size_t depth) : data_(data), depth_(depth)
+{
+    if ((depth_ == 0) && (data_.substr(0, UTF8_BOM.size()) == UTF8_BOM)) {
+        pos_ = UTF8_BOM.size();
+    }
+}
+
+void JsonStreamReader::SkipWhitespace()
+{
+    // cJSON treats every byte up to and including the space as whitespace.
+    while ((pos_ < data_.size()) && (static_cast<unsigned char>(data_[pos_]) <= ' ')) {
+        ++pos_;
+    }
+}
+
+JsonValueType JsonStreamReader::PeekType()
+{
+    SkipWhitespace();
+    if (pos_ >= data_.size()) {
+        return JsonValueType::INVALID;
+    }
+    std::string_view rest = data_.substr(pos_);
+    char c = rest[0];
+    if (rest.substr(0, strlen("null")) == "null") {
+        return JsonValueType::NULL_VALUE;
+    }
+    if ((rest.substr(0, strlen("false")) == "false") || (rest.substr(0, strlen("true")) == "true")) {
+        return JsonValueType::BOOLEAN;
+    }
+    if (c == '\"') {
+        return JsonValueType::STRING;
+    }
+    if (IsNumberStart(c)) {
+        return JsonValueType::NUMBER;
+    }
+    if (c == '[') {
+        return JsonValueType::ARRAY;
+    }
+    if (c == '{') {
+        return JsonValueType::OBJECT;
+    }
+    return JsonValueType::INVALID;
+}
+
+bool JsonStreamReader::EnterContainer(char open, bool isObject)
+{
+    SkipWhitespace();
+    if ((depth_ >= NESTING_LIMIT) || (pos_ >= data_.size()) || (data_[pos_] != open)) {
+        return false;
+    }
+    ++pos_;
+    ++depth_;
+    containers_.push_back(isObject);
+    first_ = true;
+    return true;
+}
+
+bool JsonStreamReader::EnterObject()
+{
+    return EnterContainer('{', true);
+}
+
+bool JsonStreamReader::EnterArray()
+{
+    return EnterContainer('[', false);
+}
+
+bool JsonStreamReader::NextMember(std::string &key, bool &hasMember)
+{
+    return NextMemberKey(&key, hasMember);
+}
+
+bool JsonStreamReader::NextMemberKey(std::string *key, bool &hasMember)
+{
+    hasMember = false;
+    SkipWhitespace();
+    if (pos_ >= data_.size()) {
+        return false;
+    }
+    if (data_[pos_] == '}') {
+        first_ = false;
+        ++pos_;
+        --depth_;
+        containers_.pop_back();
+        return true;
+    }
+    if (!first_) {
+        if (data_[pos_] != ',') {
+            return false;
+        }
+        ++pos_;
+        SkipWhitespace();
+    }
+    first_ = false;
+    if (!ParseString(key)) {
+        return false;
+    }
+    SkipWhitespace();
+    if ((pos_ >= data_.size()) || (data_[pos_] != ':')) {
+        return false;
+    }
+    ++pos_;
+    hasMember = true;
+    return true;
+}
+
+bool JsonStreamReader::NextElement(bool &hasElement)
+{
+    hasElement = false;
+    SkipWhitespace();
+    if (pos_ >= data_.size()) {
+        return false;
+    }
+    if (data_[pos_] == ']') {
+        first_ = false;
+        ++pos_;
+        --depth_;
+        containers_.pop_back();
+        return true;
+    }
+    if (!first_) {
+        if (data_[pos_] != ',') {
+            return false;
+        }
+        ++pos_;
+    }
+    first_ = false;
+    hasElement = true;
+    return true;
+}
+
+bool JsonStreamReader::ReadNumber(double &value)
+{
+    SkipWhitespace();
+    if ((pos_ >= data_.size()) || !IsNumberStart(data_[pos_])) {
+        return false;
+    }
+    // Like cJSON, only the first 63 characters of a number are converted; the rest of a longer
+    // number is left in the input, where it is a syntax error.
+    char number[NUMBER_BUFFER_SIZE] = { 0 };
+    size_t length = 0;
+    while ((length < NUMBER_BUFFER_SIZE - 1) && (pos_ + length < data_.size()) &&
+        IsNumberChar(data_[pos_ + length])) {
+        number[length] = data_[pos_ + length];
+        ++length;
+    }
+    char *afterEnd = nullptr;
+    value = strtod(number, &afterEnd);
+    if (afterEnd == number) {
+        return false;
+    }
+    pos_ += static_cast<size_t>(afterEnd - number);
+    return true;
+}
+
+bool JsonStreamReader::ReadString(std::string &value)
+{
+    SkipWhitespace();
+    return ParseString(&value);
+}
+
+uint32_t JsonStreamReader::ParseHex4(size_t offset) const
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < HEX4_LENGTH; ++i) {
+        char c = data_[offset + i];
+        uint32_t digit = 0;
+        if ((c >= '0') && (c <= '9')) {
+            digit = static_cast<uint32_t>(c - '0');
+        } else if ((c >= 'a') && (c <= 'f')) {
+            digit = static_cast<uint32_t>(c - 'a' + HEX_LETTER_BASE);
+        } else if ((c >= 'A') && (c <= 'F')) {
+            digit = static_cast<uint32_t>(c - 'A' + HEX_LETTER_BASE);
+        } else {
+            // cJSON decodes malformed hex digits as U+0000 instead of rejecting them.
+            return 0;
+        }
+        value = (value << HEX_DIGIT_BITS) | digit;
+    }
+    return value;
+}
+
+bool JsonStreamReader::ParseString(std::string *value)
+{
+    if ((pos_ >= data_.size()) || (data_[pos_] != '\"')) {
+        return false;
+    }
+    size_t end = pos_ + 1;
+    while ((end < data_.size()) && (data_[end] != '\"')) {
+        if (data_[end] == '\\') {
+            if (end + 1 >= data_.size()) {
+                return false;
+            }
+            ++end;
+        }
+        ++end;
+    }
+    if (end >= data_.size()) {
+        return false;
+    }
+    std::string decoded;
+    size_t cur = pos_ + 1;
+    while (cur < end) {
+        if (data_[cur] != '\\') {
+            decoded.push_back(data_[cur++]);
+            continue;
+        }
+        char escape = data_[cur + 1];
+        char simple = '\0';
+        if (DecodeSimpleEscape(escape, simple)) {
+            decoded.push_back(simple);
+            cur += ESCAPE_LENGTH;
+            continue;
+        }
+        if ((escape != 'u') || (end - cur < UNICODE_ESCAPE_LENGTH)) {
+            return false;
+        }
+        uint32_t first = ParseHex4(cur + ESCAPE_LENGTH);
+        uint32_t codepoint = first;
+        size_t length = UNICODE_ESCAPE_LENGTH;
+        if ((first >= LOW_SURROGATE_MIN) && (first <= LOW_SURROGATE_MAX)) {
+            return false;
+        }
+        if ((first >= HIGH_SURROGATE_MIN) && (first <= HIGH_SURROGATE_MAX)) {
+            size_t second = cur + UNICODE_ESCAPE_LENGTH;
+            if ((end - second < UNICODE_ESCAPE_LENGTH) || (data_[second] != '\\') || (data_[second + 1] != 'u')) {
+                return false;
+            }
+            uint32_t low = ParseHex4(second + ESCAPE_LENGTH);
+            if ((low < LOW_SURROGATE_MIN) || (low > LOW_SURROGATE_MAX)) {
+                return false;
+            }
+            codepoint = SUPPLEMENTARY_BASE + (((first & SURROGATE_MASK) << SURROGATE_SHIFT) | (low & SURROGATE_MASK));
+            length += UNICODE_ESCAPE_LENGTH;
+        }
+        if (codepoint > CODEPOINT_MAX) {
+            return false;
+        }
+        AppendUtf8(decoded, codepoint);
+        cur += length;
+    }
+    pos_ = end + 1;
+    if (value != nullptr) {
+        // cJSON hands strings out as C strings, so anything after an embedded NUL is invisible.
+        size_t nul = decoded.find('\0');
+        if (nul != std::string::npos) {
+            decoded.resize(nul);
+        }
+        *value = std::move(decoded);
+    }
+    return true;
+}
+
+bool JsonStreamReader::ParseLiteral()
+{
+    std::string_view rest = data_.substr(pos_);
+    if (rest.substr(0, strlen("false")) == "false") {
+        pos_ += strlen("false");
+        return true;
+    }
+    if ((rest.substr(0, strlen("true")) == "true") || (rest.substr(0, strlen("null")) == "null")) {
+        pos_ += strlen("true");
+        return true;
+    }
+    return false;
+}
+
+bool JsonStreamReader::SkipValue()
+{
+    size_t baseSize = containers_.size();
+    do {
+        bool ret = false;
+        switch (PeekType()) {
+            case JsonValueType::OBJECT: {
+                ret = EnterObject();
+                break;
+            }
+            case JsonValueType::ARRAY: {
+                ret = EnterArray();
+                break;
+            }
+            case JsonValueType::STRING: {
+                ret = ParseString(nullptr);
+                break;
+            }
+            case JsonValueType::NUMBER: {
+                double value = 0.0;
+                ret = ReadNumber(value);
+                break;
+            }
+            case JsonValueType::BOOLEAN:
+            case JsonValueType::NULL_VALUE: {
+                ret = ParseLiteral();
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+        if (!ret) {
+            return false;
+        }
+        // Close every container that has been fully consumed, stop at the next pending value.
+        while (containers_.size() > baseSize) {
+            bool hasNext = false;
+            ret = containers_.back() ? NextMemberKey(nullptr, hasNext) : NextElement(hasNext);
+            if (!ret) {
+                return false;
+            }
+            if (hasNext) {
+                break;
+            }
+        }
+    } while (containers_.size() > baseSize);
+    return true;
+}
+
+bool JsonStreamReader::CaptureValue(std::string_view &raw)
+{
+    SkipWhitespace();
+    size_t start = pos_;
+    if (!SkipValue()) {
+        return false;
+    }
+    raw = data_.substr(start, pos_ - start);
+    return true;
+}
+
+size_t JsonStreamReader::GetDepth() const
+{
+    return depth_;
+}
+
+bool JsonStreamReader::KeyEquals(const std::string &key, const char *name)
+{
+    // cJSON_GetObjectItem matches keys case-insensitively.
+    return (strcasecmp(key.c_str(), name) == 0);
+}
+
+bool JsonStreamReader::HasRootMember(std::string_view data, std::initializer_list<const char *> names)
+{
+    JsonStreamReader reader(data);
+    bool found = false;
+    reader.ForEachMember([&reader, &names, &found](const std::string &key) -> int32_t {
+        for (const char *name : names) {
+            if (KeyEquals(key, name)) {
+                found = true;
+                return ERROR;
+            }
+        }
+        return reader.SkipValue() ? SUCCESS : ERROR;
+    });
+    return found;
+}
+
+int32_t JsonStreamReader::ToInt(double value)
+{
+    // Same saturation as cJSON's valueint.
+    if (value >= INT_MAX) {
+        return INT_MAX;
+    }
+    if (value <= static_cast<double>(INT_MIN)) {
+        return INT_MIN;
+    }
+    return static_cast<int32_t>(value);
+}
+}  // namespace Sensors
+}  // namespace OHOS
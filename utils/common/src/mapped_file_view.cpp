@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_file_view.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "file_utils.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "MappedFileView"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+// Below this a single pread into the buffer is clearly cheaper than faulting in and tearing down a
+// mapping (FileReadBenchmarkTest); larger windows are mapped so a second copy of the file is not held.
+constexpr int64_t MMAP_MIN_SIZE = 1 << 20;
+
+bool IsShrinkSealed(int32_t fd)
+{
+#ifdef F_GET_SEALS
+    int32_t seals = fcntl(fd, F_GET_SEALS);
+    return (seals >= 0) && ((static_cast<uint32_t>(seals) & F_SEAL_SHRINK) != 0);
+#else
+    (void)fd;
+    return false;
+#endif
+}
+}  // namespace
+
+MappedFileView::~MappedFileView()
+{
+    Unmap();
+}
+
+int32_t MappedFileView::Map(const RawFileDescriptor &rawFd, bool trustedFd)
+{
+    Unmap();
+    if (rawFd.fd < 0) {
+        MISC_HILOGE("fd is invalid, fd:%{public}d", rawFd.fd);
+        return PARAMETER_ERROR;
+    }
+    int64_t fdSize = GetFileSize(rawFd.fd);
+    if ((rawFd.offset < 0) || (rawFd.offset > fdSize)) {
+        MISC_HILOGE("offset is invalid, offset:%{public}" PRId64, rawFd.offset);
+        return PARAMETER_ERROR;
+    }
+    if ((rawFd.length <= 0) || (rawFd.length > fdSize - rawFd.offset)) {
+        MISC_HILOGE("length is invalid, length:%{public}" PRId64, rawFd.length);
+        return PARAMETER_ERROR;
+    }
+    // Touching a mapped page past the end of a file that was truncated meanwhile raises SIGBUS,
+    // so an fd whose owner may shrink it is never mapped.
+    if ((rawFd.length >= MMAP_MIN_SIZE) && (trustedFd || IsShrinkSealed(rawFd.fd)) &&
+        (MapWindow(rawFd) == SUCCESS)) {
+        return SUCCESS;
+    }
+    return ReadWindow(rawFd);
+}
+
+int32_t MappedFileView::MapWindow(const RawFileDescriptor &rawFd)
+{
+    static const int64_t pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0) {
+        return ERROR;
+    }
+    int64_t alignedOffset = rawFd.offset - (rawFd.offset % pageSize);
+    size_t delta = static_cast<size_t>(rawFd.offset - alignedOffset);
+    size_t mapSize = delta + static_cast<size_t>(rawFd.length);
+    void *addr = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, rawFd.fd, alignedOffset);
+    if (addr == MAP_FAILED) {
+        MISC_HILOGW("mmap failed, fall back to pread, errno:%{public}d", errno);
+        return ERROR;
+    }
+    mapAddr_ = addr;
+    mapSize_ = mapSize;
+    data_ = std::string_view(static_cast<const char *>(addr) + delta, static_cast<size_t>(rawFd.length));
+    return SUCCESS;
+}
+
+int32_t MappedFileView::ReadWindow(const RawFileDescriptor &rawFd)
+{
+    buffer_.resize(static_cast<size_t>(rawFd.length));
+    int32_t ret = PreadFully(rawFd.fd, rawFd.offset, buffer_.data(), buffer_.size());
+    if (ret != SUCCESS) {
+        buffer_.clear();
+        return ret;
+    }
+    data_ = std::string_view(buffer_);
+    return SUCCESS;
+}
+
+void MappedFileView::Unmap()
+{
+    if (mapAddr_ != nullptr) {
+        if (munmap(mapAddr_, mapSize_) != 0) {
+            MISC_HILOGW("munmap failed, errno:%{public}d", errno);
+        }
+        mapAddr_ = nullptr;
+        mapSize_ = 0;
+    }
+    buffer_.clear();
+    data_ = {};
+}
+
+std::string_view MappedFileView::GetData() const
+{
+    return data_;
+}
+
+int32_t PreadFully(int32_t fd, int64_t offset, char *buf, size_t length)
+{
+    CHKPR(buf, PARAMETER_ERROR);
+    size_t alreadyRead = 0;
+    while (alreadyRead < length) {
+        ssize_t onceRead = pread(fd, buf + alreadyRead, length - alreadyRead,
+            static_cast<off_t>(offset + static_cast<int64_t>(alreadyRead)));
+        if (onceRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            MISC_HILOGE("pread failed, errno:%{public}d", errno);
+            return ERROR;
+        }
+        if (onceRead == 0) {
+            MISC_HILOGE("Unexpected end of file, read:%{public}zu, expect:%{public}zu", alreadyRead, length);
+            return ERROR;
+        }
+        alreadyRead += static_cast<size_t>(onceRead);
+    }
+    return SUCCESS;
+}
+}  // namespace Sensors
+}  // namespace OHOS
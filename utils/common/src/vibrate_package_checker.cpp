@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrate_package_checker.h"
+
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratePackageChecker"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int32_t STARTTIME_MIN = 0;
+constexpr int32_t STARTTIME_MAX = 1800000;
+constexpr int32_t DURATION_MIN = 0;
+constexpr int32_t DURATION_MAX = 5000;
+constexpr int32_t INTENSITY_MIN = 0;
+constexpr int32_t INTENSITY_MAX = 100;
+constexpr int32_t INDEX_MIN = 0;
+constexpr int32_t INDEX_MAX = 2;
+constexpr int32_t CONTINUOUS_FREQUENCY_MIN = 0;
+constexpr int32_t CONTINUOUS_FREQUENCY_MAX = 100;
+constexpr int32_t TRANSIENT_FREQUENCY_MIN = -50;
+constexpr int32_t TRANSIENT_FREQUENCY_MAX = 150;
+constexpr size_t CURVE_POINT_MIN = 4;
+constexpr int32_t CURVE_INTENSITY_MIN = 0;
+constexpr int32_t CURVE_INTENSITY_MAX = 100;
+constexpr int32_t CURVE_FREQUENCY_MIN = -100;
+constexpr int32_t CURVE_FREQUENCY_MAX = 100;
+}  // namespace
+
+bool VibratePackageChecker::CheckPackage(const VibratePackage &package)
+{
+    if (package.patterns.empty() || (package.patterns.size() > static_cast<size_t>(MAX_PATTERN_SIZE))) {
+        MISC_HILOGE("The patterns size is out of range, size:%{public}zu", package.patterns.size());
+        return false;
+    }
+    int32_t previousStartTime = STARTTIME_MIN;
+    for (const auto &pattern : package.patterns) {
+        if (pattern.startTime < previousStartTime) {
+            MISC_HILOGE("The patterns are not in order, startTime:%{public}d", pattern.startTime);
+            return false;
+        }
+        if (!CheckPattern(pattern)) {
+            return false;
+        }
+        previousStartTime = pattern.startTime;
+    }
+    return true;
+}
+
+bool VibratePackageChecker::CheckPattern(const VibratePattern &pattern)
+{
+    if ((pattern.startTime < STARTTIME_MIN) || (pattern.startTime > STARTTIME_MAX)) {
+        MISC_HILOGE("The pattern startTime is out of range, startTime:%{public}d", pattern.startTime);
+        return false;
+    }
+    if (pattern.events.empty() || (pattern.events.size() > static_cast<size_t>(MAX_EVENT_SIZE))) {
+        MISC_HILOGE("The events size is out of range, size:%{public}zu", pattern.events.size());
+        return false;
+    }
+    int32_t previousTime = STARTTIME_MIN;
+    for (const auto &event : pattern.events) {
+        if (event.time < previousTime) {
+            MISC_HILOGE("The events are not in order, time:%{public}d", event.time);
+            return false;
+        }
+        if (!CheckEvent(event)) {
+            return false;
+        }
+        previousTime = event.time;
+    }
+    return true;
+}
+
+bool VibratePackageChecker::CheckEvent(const VibrateEvent &event)
+{
+    if ((event.time < STARTTIME_MIN) || (event.time > STARTTIME_MAX)) {
+        MISC_HILOGE("The event startTime is out of range, startTime:%{public}d", event.time);
+        return false;
+    }
+    if ((event.duration < DURATION_MIN) || (event.duration > DURATION_MAX)) {
+        MISC_HILOGE("The event duration is out of range, duration:%{public}d", event.duration);
+        return false;
+    }
+    if ((event.intensity < INTENSITY_MIN) || (event.intensity > INTENSITY_MAX)) {
+        MISC_HILOGE("The event intensity is out of range, intensity:%{public}d", event.intensity);
+        return false;
+    }
+    if ((event.index < INDEX_MIN) || (event.index > INDEX_MAX)) {
+        MISC_HILOGE("The event index is out of range, index:%{public}d", event.index);
+        return false;
+    }
+    if (event.tag == EVENT_TAG_TRANSIENT) {
+        if ((event.frequency < TRANSIENT_FREQUENCY_MIN) || (event.frequency > TRANSIENT_FREQUENCY_MAX) ||
+            (!event.points.empty())) {
+            MISC_HILOGE("Invalid transient event, frequency:%{public}d, points:%{public}zu",
+                event.frequency, event.points.size());
+            return false;
+        }
+        return true;
+    }
+    if (event.tag != EVENT_TAG_CONTINUOUS) {
+        MISC_HILOGE("The event tag is unknown, tag:%{public}d", event.tag);
+        return false;
+    }
+    if ((event.frequency < CONTINUOUS_FREQUENCY_MIN) || (event.frequency > CONTINUOUS_FREQUENCY_MAX)) {
+        MISC_HILOGE("The event frequency is out of range, frequency:%{public}d", event.frequency);
+        return false;
+    }
+    return CheckCurve(event);
+}
+
+bool VibratePackageChecker::CheckCurve(const VibrateEvent &event)
+{
+    if (event.points.empty()) {
+        return true;
+    }
+    if ((event.points.size() < CURVE_POINT_MIN) || (event.points.size() > static_cast<size_t>(MAX_POINT_SIZE))) {
+        MISC_HILOGE("The size of curve point is out of bounds, size:%{public}zu", event.points.size());
+        return false;
+    }
+    int32_t previousTime = 0;
+    for (const auto &point : event.points) {
+        if ((point.time < previousTime) || (point.time > event.duration)) {
+            MISC_HILOGE("The time of curve point is invalid, time:%{public}d", point.time);
+            return false;
+        }
+        if ((point.intensity < CURVE_INTENSITY_MIN) || (point.intensity > CURVE_INTENSITY_MAX)) {
+            MISC_HILOGE("The intensity of curve point is out of bounds, intensity:%{public}d", point.intensity);
+            return false;
+        }
+        if ((point.frequency < CURVE_FREQUENCY_MIN) || (point.frequency > CURVE_FREQUENCY_MAX)) {
+            MISC_HILOGE("The frequency of curve point is out of bounds, frequency:%{public}d", point.frequency);
+            return false;
+        }
+        previousTime = point.time;
+    }
+    return true;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "vibrator_decoder_registry.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <unistd.h>
+
+#include "file_utils.h"
+#include "mapped_file_view.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "VibratorDecoderRegistry"
+
+namespace OHOS {
+namespace Sensors {
+VibratorDecoderRegistry &VibratorDecoderRegistry::GetInstance()
+{
+    static VibratorDecoderRegistry instance;
+    return instance;
+}
+
+void VibratorDecoderRegistry::Register(const char *name, const char *extension, VibratorDecoderProbe probe,
+    VibratorDecoderCreate create)
+{
+    CHKPV(name);
+    CHKPV(extension);
+    CHKPV(probe);
+    CHKPV(create);
+    std::lock_guard<std::mutex> entriesLock(entriesMutex_);
+    auto it = std::find_if(entries_.begin(), entries_.end(), [name](const Entry &entry) {
+        return std::string_view(entry.name) == name;
+    });
+    if (it != entries_.end()) {
+        MISC_HILOGW("Decoder already registered, name:%{public}s", name);
+        return;
+    }
+    entries_.push_back({ name, extension, probe, create });
+}
+
+IVibratorDecoder *VibratorDecoderRegistry::CreateDecoder(const RawFileDescriptor &rawFd) const
+{
+    if ((rawFd.fd < 0) || (rawFd.offset < 0) || (rawFd.length <= 0)) {
+        MISC_HILOGE("Invalid fd window, fd:%{public}d, offset:%{public}" PRId64 ", length:%{public}" PRId64,
+            rawFd.fd, rawFd.offset, rawFd.length);
+        return nullptr;
+    }
+    char head[PROBE_SIZE];
+    size_t probeSize = static_cast<size_t>(std::min<int64_t>(rawFd.length, PROBE_SIZE));
+    ssize_t readSize = 0;
+    do {
+        readSize = pread(rawFd.fd, head, probeSize, static_cast<off_t>(rawFd.offset));
+    } while ((readSize < 0) && (errno == EINTR));
+    if (readSize <= 0) {
+        MISC_HILOGE("Read effect head failed, errno:%{public}d", errno);
+        return nullptr;
+    }
+    IVibratorDecoder *decoder = CreateDecoder(std::string_view(head, static_cast<size_t>(readSize)));
+    if (decoder != nullptr) {
+        return decoder;
+    }
+    // The distinguishing key may come after a long leading member, such as a JSON "MetaData" with a
+    // long description.
+    if ((static_cast<size_t>(readSize) == PROBE_SIZE) && (rawFd.length > static_cast<int64_t>(PROBE_SIZE)) &&
+        (rawFd.length <= static_cast<int64_t>(FULL_PROBE_MAX_SIZE))) {
+        std::string content(static_cast<size_t>(rawFd.length), '\0');
+        if (PreadFully(rawFd.fd, rawFd.offset, content.data(), content.size()) == SUCCESS) {
+            decoder = CreateDecoder(std::string_view(content));
+            if (decoder != nullptr) {
+                return decoder;
+            }
+        }
+    }
+    std::string extension;
+    if (GetFileExtName(rawFd.fd, extension) != SUCCESS) {
+        MISC_HILOGE("No decoder recognizes the effect and the fd has no file name");
+        return nullptr;
+    }
+    return CreateDecoderByExtension(extension);
+}
+
+IVibratorDecoder *VibratorDecoderRegistry::CreateDecoder(std::string_view head) const
+{
+    std::lock_guard<std::mutex> entriesLock(entriesMutex_);
+    for (const auto &entry : entries_) {
+        if (entry.probe(head)) {
+            MISC_HILOGD("Get %{public}s decoder", entry.name);
+            return entry.create();
+        }
+    }
+    MISC_HILOGW("No decoder recognizes the content, registered:%{public}zu", entries_.size());
+    return nullptr;
+}
+
+IVibratorDecoder *VibratorDecoderRegistry::CreateDecoderByExtension(const std::string &extension) const
+{
+    std::lock_guard<std::mutex> entriesLock(entriesMutex_);
+    for (const auto &entry : entries_) {
+        if (extension == entry.extension) {
+            MISC_HILOGD("Get %{public}s decoder by extension", entry.name);
+            return entry.create();
+        }
+    }
+    MISC_HILOGE("No decoder for the extension, extension:%{public}s", extension.c_str());
+    return nullptr;
+}
+}  // namespace Sensors
+}  // namespace OHOS
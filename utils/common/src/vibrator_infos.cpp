@@ -14,11 +14,7 @@
  */
 #include "vibrator_infos.h"
 
-#include <cerrno>
-#include <cinttypes>
-
-#include <sys/stat.h>
-#include <unistd.h>
+#include <algorithm>
 
 #include "sensors_errors.h"
 
@@ -27,6 +23,48 @@
 
 namespace OHOS {
 namespace Sensors {
+namespace {
+const std::unordered_map<std::string, VibrateMode> VIBRATE_MODE_MAP = {
+    {VIBRATE_TIME, VibrateMode::TIME},
+    {VIBRATE_PRESET, VibrateMode::PRESET},
+    {VIBRATE_CUSTOM_HD, VibrateMode::CUSTOM_HD},
+    {VIBRATE_CUSTOM_COMPOSITE_EFFECT, VibrateMode::CUSTOM_COMPOSITE_EFFECT},
+    {VIBRATE_CUSTOM_COMPOSITE_TIME, VibrateMode::CUSTOM_COMPOSITE_TIME},
+    {VIBRATE_PRIMITIVE, VibrateMode::PRIMITIVE},
+};
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+}  // namespace
+
+const std::string &GetVibrateModeName(VibrateMode mode)
+{
+    switch (mode) {
+        case VibrateMode::TIME:
+            return VIBRATE_TIME;
+        case VibrateMode::PRESET:
+            return VIBRATE_PRESET;
+        case VibrateMode::CUSTOM_HD:
+            return VIBRATE_CUSTOM_HD;
+        case VibrateMode::CUSTOM_COMPOSITE_EFFECT:
+            return VIBRATE_CUSTOM_COMPOSITE_EFFECT;
+        case VibrateMode::CUSTOM_COMPOSITE_TIME:
+            return VIBRATE_CUSTOM_COMPOSITE_TIME;
+        case VibrateMode::PRIMITIVE:
+            return VIBRATE_PRIMITIVE;
+        default:
+            return VIBRATE_BUTT;
+    }
+}
+
+VibrateMode ParseVibrateMode(const std::string &name)
+{
+    auto it = VIBRATE_MODE_MAP.find(name);
+    if (it == VIBRATE_MODE_MAP.end()) {
+        return VibrateMode::BUTT;
+    }
+    return it->second;
+}
+
 void VibratePattern::Dump() const
 {
     int32_t size = static_cast<int32_t>(events.size());
@@ -54,6 +92,169 @@ void VibratePackage::Dump() const
     }
 }
 
+static void HashValue(uint64_t &hash, int32_t value)
+{
+    uint32_t bits = static_cast<uint32_t>(value);
+    for (size_t i = 0; i < sizeof(bits); ++i) {
+        hash = (hash ^ ((bits >> (i * 8)) & 0xFF)) * FNV_PRIME;
+    }
+}
+
+static uint64_t HashPackage(const FlatVibratePackage &package)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    HashValue(hash, package.packageDuration);
+    for (const auto &pattern : package.patterns) {
+        HashValue(hash, pattern.startTime);
+        for (const auto &event : package.GetEvents(pattern)) {
+            HashValue(hash, static_cast<int32_t>(event.tag));
+            HashValue(hash, event.time);
+            HashValue(hash, event.duration);
+            HashValue(hash, event.intensity);
+            HashValue(hash, event.frequency);
+            HashValue(hash, event.index);
+            for (const auto &point : package.GetPoints(event)) {
+                HashValue(hash, point.time);
+                HashValue(hash, point.intensity);
+                HashValue(hash, point.frequency);
+            }
+        }
+    }
+    return hash;
+}
+
+static void CountPattern(const VibratePattern &pattern, size_t &eventCount, size_t &pointCount)
+{
+    eventCount += pattern.events.size();
+    for (const auto &event : pattern.events) {
+        pointCount += event.points.size();
+    }
+}
+
+static void AppendEvent(const VibrateEvent &event, int32_t startTime, FlatVibratePackage &flat)
+{
+    flat.events.push_back({
+        .tag = event.tag,
+        .time = event.time - startTime,
+        .duration = event.duration,
+        .intensity = event.intensity,
+        .frequency = event.frequency,
+        .index = event.index,
+        .firstPoint = static_cast<uint32_t>(flat.points.size()),
+        .pointCount = static_cast<uint32_t>(event.points.size()),
+    });
+    flat.points.insert(flat.points.end(), event.points.begin(), event.points.end());
+}
+
+static void AppendPattern(const VibratePattern &pattern, FlatVibratePackage &flat)
+{
+    flat.patterns.push_back({
+        .startTime = pattern.startTime,
+        .patternDuration = pattern.patternDuration,
+        .firstEvent = static_cast<uint32_t>(flat.events.size()),
+        .eventCount = static_cast<uint32_t>(pattern.events.size()),
+    });
+    for (const auto &event : pattern.events) {
+        AppendEvent(event, 0, flat);
+    }
+}
+
+FlatVibratePackage FlatVibratePackage::Flatten(const VibratePackage &package)
+{
+    size_t eventCount = 0;
+    size_t pointCount = 0;
+    for (const auto &pattern : package.patterns) {
+        CountPattern(pattern, eventCount, pointCount);
+    }
+    FlatVibratePackage flat;
+    flat.packageDuration = package.packageDuration;
+    flat.patterns.reserve(package.patterns.size());
+    flat.events.reserve(eventCount);
+    flat.points.reserve(pointCount);
+    for (const auto &pattern : package.patterns) {
+        AppendPattern(pattern, flat);
+    }
+    flat.contentHash = HashPackage(flat);
+    return flat;
+}
+
+FlatVibratePackage FlatVibratePackage::Flatten(const VibratePattern &pattern, size_t eventCapacity)
+{
+    size_t eventCount = 0;
+    size_t pointCount = 0;
+    CountPattern(pattern, eventCount, pointCount);
+    eventCapacity = std::max<size_t>(eventCapacity, 1);
+    size_t sliceCount = std::max<size_t>((eventCount + eventCapacity - 1) / eventCapacity, 1);
+    FlatVibratePackage flat;
+    flat.patterns.reserve(sliceCount);
+    flat.events.reserve(eventCount);
+    flat.points.reserve(pointCount);
+    if (sliceCount == 1) {
+        AppendPattern(pattern, flat);
+        flat.patterns.front().startTime = 0;
+        flat.patterns.front().patternDuration = 0;
+        flat.contentHash = HashPackage(flat);
+        return flat;
+    }
+    std::vector<const VibrateEvent *> ordered;
+    ordered.reserve(eventCount);
+    for (const auto &event : pattern.events) {
+        ordered.push_back(&event);
+    }
+    std::stable_sort(ordered.begin(), ordered.end(),
+        [](const VibrateEvent *lhs, const VibrateEvent *rhs) { return *lhs < *rhs; });
+    for (size_t begin = 0; begin < eventCount; begin += eventCapacity) {
+        size_t end = std::min(begin + eventCapacity, eventCount);
+        int32_t startTime = (begin == 0) ? 0 : ordered[begin]->time;
+        flat.patterns.push_back({
+            .startTime = startTime,
+            .firstEvent = static_cast<uint32_t>(flat.events.size()),
+            .eventCount = static_cast<uint32_t>(end - begin),
+        });
+        for (size_t i = begin; i < end; ++i) {
+            AppendEvent(*ordered[i], startTime, flat);
+        }
+    }
+    flat.contentHash = HashPackage(flat);
+    return flat;
+}
+
+ArrayView<FlatVibrateEvent> FlatVibratePackage::GetEvents(const FlatVibratePattern &pattern) const
+{
+    return ArrayView<FlatVibrateEvent>(events.data() + pattern.firstEvent, pattern.eventCount);
+}
+
+ArrayView<VibrateCurvePoint> FlatVibratePackage::GetPoints(const FlatVibrateEvent &event) const
+{
+    return ArrayView<VibrateCurvePoint>(points.data() + event.firstPoint, event.pointCount);
+}
+
+size_t FlatVibratePackage::GetHeapBytes() const
+{
+    return patterns.capacity() * sizeof(FlatVibratePattern) + events.capacity() * sizeof(FlatVibrateEvent) +
+        points.capacity() * sizeof(VibrateCurvePoint);
+}
+
+void FlatVibratePackage::Dump() const
+{
+    MISC_HILOGD("Vibrate package pattern size:%{public}zu, event size:%{public}zu, point size:%{public}zu",
+        patterns.size(), events.size(), points.size());
+    for (const auto &pattern : patterns) {
+        MISC_HILOGD("Pattern startTime:%{public}d, eventSize:%{public}u", pattern.startTime, pattern.eventCount);
+        for (const auto &event : GetEvents(pattern)) {
+            std::string tag = (event.tag == EVENT_TAG_CONTINUOUS) ? "continuous" : "transient";
+            MISC_HILOGD("Event tag:%{public}s, time:%{public}d, duration:%{public}d,"
+                "intensity:%{public}d, frequency:%{public}d, index:%{public}d, curve pointSize:%{public}u",
+                tag.c_str(), event.time, event.duration, event.intensity, event.frequency, event.index,
+                event.pointCount);
+            for (const auto &point : GetPoints(event)) {
+                MISC_HILOGD("Curve point time:%{public}d, intensity:%{public}d, frequency:%{public}d",
+                    point.time, point.intensity, point.frequency);
+            }
+        }
+    }
+}
+
 void VibratorCapacity::Dump() const
 {
     std::string isSupportHdHapticStr = isSupportHdHaptic ? "true" : "false";
@@ -113,143 +314,197 @@ std::optional<VibratorCapacity> VibratorCapacity::Unmarshalling(Parcel &data)
     return capacity;
 }
 
-bool VibratePattern::Marshalling(Parcel &parcel) const
+bool VibratePattern::Encode(std::vector<uint8_t> &buffer) const
 {
-    if (!parcel.WriteInt32(startTime)) {
-        MISC_HILOGE("Write pattern's startTime failed");
-        return false;
-    }
-    if (!parcel.WriteInt32(patternDuration)) {
-        MISC_HILOGE("Write patternDuration failed");
-        return false;
-    }
-    if (!parcel.WriteInt32(static_cast<int32_t>(events.size()))) {
-        MISC_HILOGE("Write events's size failed");
+    if (events.size() > static_cast<size_t>(MAX_PATTERN_WIRE_EVENT_SIZE)) {
+        MISC_HILOGE("Events size exceed the maximum, size:%{public}zu", events.size());
         return false;
     }
-    for (size_t i = 0; i < events.size(); ++i) {
-        if (!parcel.WriteInt32(static_cast<int32_t>(events[i].tag))) {
-            MISC_HILOGE("Write tag failed");
-            return false;
-        }
-        if (!parcel.WriteInt32(events[i].time)) {
-            MISC_HILOGE("Write events's time failed");
-            return false;
-        }
-        if (!parcel.WriteInt32(events[i].duration)) {
-            MISC_HILOGE("Write duration failed");
-            return false;
-        }
-        if (!parcel.WriteInt32(events[i].intensity)) {
-            MISC_HILOGE("Write intensity failed");
-            return false;
-        }
-        if (!parcel.WriteInt32(events[i].frequency)) {
-            MISC_HILOGE("Write frequency failed");
+    PatternWireHeader header = {
+        .startTime = startTime,
+        .patternDuration = patternDuration,
+        .eventCount = static_cast<uint32_t>(events.size()),
+    };
+    for (const auto &event : events) {
+        if (event.points.size() > static_cast<size_t>(MAX_POINT_SIZE)) {
+            MISC_HILOGE("Points size exceed the maximum, size:%{public}zu", event.points.size());
             return false;
         }
-        if (!parcel.WriteInt32(events[i].index)) {
-            MISC_HILOGE("Write index failed");
-            return false;
-        }
-        if (!parcel.WriteInt32(static_cast<int32_t>(events[i].points.size()))) {
-            MISC_HILOGE("Write points's size failed");
-            return false;
-        }
-        for (size_t j = 0; j < events[i].points.size(); ++j) {
-            if (!parcel.WriteInt32(events[i].points[j].time)) {
-                MISC_HILOGE("Write points's time failed");
-                return false;
-            }
-            if (!parcel.WriteInt32(events[i].points[j].intensity)) {
-                MISC_HILOGE("Write points's intensity failed");
-                return false;
-            }
-            if (!parcel.WriteInt32(events[i].points[j].frequency)) {
-                MISC_HILOGE("Write points's frequency failed");
-                return false;
-            }
+        header.pointCount += static_cast<uint32_t>(event.points.size());
+    }
+    size_t eventOffset = sizeof(PatternWireHeader);
+    size_t pointOffset = eventOffset + header.eventCount * sizeof(EventWireRecord);
+    buffer.resize(pointOffset + header.pointCount * sizeof(CurvePointWireRecord));
+    uint8_t *base = buffer.data();
+    std::copy_n(reinterpret_cast<const uint8_t *>(&header), sizeof(header), base);
+    for (const auto &event : events) {
+        EventWireRecord record = {
+            .tag = static_cast<int32_t>(event.tag),
+            .time = event.time,
+            .duration = event.duration,
+            .intensity = event.intensity,
+            .frequency = event.frequency,
+            .index = event.index,
+            .pointCount = static_cast<uint32_t>(event.points.size()),
+        };
+        std::copy_n(reinterpret_cast<const uint8_t *>(&record), sizeof(record), base + eventOffset);
+        eventOffset += sizeof(record);
+        for (const auto &point : event.points) {
+            CurvePointWireRecord pointRecord = {
+                .time = point.time,
+                .intensity = point.intensity,
+                .frequency = point.frequency,
+            };
+            std::copy_n(reinterpret_cast<const uint8_t *>(&pointRecord), sizeof(pointRecord), base + pointOffset);
+            pointOffset += sizeof(pointRecord);
         }
     }
     return true;
 }
 
-std::optional<VibratePattern> VibratePattern::Unmarshalling(Parcel &data)
+std::optional<VibratePattern> VibratePattern::Decode(const uint8_t *buffer, size_t size)
 {
-    VibratePattern pattern;
-    if (!(data.ReadInt32(pattern.startTime))) {
-        MISC_HILOGE("Read time failed");
+    if ((buffer == nullptr) || (size < sizeof(PatternWireHeader)) || (size > MAX_PATTERN_WIRE_SIZE)) {
+        MISC_HILOGE("Invalid pattern buffer, size:%{public}zu", size);
         return std::nullopt;
     }
-    if (!(data.ReadInt32(pattern.patternDuration))) {
-        MISC_HILOGE("Read duration failed");
+    PatternWireHeader header;
+    std::copy_n(buffer, sizeof(header), reinterpret_cast<uint8_t *>(&header));
+    if (header.version != PATTERN_WIRE_VERSION) {
+        MISC_HILOGE("Unsupported pattern wire version:%{public}u", header.version);
         return std::nullopt;
     }
-    int32_t eventSize { 0 };
-    if (!(data.ReadInt32(eventSize))) {
-        MISC_HILOGE("Read eventSize failed");
+    if ((header.eventCount > static_cast<uint32_t>(MAX_PATTERN_WIRE_EVENT_SIZE)) ||
+        (header.pointCount > header.eventCount * static_cast<uint32_t>(MAX_POINT_SIZE))) {
+        MISC_HILOGE("Pattern exceed the maximum, eventCount:%{public}u, pointCount:%{public}u",
+            header.eventCount, header.pointCount);
         return std::nullopt;
     }
-    if (eventSize > MAX_EVENT_SIZE) {
-        MISC_HILOGE("eventSize exceed the maximum");
+    size_t eventOffset = sizeof(PatternWireHeader);
+    size_t pointOffset = eventOffset + header.eventCount * sizeof(EventWireRecord);
+    if (size != pointOffset + header.pointCount * sizeof(CurvePointWireRecord)) {
+        MISC_HILOGE("Pattern buffer size mismatch, size:%{public}zu", size);
         return std::nullopt;
     }
-    for (int32_t i = 0; i < eventSize; ++i) {
-        VibrateEvent event;
-        int32_t tag { -1 };
-        if (!data.ReadInt32(tag)) {
-            MISC_HILOGE("Read type failed");
-            return std::nullopt;
-        }
-        event.tag = static_cast<VibrateTag>(tag);
-        if (!data.ReadInt32(event.time)) {
-            MISC_HILOGE("Read events's time failed");
-            return std::nullopt;
-        }
-        if (!data.ReadInt32(event.duration)) {
-            MISC_HILOGE("Read duration failed");
-            return std::nullopt;
-        }
-        if (!data.ReadInt32(event.intensity)) {
-            MISC_HILOGE("Read intensity failed");
-            return std::nullopt;
-        }
-        if (!data.ReadInt32(event.frequency)) {
-            MISC_HILOGE("Read frequency failed");
+    VibratePattern pattern;
+    pattern.startTime = header.startTime;
+    pattern.patternDuration = header.patternDuration;
+    pattern.events.resize(header.eventCount);
+    uint32_t remainPoints = header.pointCount;
+    for (auto &event : pattern.events) {
+        EventWireRecord record;
+        std::copy_n(buffer + eventOffset, sizeof(record), reinterpret_cast<uint8_t *>(&record));
+        eventOffset += sizeof(record);
+        if ((record.pointCount > static_cast<uint32_t>(MAX_POINT_SIZE)) || (record.pointCount > remainPoints)) {
+            MISC_HILOGE("Invalid event pointCount:%{public}u", record.pointCount);
             return std::nullopt;
         }
-        if (!data.ReadInt32(event.index)) {
-            MISC_HILOGE("Read index failed");
-            return std::nullopt;
+        remainPoints -= record.pointCount;
+        event.tag = static_cast<VibrateTag>(record.tag);
+        event.time = record.time;
+        event.duration = record.duration;
+        event.intensity = record.intensity;
+        event.frequency = record.frequency;
+        event.index = record.index;
+        event.points.resize(record.pointCount);
+        for (auto &point : event.points) {
+            CurvePointWireRecord pointRecord;
+            std::copy_n(buffer + pointOffset, sizeof(pointRecord), reinterpret_cast<uint8_t *>(&pointRecord));
+            pointOffset += sizeof(pointRecord);
+            point.time = pointRecord.time;
+            point.intensity = pointRecord.intensity;
+            point.frequency = pointRecord.frequency;
         }
-        int32_t pointSize { 0 };
-        if (!data.ReadInt32(pointSize)) {
-            MISC_HILOGE("Read pointSize failed");
-            return std::nullopt;
+    }
+    if (remainPoints != 0) {
+        MISC_HILOGE("Pattern pointCount mismatch, remain:%{public}u", remainPoints);
+        return std::nullopt;
+    }
+    return pattern;
+}
+
+bool VibratePattern::Marshalling(Parcel &parcel) const
+{
+    std::vector<uint8_t> buffer;
+    if (!Encode(buffer)) {
+        MISC_HILOGE("Encode pattern failed");
+        return false;
+    }
+    if (!parcel.WriteUint32(static_cast<uint32_t>(buffer.size()))) {
+        MISC_HILOGE("Write pattern size failed");
+        return false;
+    }
+    if (!parcel.WriteBuffer(buffer.data(), buffer.size())) {
+        MISC_HILOGE("Write pattern buffer failed");
+        return false;
+    }
+    return true;
+}
+
+std::optional<VibratePattern> VibratePattern::Unmarshalling(Parcel &data)
+{
+    uint32_t size = 0;
+    if (!data.ReadUint32(size)) {
+        MISC_HILOGE("Read pattern size failed");
+        return std::nullopt;
+    }
+    if ((size < sizeof(PatternWireHeader)) || (size > MAX_PATTERN_WIRE_SIZE)) {
+        MISC_HILOGE("Invalid pattern size:%{public}u", size);
+        return std::nullopt;
+    }
+    const uint8_t *buffer = data.ReadBuffer(size);
+    if (buffer == nullptr) {
+        MISC_HILOGE("Read pattern buffer failed");
+        return std::nullopt;
+    }
+    return Decode(buffer, size);
+}
+
+bool VibratePackage::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteInt32(packageDuration)) {
+        MISC_HILOGE("Write packageDuration failed");
+        return false;
+    }
+    if (!parcel.WriteInt32(static_cast<int32_t>(patterns.size()))) {
+        MISC_HILOGE("Write patterns's size failed");
+        return false;
+    }
+    for (const auto &pattern : patterns) {
+        if (!pattern.Marshalling(parcel)) {
+            MISC_HILOGE("Write pattern failed");
+            return false;
         }
-        if (pointSize > MAX_POINT_SIZE) {
-            MISC_HILOGE("pointSize exceed the maximum");
+    }
+    return true;
+}
+
+std::optional<VibratePackage> VibratePackage::Unmarshalling(Parcel &data)
+{
+    VibratePackage package;
+    if (!data.ReadInt32(package.packageDuration)) {
+        MISC_HILOGE("Read packageDuration failed");
+        return std::nullopt;
+    }
+    int32_t patternSize { 0 };
+    if (!data.ReadInt32(patternSize)) {
+        MISC_HILOGE("Read patternSize failed");
+        return std::nullopt;
+    }
+    if ((patternSize <= 0) || (patternSize > MAX_PATTERN_SIZE)) {
+        MISC_HILOGE("patternSize is invalid, patternSize:%{public}d", patternSize);
+        return std::nullopt;
+    }
+    for (int32_t i = 0; i < patternSize; ++i) {
+        VibratePattern vibratePattern;
+        auto pattern = vibratePattern.Unmarshalling(data);
+        if (!pattern.has_value()) {
+            MISC_HILOGE("Read pattern failed");
             return std::nullopt;
         }
-        pattern.events.emplace_back(event);
-        for (int32_t j = 0; j < pointSize; ++j) {
-            VibrateCurvePoint point;
-            if (!data.ReadInt32(point.time)) {
-                MISC_HILOGE("Read points's time failed");
-                return std::nullopt;
-            }
-            if (!data.ReadInt32(point.intensity)) {
-                MISC_HILOGE("Read points's intensity failed");
-                return std::nullopt;
-            }
-            if (!data.ReadInt32(point.frequency)) {
-                MISC_HILOGE("Read points's frequency failed");
-                return std::nullopt;
-            }
-            pattern.events[i].points.emplace_back(point);
-        }
+        package.patterns.emplace_back(std::move(pattern.value()));
     }
-    return pattern;
+    return package;
 }
 
 void VibrateParameter::Dump() const
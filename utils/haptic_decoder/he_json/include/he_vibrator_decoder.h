@@ -29,16 +29,16 @@ public:
     HEVibratorDecoder() = default;
     ~HEVibratorDecoder() = default;
     int32_t DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &patternPackage) override;
+    static bool CheckEventParameters(const VibrateEvent &event);
 private:
     int32_t ParseVersion(const JsonParser &parser);
     int32_t ParsePatternList(const JsonParser& parser, cJSON* patternListJSON, VibratePackage& pkg);
     int32_t ParsePattern(const JsonParser &parser, cJSON *patternJSON, VibratePattern &pattern);
     int32_t ParseEvent(const JsonParser &parser, cJSON *eventJSON, VibrateEvent &event);
     int32_t ParseCurve(const JsonParser &parser, cJSON *curveJSON, VibrateEvent &event);
-    bool CheckEventParameters(const VibrateEvent& event);
-    bool CheckCommonParameters(const VibrateEvent& event);
-    bool CheckTransientParameters(const VibrateEvent& event);
-    bool CheckContinuousParameters(const VibrateEvent& event);
+    static bool CheckCommonParameters(const VibrateEvent& event);
+    static bool CheckTransientParameters(const VibrateEvent& event);
+    static bool CheckContinuousParameters(const VibrateEvent& event);
 };
 }  // namespace Sensors
 }  // namespace OHOS
@@ -26,6 +26,9 @@ public:
     ~HEVibratorDecoderFactory() = default;
     IVibratorDecoder *CreateDecoder() override;
 };
+
+// Adds the decoder to VibratorDecoderRegistry, called by VibratorDecoderCreator.
+void RegisterHEDecoder();
 } // namespace Sensors
 } // namespace OHOS
 #endif // HE_VIBRATOR_DECODER_FACTORY_H
\ No newline at end of file
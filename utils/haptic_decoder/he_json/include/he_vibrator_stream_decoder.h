@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HE_VIBRATOR_STREAM_DECODER_H
+#define HE_VIBRATOR_STREAM_DECODER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "i_vibrator_decoder.h"
+#include "json_stream_reader.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Single-pass decoder for .he files built on JsonStreamReader. HEVibratorDecoder stays
+ * as the cJSON based reference it is tested against.
+ */
+class HEVibratorStreamDecoder : public IVibratorDecoder {
+public:
+    HEVibratorStreamDecoder() = default;
+    ~HEVibratorStreamDecoder() = default;
+    int32_t DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &patternPackage) override;
+    int32_t DecodeBuffer(std::string_view data, VibratePackage &pkg);
+private:
+    // Members of one event object, which may appear in any order.
+    struct EventFields {
+        bool hasType = false;
+        bool hasDuration = false;
+        int32_t duration = -1;
+        bool hasIndex = false;
+        bool hasTime = false;
+        bool hasParameters = false;
+        bool hasIntensity = false;
+        bool hasFrequency = false;
+        bool hasCurve = false;
+        // Set when the curve came before the event type and has to be parsed afterwards.
+        std::string_view rawCurve;
+        size_t curveDepth = 0;
+    };
+    int32_t ParseVersion(JsonStreamReader &reader, int32_t &version);
+    int32_t ParsePatternBody(JsonStreamReader &reader, int32_t version, VibratePackage &pkg);
+    int32_t ParsePatternList(JsonStreamReader &reader, VibratePackage &pkg);
+    int32_t ParsePattern(JsonStreamReader &reader, VibratePattern &pattern);
+    int32_t ParseEvent(JsonStreamReader &reader, VibrateEvent &event);
+    int32_t ParseEventMember(JsonStreamReader &reader, const std::string &key, VibrateEvent &event,
+        EventFields &fields);
+    int32_t ParseEventParameters(JsonStreamReader &reader, VibrateEvent &event, EventFields &fields);
+    int32_t CheckEvent(VibrateEvent &event, const EventFields &fields);
+    int32_t ParseCurve(JsonStreamReader &reader, VibrateEvent &event);
+    int32_t ParseCurvePoint(JsonStreamReader &reader, VibrateCurvePoint &point);
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // HE_VIBRATOR_STREAM_DECODER_H
@@ -14,19 +14,38 @@
  */
 
 #include "he_vibrator_decoder_factory.h"
-#include "he_vibrator_decoder.h"
+#include "he_vibrator_stream_decoder.h"
+#include "json_stream_reader.h"
 #include "sensors_errors.h"
+#include "vibrator_decoder_registry.h"
 
 #undef LOG_TAG
 #define LOG_TAG "HEVibratorDecoderFactory"
 
 namespace OHOS {
 namespace Sensors {
+namespace {
+bool ProbeHE(std::string_view head)
+{
+    return JsonStreamReader::HasRootMember(head, { "Pattern", "PatternList" });
+}
+
+IVibratorDecoder *CreateHEDecoder()
+{
+    HEVibratorDecoderFactory factory;
+    return factory.CreateDecoder();
+}
+}  // namespace
 
 IVibratorDecoder *HEVibratorDecoderFactory::CreateDecoder()
 {
     CALL_LOG_ENTER;
-    return new HEVibratorDecoder();
+    return new HEVibratorStreamDecoder();
+}
+
+void RegisterHEDecoder()
+{
+    VibratorDecoderRegistry::GetInstance().Register("he", "he", ProbeHE, CreateHEDecoder);
 }
 } // namespace Sensors
 } // namespace OHOS
\ No newline at end of file
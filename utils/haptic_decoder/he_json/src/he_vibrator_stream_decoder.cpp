@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "he_vibrator_stream_decoder.h"
+
+#include <climits>
+
+#include "he_vibrator_decoder.h"
+#include "mapped_file_view.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HEVibratorStreamDecoder"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr size_t EVENT_NUM_MAX = 16;
+constexpr int32_t SUPPORTED_HE_VERSION_1 = 1;
+constexpr int32_t SUPPORTED_HE_VERSION_2 = 2;
+constexpr int32_t TRANSIENT_VIBRATION_DURATION = 48;
+constexpr size_t CURVE_POINT_NUM_MIN = 4;
+constexpr size_t CURVE_POINT_NUM_MAX = 16;
+constexpr int32_t CURVE_INTENSITY_MIN = 0;
+constexpr int32_t CURVE_INTENSITY_MAX = 100;
+constexpr double CURVE_INTENSITY_SCALE = 100.0;
+constexpr int32_t CURVE_FREQUENCY_MIN = -100;
+constexpr int32_t CURVE_FREQUENCY_MAX = 100;
+constexpr int32_t INVALID_VALUE = -1;
+// Values captured from the root object are replayed at the nesting depth they were read at.
+constexpr size_t ROOT_MEMBER_DEPTH = 1;
+
+// The .he format maps every non-numeric value to -1 and lets the range checks reject it.
+int32_t ReadInt(JsonStreamReader &reader, int32_t &value)
+{
+    if (reader.PeekType() != JsonValueType::NUMBER) {
+        value = INVALID_VALUE;
+        return reader.SkipValue() ? SUCCESS : ERROR;
+    }
+    double number = 0.0;
+    if (!reader.ReadNumber(number)) {
+        return ERROR;
+    }
+    value = JsonStreamReader::ToInt(number);
+    return SUCCESS;
+}
+
+int32_t ReadCurveIntensity(JsonStreamReader &reader, int32_t &intensity)
+{
+    if (reader.PeekType() != JsonValueType::NUMBER) {
+        intensity = INVALID_VALUE;
+        return reader.SkipValue() ? SUCCESS : ERROR;
+    }
+    double value = 0.0;
+    if (!reader.ReadNumber(value)) {
+        return ERROR;
+    }
+    // Truncates like the implicit conversion in the reference decoder, without its overflow.
+    double scaled = value * CURVE_INTENSITY_SCALE;
+    if (!(scaled > static_cast<double>(INT_MIN) - 1.0) || !(scaled < static_cast<double>(INT_MAX) + 1.0)) {
+        MISC_HILOGE("The intensity of curve point is invalid");
+        return ERROR;
+    }
+    intensity = static_cast<int32_t>(scaled);
+    return SUCCESS;
+}
+
+int32_t SkipValue(JsonStreamReader &reader)
+{
+    return reader.SkipValue() ? SUCCESS : ERROR;
+}
+
+bool IsSupportedVersion(int32_t version)
+{
+    return (version == SUPPORTED_HE_VERSION_1) || (version == SUPPORTED_HE_VERSION_2);
+}
+} // namespace
+
+int32_t HEVibratorStreamDecoder::DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &pkg)
+{
+    MappedFileView view;
+    if (view.Map(rawFd, trustedFd_) != SUCCESS) {
+        MISC_HILOGE("Map fd fail");
+        pkg.patterns.clear();
+        return ERROR;
+    }
+    return DecodeBuffer(view.GetData(), pkg);
+}
+
+int32_t HEVibratorStreamDecoder::DecodeBuffer(std::string_view data, VibratePackage &pkg)
+{
+    pkg.patterns.clear();
+    JsonStreamReader reader(data);
+    int32_t version = INVALID_VALUE;
+    bool hasMetadata = false;
+    bool hasPattern = false;
+    bool hasPatternList = false;
+    // Patterns that precede Metadata are only syntax checked here and parsed once the version is known.
+    std::string_view rawPattern;
+    std::string_view rawPatternList;
+    VibratePackage parsed;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasMetadata && JsonStreamReader::KeyEquals(key, "Metadata")) {
+            hasMetadata = true;
+            CHKCR((ParseVersion(reader, version) == SUCCESS), ERROR, "parse version fail");
+            if (!IsSupportedVersion(version)) {
+                MISC_HILOGE("unsupported version %{public}d", version);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        if (!hasPattern && JsonStreamReader::KeyEquals(key, "Pattern")) {
+            hasPattern = true;
+            if (!hasMetadata) {
+                return reader.CaptureValue(rawPattern) ? SUCCESS : ERROR;
+            }
+            return (version == SUPPORTED_HE_VERSION_1) ? ParsePatternBody(reader, version, parsed) : SkipValue(reader);
+        }
+        if (!hasPatternList && JsonStreamReader::KeyEquals(key, "PatternList")) {
+            hasPatternList = true;
+            if (!hasMetadata) {
+                return reader.CaptureValue(rawPatternList) ? SUCCESS : ERROR;
+            }
+            return (version == SUPPORTED_HE_VERSION_2) ? ParsePatternBody(reader, version, parsed) : SkipValue(reader);
+        }
+        return SkipValue(reader);
+    });
+    if (ret != SUCCESS) {
+        MISC_HILOGE("Parse he file fail");
+        return ret;
+    }
+    if (!IsSupportedVersion(version)) {
+        MISC_HILOGE("unsupported version %{public}d", version);
+        return ERROR;
+    }
+    bool isVersion1 = (version == SUPPORTED_HE_VERSION_1);
+    if (!(isVersion1 ? hasPattern : hasPatternList)) {
+        MISC_HILOGE("The pattern of version %{public}d is missing", version);
+        return ERROR;
+    }
+    std::string_view raw = isVersion1 ? rawPattern : rawPatternList;
+    if (!raw.empty()) {
+        JsonStreamReader bodyReader(raw, ROOT_MEMBER_DEPTH);
+        CHKCR((ParsePatternBody(bodyReader, version, parsed) == SUCCESS), ERROR, "parse pattern fail!");
+    }
+    pkg.patterns = std::move(parsed.patterns);
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::ParseVersion(JsonStreamReader &reader, int32_t &version)
+{
+    version = INVALID_VALUE;
+    if (reader.PeekType() != JsonValueType::OBJECT) {
+        return SkipValue(reader);
+    }
+    bool hasVersion = false;
+    return reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasVersion && JsonStreamReader::KeyEquals(key, "Version")) {
+            hasVersion = true;
+            return ReadInt(reader, version);
+        }
+        return SkipValue(reader);
+    });
+}
+
+int32_t HEVibratorStreamDecoder::ParsePatternBody(JsonStreamReader &reader, int32_t version, VibratePackage &pkg)
+{
+    if (version == SUPPORTED_HE_VERSION_2) {
+        return ParsePatternList(reader, pkg);
+    }
+    VibratePattern pattern;
+    pattern.startTime = 0;
+    CHKCR((ParsePattern(reader, pattern) == SUCCESS), ERROR, "parse pattern fail!");
+    pkg.patterns.emplace_back(std::move(pattern));
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::ParsePatternList(JsonStreamReader &reader, VibratePackage &pkg)
+{
+    if (reader.PeekType() != JsonValueType::ARRAY) {
+        MISC_HILOGE("The value of pattern list is not array!");
+        return ERROR;
+    }
+    int32_t previousPatternTime = INVALID_VALUE;
+    int32_t ret = reader.ForEachElement([&](size_t) -> int32_t {
+        bool hasTime = false;
+        bool hasPattern = false;
+        int32_t time = INVALID_VALUE;
+        VibratePattern pattern;
+        int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+            if (!hasTime && JsonStreamReader::KeyEquals(key, "AbsoluteTime")) {
+                hasTime = true;
+                return ReadInt(reader, time);
+            }
+            if (!hasPattern && JsonStreamReader::KeyEquals(key, "Pattern")) {
+                hasPattern = true;
+                return ParsePattern(reader, pattern);
+            }
+            return SkipValue(reader);
+        });
+        CHKCR((ret == SUCCESS) && hasTime && hasPattern, ERROR, "parse pattern list item fail!");
+        if (time <= previousPatternTime) {
+            MISC_HILOGE("The value of absolute time %{public}d is invalid!", time);
+            return ERROR;
+        }
+        previousPatternTime = time;
+        pattern.startTime = time;
+        pkg.patterns.emplace_back(std::move(pattern));
+        return SUCCESS;
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse pattern list fail!");
+    if (pkg.patterns.empty()) {
+        MISC_HILOGE("The size of pattern list is invalid!");
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::ParsePattern(JsonStreamReader &reader, VibratePattern &pattern)
+{
+    if (reader.PeekType() != JsonValueType::ARRAY) {
+        MISC_HILOGE("The value of pattern is not array");
+        return ERROR;
+    }
+    int32_t previousEventTime = 0;
+    int32_t ret = reader.ForEachElement([&](size_t index) -> int32_t {
+        if (index >= EVENT_NUM_MAX) {
+            MISC_HILOGE("The size of pattern is out of bounds");
+            return ERROR;
+        }
+        bool hasEvent = false;
+        VibrateEvent event;
+        int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+            if (!hasEvent && JsonStreamReader::KeyEquals(key, "Event")) {
+                hasEvent = true;
+                return ParseEvent(reader, event);
+            }
+            return SkipValue(reader);
+        });
+        CHKCR((ret == SUCCESS) && hasEvent, ERROR, "parse event fail!");
+        if (event.time < previousEventTime) {
+            MISC_HILOGE("The value of absolute time %{public}d is invalid!", event.time);
+            return ERROR;
+        }
+        previousEventTime = event.time;
+        pattern.events.emplace_back(std::move(event));
+        return SUCCESS;
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse pattern fail!");
+    if (pattern.events.empty()) {
+        MISC_HILOGE("The size of pattern is out of bounds");
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::ParseEvent(JsonStreamReader &reader, VibrateEvent &event)
+{
+    EventFields fields;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        return ParseEventMember(reader, key, event, fields);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse event members fail");
+    return CheckEvent(event, fields);
+}
+
+int32_t HEVibratorStreamDecoder::ParseEventMember(JsonStreamReader &reader, const std::string &key,
+    VibrateEvent &event, EventFields &fields)
+{
+    if (!fields.hasType && JsonStreamReader::KeyEquals(key, "Type")) {
+        fields.hasType = true;
+        std::string type;
+        if (reader.PeekType() == JsonValueType::STRING) {
+            CHKCR(reader.ReadString(type), ERROR, "read event type fail");
+        } else {
+            CHKCR(reader.SkipValue(), ERROR, "skip event type fail");
+        }
+        if (type == "transient") {
+            event.tag = EVENT_TAG_TRANSIENT;
+        } else if (type == "continuous") {
+            event.tag = EVENT_TAG_CONTINUOUS;
+        } else {
+            MISC_HILOGE("Unknown event type %{public}s", type.c_str());
+            return ERROR;
+        }
+        return SUCCESS;
+    }
+    if (!fields.hasDuration && JsonStreamReader::KeyEquals(key, "Duration")) {
+        fields.hasDuration = true;
+        return ReadInt(reader, fields.duration);
+    }
+    if (!fields.hasIndex && JsonStreamReader::KeyEquals(key, "Index")) {
+        fields.hasIndex = true;
+        return ReadInt(reader, event.index);
+    }
+    if (!fields.hasTime && JsonStreamReader::KeyEquals(key, "RelativeTime")) {
+        fields.hasTime = true;
+        return ReadInt(reader, event.time);
+    }
+    if (!fields.hasParameters && JsonStreamReader::KeyEquals(key, "Parameters")) {
+        fields.hasParameters = true;
+        return ParseEventParameters(reader, event, fields);
+    }
+    return SkipValue(reader);
+}
+
+int32_t HEVibratorStreamDecoder::ParseEventParameters(JsonStreamReader &reader, VibrateEvent &event,
+    EventFields &fields)
+{
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!fields.hasIntensity && JsonStreamReader::KeyEquals(key, "Intensity")) {
+            fields.hasIntensity = true;
+            return ReadInt(reader, event.intensity);
+        }
+        if (!fields.hasFrequency && JsonStreamReader::KeyEquals(key, "Frequency")) {
+            fields.hasFrequency = true;
+            return ReadInt(reader, event.frequency);
+        }
+        if (!fields.hasCurve && JsonStreamReader::KeyEquals(key, "Curve")) {
+            fields.hasCurve = true;
+            if (!fields.hasType) {
+                fields.curveDepth = reader.GetDepth();
+                return reader.CaptureValue(fields.rawCurve) ? SUCCESS : ERROR;
+            }
+            return (event.tag == EVENT_TAG_CONTINUOUS) ? ParseCurve(reader, event) : SkipValue(reader);
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse event parameters fail");
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::CheckEvent(VibrateEvent &event, const EventFields &fields)
+{
+    if (!fields.hasType || !fields.hasTime || !fields.hasParameters || !fields.hasIntensity ||
+        !fields.hasFrequency) {
+        MISC_HILOGE("The event is incomplete");
+        return ERROR;
+    }
+    if (event.tag == EVENT_TAG_TRANSIENT) {
+        event.duration = TRANSIENT_VIBRATION_DURATION;
+        event.points.clear();
+    } else {
+        if (!fields.hasDuration || !fields.hasCurve) {
+            MISC_HILOGE("The duration or curve of continuous event is missing");
+            return ERROR;
+        }
+        event.duration = fields.duration;
+        if (!fields.rawCurve.empty()) {
+            JsonStreamReader curveReader(fields.rawCurve, fields.curveDepth);
+            CHKCR((ParseCurve(curveReader, event) == SUCCESS), ERROR, "parse curve fail");
+        }
+        // The duration may follow the curve in the file, so this is the only check that waits for the whole event.
+        for (const auto &point : event.points) {
+            if (point.time > event.duration) {
+                MISC_HILOGE("The time of curve point is invalid, time:%{public}d", point.time);
+                return ERROR;
+            }
+        }
+    }
+    if (!HEVibratorDecoder::CheckEventParameters(event)) {
+        MISC_HILOGE("Parameter check of vibration event failed, startTime:%{public}d", event.time);
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::ParseCurve(JsonStreamReader &reader, VibrateEvent &event)
+{
+    if (reader.PeekType() != JsonValueType::ARRAY) {
+        MISC_HILOGE("The value of curve is not array");
+        return ERROR;
+    }
+    int32_t previousCurveTime = INVALID_VALUE;
+    int32_t ret = reader.ForEachElement([&](size_t index) -> int32_t {
+        if (index >= CURVE_POINT_NUM_MAX) {
+            MISC_HILOGE("The size of curve point is out of bounds");
+            return ERROR;
+        }
+        VibrateCurvePoint point;
+        CHKCR((ParseCurvePoint(reader, point) == SUCCESS), ERROR, "parse curve point fail");
+        if (point.time <= previousCurveTime) {
+            MISC_HILOGE("The time of curve point is invalid, time:%{public}d", point.time);
+            return ERROR;
+        }
+        previousCurveTime = point.time;
+        event.points.emplace_back(point);
+        return SUCCESS;
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse curve fail");
+    if (event.points.size() < CURVE_POINT_NUM_MIN) {
+        MISC_HILOGE("The size of curve point is out of bounds, size:%{public}zu", event.points.size());
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+int32_t HEVibratorStreamDecoder::ParseCurvePoint(JsonStreamReader &reader, VibrateCurvePoint &point)
+{
+    bool hasTime = false;
+    bool hasIntensity = false;
+    bool hasFrequency = false;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasTime && JsonStreamReader::KeyEquals(key, "Time")) {
+            hasTime = true;
+            return ReadInt(reader, point.time);
+        }
+        if (!hasIntensity && JsonStreamReader::KeyEquals(key, "Intensity")) {
+            hasIntensity = true;
+            CHKCR((ReadCurveIntensity(reader, point.intensity) == SUCCESS), ERROR, "read curve intensity fail");
+            if ((point.intensity < CURVE_INTENSITY_MIN) || (point.intensity > CURVE_INTENSITY_MAX)) {
+                MISC_HILOGE("The intensity of curve point is invalid, intensity:%{public}d", point.intensity);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        if (!hasFrequency && JsonStreamReader::KeyEquals(key, "Frequency")) {
+            hasFrequency = true;
+            CHKCR((ReadInt(reader, point.frequency) == SUCCESS), ERROR, "read curve frequency fail");
+            if ((point.frequency < CURVE_FREQUENCY_MIN) || (point.frequency > CURVE_FREQUENCY_MAX)) {
+                MISC_HILOGE("The freq of curve point is invalid, freq:%{public}d", point.frequency);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse curve point members fail");
+    CHKCR((hasTime && hasIntensity && hasFrequency), ERROR, "curve point is incomplete");
+    return SUCCESS;
+}
+} // namespace Sensors
+} // namespace OHOS
@@ -26,6 +26,14 @@ public:
     IVibratorDecoder() = default;
     virtual ~IVibratorDecoder() = default;
     virtual int32_t DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &patternPackage) = 0;
+    // Lets the decoder mmap the fd, see MappedFileView::Map. Only the fd owner may set it.
+    void SetTrustedFd(bool trustedFd)
+    {
+        trustedFd_ = trustedFd;
+    }
+
+protected:
+    bool trustedFd_ = false;
 };
 }  // namespace Sensors
 }  // namespace OHOS
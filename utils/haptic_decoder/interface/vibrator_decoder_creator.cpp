@@ -14,13 +14,13 @@
  */
 #include "vibrator_decoder_creator.h"
 
-#include <fcntl.h>
-#include <unistd.h>
+#include <mutex>
 
+#include "binary_vibrator_decoder_factory.h"
 #include "default_vibrator_decoder_factory.h"
-#include "file_utils.h"
 #include "he_vibrator_decoder_factory.h"
 #include "sensors_errors.h"
+#include "vibrator_decoder_registry.h"
 
 #undef LOG_TAG
 #define LOG_TAG "VibratorDecoderCreator"
@@ -28,39 +28,22 @@
 namespace OHOS {
 namespace Sensors {
 
-IVibratorDecoder *VibratorDecoderCreator::CreateDecoder(const RawFileDescriptor &fd)
+void VibratorDecoderCreator::RegisterDecoders()
 {
-    CALL_LOG_ENTER;
-    DecoderType type = GetDecoderType(fd);
-    if (type == DECODER_TYPE_HE) {
-        MISC_HILOGD("Get he decoder");
-        HEVibratorDecoderFactory factory;
-        return factory.CreateDecoder();
-    } else if (type == DECODER_TYPE_OH_JSON) {
-        MISC_HILOGD("Get oh_json decoder");
-        DefaultVibratorDecoderFactory factory;
-        return factory.CreateDecoder();
-    }
-    MISC_HILOGE("Invalid decoder type");
-    return nullptr;
+    static std::once_flag registerFlag;
+    // Probes are asked in this order: the binary magic is exact, then the JSON root keys.
+    std::call_once(registerFlag, [] {
+        RegisterBinaryDecoder();
+        RegisterOhJsonDecoder();
+        RegisterHEDecoder();
+    });
 }
 
-DecoderType VibratorDecoderCreator::GetDecoderType(const RawFileDescriptor &rawFd)
+IVibratorDecoder *VibratorDecoderCreator::CreateDecoder(const RawFileDescriptor &fd)
 {
-    std::string extName = "";
-    int32_t ret = GetFileExtName(rawFd.fd, extName);
-    if (ret != SUCCESS) {
-        MISC_HILOGE("GetFileExtName failed");
-        return DECODER_TYPE_BUTT;
-    }
-    if (extName == "he") {
-        return DECODER_TYPE_HE;
-    } else if (extName == "json") {
-        return DECODER_TYPE_OH_JSON;
-    } else {
-        MISC_HILOGE("Invalid decoder extend name");
-        return DECODER_TYPE_BUTT;
-    }
+    CALL_LOG_ENTER;
+    RegisterDecoders();
+    return VibratorDecoderRegistry::GetInstance().CreateDecoder(fd);
 }
 
 extern "C" IVibratorDecoder *Create(const RawFileDescriptor &rawFd)
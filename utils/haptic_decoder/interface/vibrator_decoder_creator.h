@@ -22,20 +22,13 @@
 
 namespace OHOS {
 namespace Sensors {
-enum DecoderType {
-    DECODER_TYPE_OH_JSON = 0,
-    DECODER_TYPE_HE = 1,
-    DECODER_TYPE_BUTT,
-};
-
 class VibratorDecoderCreator {
 public:
     VibratorDecoderCreator() = default;
     virtual ~VibratorDecoderCreator() = default;
     IVibratorDecoder *CreateDecoder(const RawFileDescriptor &rawFd);
-
-private:
-    DecoderType GetDecoderType(const RawFileDescriptor &rawFd);
+    // Registers the built-in decoders once, in probe order.
+    static void RegisterDecoders();
 };
 }  // namespace Sensors
 }  // namespace OHOS
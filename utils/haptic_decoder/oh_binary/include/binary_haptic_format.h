@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BINARY_HAPTIC_FORMAT_H
+#define BINARY_HAPTIC_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vibrator_infos.h"
+
+namespace OHOS {
+namespace Sensors {
+// "OHHB" in file byte order.
+constexpr uint32_t BINARY_HAPTIC_MAGIC = 0x4248484F;
+constexpr uint32_t BINARY_HAPTIC_VERSION = 1;
+// Same cap as the .json and .he text files, which always encode to a smaller container.
+constexpr int64_t MAX_BINARY_HAPTIC_SIZE = 64 * 1024;
+const std::string BINARY_HAPTIC_EXTENSION = "ohb";
+
+/*
+ * Pre-compiled haptic container, every field is a little-endian 32-bit word whatever the host
+ * byte order:
+ *   BinaryHapticHeader
+ *   BinaryPatternRecord[patternCount]
+ *   BinaryEventRecord[eventCount]
+ *   BinaryPointRecord[pointCount]
+ * Each pattern owns the next contiguous run of event records and each event the next run of
+ * points, so a record is validated against the header and a running cursor in O(1).
+ * Bump BINARY_HAPTIC_VERSION on any layout change.
+ */
+struct BinaryHapticHeader {
+    uint32_t magic = BINARY_HAPTIC_MAGIC;
+    uint32_t version = BINARY_HAPTIC_VERSION;
+    uint32_t headerSize = 0;
+    int32_t packageDuration = 0;
+    uint32_t patternCount = 0;
+    uint32_t eventCount = 0;
+    uint32_t pointCount = 0;
+    uint32_t reserved = 0;
+};
+
+struct BinaryPatternRecord {
+    int32_t startTime = 0;
+    int32_t patternDuration = 0;
+    uint32_t firstEvent = 0;
+    uint32_t eventCount = 0;
+};
+
+struct BinaryEventRecord {
+    int32_t tag = 0;
+    int32_t time = 0;
+    int32_t duration = 0;
+    int32_t intensity = 0;
+    int32_t frequency = 0;
+    int32_t index = 0;
+    uint32_t firstPoint = 0;
+    uint32_t pointCount = 0;
+};
+
+struct BinaryPointRecord {
+    int32_t time = 0;
+    int32_t intensity = 0;
+    int32_t frequency = 0;
+};
+
+// Rejects every package DecodeBinaryHaptic would reject, so a container that is written always decodes.
+int32_t EncodeBinaryHaptic(const VibratePackage &pkg, std::vector<uint8_t> &buffer);
+int32_t DecodeBinaryHaptic(const uint8_t *data, size_t size, VibratePackage &pkg);
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // BINARY_HAPTIC_FORMAT_H
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BINARY_VIBRATOR_DECODER_H
+#define BINARY_VIBRATOR_DECODER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "i_vibrator_decoder.h"
+
+namespace OHOS {
+namespace Sensors {
+/*
+ * Decoder for pre-compiled .ohb containers produced by haptic_converter. The file is
+ * mapped and its records are copied straight into the package, without any text parsing.
+ */
+class BinaryVibratorDecoder : public IVibratorDecoder {
+public:
+    BinaryVibratorDecoder() = default;
+    ~BinaryVibratorDecoder() = default;
+    int32_t DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &patternPackage) override;
+    int32_t DecodeBuffer(std::string_view data, VibratePackage &pkg);
+};
+}  // namespace Sensors
+}  // namespace OHOS
+#endif  // BINARY_VIBRATOR_DECODER_H
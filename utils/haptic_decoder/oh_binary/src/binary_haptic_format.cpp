@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "binary_haptic_format.h"
+
+#include <algorithm>
+
+#include "sensors_errors.h"
+#include "vibrate_package_checker.h"
+
+#undef LOG_TAG
+#define LOG_TAG "BinaryHapticFormat"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr size_t WORD_SIZE = sizeof(uint32_t);
+constexpr size_t MAX_BINARY_EVENT_COUNT = static_cast<size_t>(MAX_BINARY_HAPTIC_SIZE) / sizeof(BinaryEventRecord);
+constexpr size_t MAX_BINARY_POINT_COUNT = static_cast<size_t>(MAX_BINARY_HAPTIC_SIZE) / sizeof(BinaryPointRecord);
+static_assert(sizeof(BinaryHapticHeader) == 8 * WORD_SIZE, "BinaryHapticHeader must not be padded");
+static_assert(sizeof(BinaryPatternRecord) == 4 * WORD_SIZE, "BinaryPatternRecord must not be padded");
+static_assert(sizeof(BinaryEventRecord) == 8 * WORD_SIZE, "BinaryEventRecord must not be padded");
+static_assert(sizeof(BinaryPointRecord) == 3 * WORD_SIZE, "BinaryPointRecord must not be padded");
+
+// Records are runs of 32-bit words, so converting between host and file byte order swaps each word.
+void SwapWordsIfBigEndian(uint8_t *bytes, size_t size)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    for (size_t i = 0; i + WORD_SIZE <= size; i += WORD_SIZE) {
+        std::reverse(bytes + i, bytes + i + WORD_SIZE);
+    }
+#else
+    (void)bytes;
+    (void)size;
+#endif
+}
+
+template<typename Record>
+void WriteRecord(const Record &record, uint8_t *base, size_t &offset)
+{
+    std::copy_n(reinterpret_cast<const uint8_t *>(&record), sizeof(record), base + offset);
+    SwapWordsIfBigEndian(base + offset, sizeof(record));
+    offset += sizeof(record);
+}
+
+// The view may start at any asset offset, so records are copied out instead of cast in place.
+template<typename Record>
+Record ReadRecord(const uint8_t *base, size_t &offset)
+{
+    Record record;
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(&record);
+    std::copy_n(base + offset, sizeof(record), bytes);
+    SwapWordsIfBigEndian(bytes, sizeof(record));
+    offset += sizeof(record);
+    return record;
+}
+
+bool IsValidTag(int32_t tag)
+{
+    return (tag == EVENT_TAG_CONTINUOUS) || (tag == EVENT_TAG_TRANSIENT);
+}
+}  // namespace
+
+int32_t EncodeBinaryHaptic(const VibratePackage &pkg, std::vector<uint8_t> &buffer)
+{
+    // The .he decoder has no upper bound on times, so a text file may decode to a package the
+    // container cannot hold.
+    if (!VibratePackageChecker::CheckPackage(pkg)) {
+        MISC_HILOGE("Package is out of the binary haptic bounds");
+        return PARAMETER_ERROR;
+    }
+    BinaryHapticHeader header = {
+        .headerSize = sizeof(BinaryHapticHeader),
+        .packageDuration = pkg.packageDuration,
+        .patternCount = static_cast<uint32_t>(pkg.patterns.size()),
+    };
+    for (const auto &pattern : pkg.patterns) {
+        header.eventCount += static_cast<uint32_t>(pattern.events.size());
+        for (const auto &event : pattern.events) {
+            header.pointCount += static_cast<uint32_t>(event.points.size());
+        }
+    }
+    size_t patternOffset = sizeof(BinaryHapticHeader);
+    size_t eventOffset = patternOffset + header.patternCount * sizeof(BinaryPatternRecord);
+    size_t pointOffset = eventOffset + header.eventCount * sizeof(BinaryEventRecord);
+    size_t totalSize = pointOffset + header.pointCount * sizeof(BinaryPointRecord);
+    if (totalSize > static_cast<size_t>(MAX_BINARY_HAPTIC_SIZE)) {
+        MISC_HILOGE("Binary haptic exceed the maximum size, size:%{public}zu", totalSize);
+        return PARAMETER_ERROR;
+    }
+    buffer.assign(totalSize, 0);
+    uint8_t *base = buffer.data();
+    size_t headerOffset = 0;
+    WriteRecord(header, base, headerOffset);
+    uint32_t eventCursor = 0;
+    uint32_t pointCursor = 0;
+    for (const auto &pattern : pkg.patterns) {
+        BinaryPatternRecord patternRecord = {
+            .startTime = pattern.startTime,
+            .patternDuration = pattern.patternDuration,
+            .firstEvent = eventCursor,
+            .eventCount = static_cast<uint32_t>(pattern.events.size()),
+        };
+        WriteRecord(patternRecord, base, patternOffset);
+        eventCursor += patternRecord.eventCount;
+        for (const auto &event : pattern.events) {
+            BinaryEventRecord eventRecord = {
+                .tag = static_cast<int32_t>(event.tag),
+                .time = event.time,
+                .duration = event.duration,
+                .intensity = event.intensity,
+                .frequency = event.frequency,
+                .index = event.index,
+                .firstPoint = pointCursor,
+                .pointCount = static_cast<uint32_t>(event.points.size()),
+            };
+            WriteRecord(eventRecord, base, eventOffset);
+            pointCursor += eventRecord.pointCount;
+            for (const auto &point : event.points) {
+                BinaryPointRecord pointRecord = {
+                    .time = point.time,
+                    .intensity = point.intensity,
+                    .frequency = point.frequency,
+                };
+                WriteRecord(pointRecord, base, pointOffset);
+            }
+        }
+    }
+    return SUCCESS;
+}
+
+int32_t DecodeBinaryHaptic(const uint8_t *data, size_t size, VibratePackage &pkg)
+{
+    CHKPR(data, PARAMETER_ERROR);
+    if ((size < sizeof(BinaryHapticHeader)) || (size > static_cast<size_t>(MAX_BINARY_HAPTIC_SIZE))) {
+        MISC_HILOGE("Binary haptic size is out of range, size:%{public}zu", size);
+        return ERROR;
+    }
+    size_t offset = 0;
+    BinaryHapticHeader header = ReadRecord<BinaryHapticHeader>(data, offset);
+    if ((header.magic != BINARY_HAPTIC_MAGIC) || (header.version != BINARY_HAPTIC_VERSION) ||
+        (header.headerSize != sizeof(BinaryHapticHeader))) {
+        MISC_HILOGE("Unsupported binary haptic, magic:%{public}x, version:%{public}u", header.magic, header.version);
+        return ERROR;
+    }
+    if ((header.patternCount > static_cast<uint32_t>(MAX_PATTERN_SIZE)) ||
+        (header.eventCount > MAX_BINARY_EVENT_COUNT) || (header.pointCount > MAX_BINARY_POINT_COUNT)) {
+        MISC_HILOGE("Binary haptic exceed the maximum, patterns:%{public}u, events:%{public}u, points:%{public}u",
+            header.patternCount, header.eventCount, header.pointCount);
+        return ERROR;
+    }
+    size_t eventOffset = sizeof(BinaryHapticHeader) + header.patternCount * sizeof(BinaryPatternRecord);
+    size_t pointOffset = eventOffset + header.eventCount * sizeof(BinaryEventRecord);
+    if (size != pointOffset + header.pointCount * sizeof(BinaryPointRecord)) {
+        MISC_HILOGE("Binary haptic size mismatch, size:%{public}zu", size);
+        return ERROR;
+    }
+    VibratePackage decoded;
+    decoded.packageDuration = header.packageDuration;
+    decoded.patterns.resize(header.patternCount);
+    uint32_t eventCursor = 0;
+    uint32_t pointCursor = 0;
+    for (auto &pattern : decoded.patterns) {
+        auto patternRecord = ReadRecord<BinaryPatternRecord>(data, offset);
+        if ((patternRecord.firstEvent != eventCursor) ||
+            (patternRecord.eventCount > static_cast<uint32_t>(MAX_EVENT_SIZE)) ||
+            (patternRecord.eventCount > header.eventCount - eventCursor)) {
+            MISC_HILOGE("Invalid pattern record, firstEvent:%{public}u, eventCount:%{public}u",
+                patternRecord.firstEvent, patternRecord.eventCount);
+            return ERROR;
+        }
+        eventCursor += patternRecord.eventCount;
+        pattern.startTime = patternRecord.startTime;
+        pattern.patternDuration = patternRecord.patternDuration;
+        pattern.events.resize(patternRecord.eventCount);
+        for (auto &event : pattern.events) {
+            auto eventRecord = ReadRecord<BinaryEventRecord>(data, eventOffset);
+            if (!IsValidTag(eventRecord.tag) || (eventRecord.firstPoint != pointCursor) ||
+                (eventRecord.pointCount > static_cast<uint32_t>(MAX_POINT_SIZE)) ||
+                (eventRecord.pointCount > header.pointCount - pointCursor)) {
+                MISC_HILOGE("Invalid event record, tag:%{public}d, firstPoint:%{public}u, pointCount:%{public}u",
+                    eventRecord.tag, eventRecord.firstPoint, eventRecord.pointCount);
+                return ERROR;
+            }
+            pointCursor += eventRecord.pointCount;
+            event.tag = static_cast<VibrateTag>(eventRecord.tag);
+            event.time = eventRecord.time;
+            event.duration = eventRecord.duration;
+            event.intensity = eventRecord.intensity;
+            event.frequency = eventRecord.frequency;
+            event.index = eventRecord.index;
+            event.points.resize(eventRecord.pointCount);
+            for (auto &point : event.points) {
+                auto pointRecord = ReadRecord<BinaryPointRecord>(data, pointOffset);
+                point.time = pointRecord.time;
+                point.intensity = pointRecord.intensity;
+                point.frequency = pointRecord.frequency;
+            }
+        }
+    }
+    if ((eventCursor != header.eventCount) || (pointCursor != header.pointCount)) {
+        MISC_HILOGE("Binary haptic has dangling records, events:%{public}u, points:%{public}u",
+            eventCursor, pointCursor);
+        return ERROR;
+    }
+    // The layout checks above only keep the records in bounds, the values get the same checks as a
+    // package registered over IPC.
+    if (!VibratePackageChecker::CheckPackage(decoded)) {
+        MISC_HILOGE("Binary haptic has invalid values");
+        return ERROR;
+    }
+    pkg = std::move(decoded);
+    return SUCCESS;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "binary_vibrator_decoder.h"
+
+#include <cinttypes>
+
+#include "binary_haptic_format.h"
+#include "mapped_file_view.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "BinaryVibratorDecoder"
+
+namespace OHOS {
+namespace Sensors {
+int32_t BinaryVibratorDecoder::DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &pkg)
+{
+    if ((rawFd.fd < 0) || (rawFd.offset < 0) || (rawFd.length <= 0) || (rawFd.length > MAX_BINARY_HAPTIC_SIZE)) {
+        MISC_HILOGE("Invalid file descriptor, fd:%{public}d, offset:%{public}" PRId64 ", length:%{public}" PRId64,
+            rawFd.fd, rawFd.offset, rawFd.length);
+        pkg.patterns.clear();
+        return PARAMETER_ERROR;
+    }
+    MappedFileView view;
+    if (view.Map(rawFd, trustedFd_) != SUCCESS) {
+        MISC_HILOGE("Map fd fail");
+        pkg.patterns.clear();
+        return ERROR;
+    }
+    return DecodeBuffer(view.GetData(), pkg);
+}
+
+int32_t BinaryVibratorDecoder::DecodeBuffer(std::string_view data, VibratePackage &pkg)
+{
+    pkg.patterns.clear();
+    if (DecodeBinaryHaptic(reinterpret_cast<const uint8_t *>(data.data()), data.size(), pkg) != SUCCESS) {
+        MISC_HILOGE("DecodeBinaryHaptic fail");
+        return ERROR;
+    }
+    return SUCCESS;
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "binary_vibrator_decoder_factory.h"
+
+#include "binary_haptic_format.h"
+#include "binary_vibrator_decoder.h"
+#include "sensors_errors.h"
+#include "vibrator_decoder_registry.h"
+
+#undef LOG_TAG
+#define LOG_TAG "BinaryVibratorDecoderFactory"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr uint32_t BITS_PER_BYTE = 8;
+
+bool ProbeBinary(std::string_view head)
+{
+    uint32_t magic = 0;
+    if (head.size() < sizeof(magic)) {
+        return false;
+    }
+    // The magic is stored little-endian like every other field.
+    for (size_t i = 0; i < sizeof(magic); ++i) {
+        magic |= static_cast<uint32_t>(static_cast<uint8_t>(head[i])) << (i * BITS_PER_BYTE);
+    }
+    return (magic == BINARY_HAPTIC_MAGIC);
+}
+
+IVibratorDecoder *CreateBinaryDecoder()
+{
+    BinaryVibratorDecoderFactory factory;
+    return factory.CreateDecoder();
+}
+}  // namespace
+
+IVibratorDecoder *BinaryVibratorDecoderFactory::CreateDecoder()
+{
+    CALL_LOG_ENTER;
+    return new BinaryVibratorDecoder();
+}
+
+void RegisterBinaryDecoder()
+{
+    VibratorDecoderRegistry::GetInstance().Register("oh_binary", BINARY_HAPTIC_EXTENSION.c_str(), ProbeBinary,
+        CreateBinaryDecoder);
+}
+}  // namespace Sensors
+}  // namespace OHOS
@@ -29,6 +29,8 @@ public:
     DefaultVibratorDecoder() = default;
     ~DefaultVibratorDecoder() = default;
     int32_t DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &patternPackage) override;
+    static bool CheckEventParameters(const VibrateEvent &event);
+    static void PatternSplit(VibratePattern &originPattern, VibratePackage &patternPackage);
 
 private:
     int32_t CheckMetadata(const JsonParser &parser);
@@ -36,9 +38,7 @@ private:
     int32_t ParseChannelParameters(const JsonParser &parser, cJSON *channelParametersItem);
     int32_t ParsePattern(const JsonParser &parser, cJSON *patternItem, VibratePattern &originPattern);
     int32_t ParseEvent(const JsonParser &parser, cJSON *eveventItement, VibrateEvent &events);
-    bool CheckEventParameters(const VibrateEvent &event);
     int32_t ParseCurve(const JsonParser &parser, cJSON *curveItem, VibrateEvent &event);
-    void PatternSplit(VibratePattern &originPattern, VibratePackage &patternPackage);
     int32_t channelNumber_ = 0;
     double version_ = 0.0;
 };
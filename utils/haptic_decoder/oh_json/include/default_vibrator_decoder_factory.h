@@ -26,6 +26,9 @@ public:
     ~DefaultVibratorDecoderFactory() = default;
     IVibratorDecoder *CreateDecoder() override;
 };
+
+// Adds the decoder to VibratorDecoderRegistry, called by VibratorDecoderCreator.
+void RegisterOhJsonDecoder();
 }  // namespace Sensors
 }  // namespace OHOS
 #endif  // DEFAULT_VIBRATOR_DECODER_FACTORY_H
\ No newline at end of file
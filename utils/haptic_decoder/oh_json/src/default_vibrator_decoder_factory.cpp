@@ -15,19 +15,38 @@
 
 #include "default_vibrator_decoder_factory.h"
 
-#include "default_vibrator_decoder.h"
+#include "default_vibrator_stream_decoder.h"
+#include "json_stream_reader.h"
 #include "sensors_errors.h"
+#include "vibrator_decoder_registry.h"
 
 #undef LOG_TAG
 #define LOG_TAG "DefaultVibratorDecoderFactory"
 
 namespace OHOS {
 namespace Sensors {
+namespace {
+bool ProbeOhJson(std::string_view head)
+{
+    return JsonStreamReader::HasRootMember(head, { "Channels" });
+}
+
+IVibratorDecoder *CreateOhJsonDecoder()
+{
+    DefaultVibratorDecoderFactory factory;
+    return factory.CreateDecoder();
+}
+}  // namespace
 
 IVibratorDecoder *DefaultVibratorDecoderFactory::CreateDecoder()
 {
     CALL_LOG_ENTER;
-    return new DefaultVibratorDecoder();
+    return new DefaultVibratorStreamDecoder();
+}
+
+void RegisterOhJsonDecoder()
+{
+    VibratorDecoderRegistry::GetInstance().Register("oh_json", "json", ProbeOhJson, CreateOhJsonDecoder);
 }
 }  // namespace Sensors
 }  // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "default_vibrator_stream_decoder.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <climits>
+
+#include "default_vibrator_decoder.h"
+#include "mapped_file_view.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "DefaultVibratorStreamDecoder"
+
+namespace OHOS {
+namespace Sensors {
+namespace {
+constexpr int32_t TRANSIENT_VIBRATION_DURATION = 48;
+constexpr size_t EVENT_NUM_MAX = 128;
+constexpr double SUPPORT_JSON_VERSION = 1.0;
+constexpr int32_t SUPPORT_CHANNEL_NUMBER = 3;
+constexpr size_t CURVE_POINT_MIN = 4;
+constexpr size_t CURVE_POINT_MAX = 16;
+constexpr int32_t CURVE_INTENSITY_MIN = 0;
+constexpr int32_t CURVE_INTENSITY_MAX = 100;
+constexpr double CURVE_INTENSITY_SCALE = 100.0;
+constexpr int32_t CURVE_FREQUENCY_MIN = -100;
+constexpr int32_t CURVE_FREQUENCY_MAX = 100;
+constexpr int64_t MAX_JSON_FILE_SIZE = 64 * 1024;
+
+int32_t ReadInt(JsonStreamReader &reader, int32_t &value)
+{
+    double number = 0.0;
+    if ((reader.PeekType() != JsonValueType::NUMBER) || !reader.ReadNumber(number)) {
+        return ERROR;
+    }
+    value = JsonStreamReader::ToInt(number);
+    return SUCCESS;
+}
+
+int32_t ReadDouble(JsonStreamReader &reader, double &value)
+{
+    if ((reader.PeekType() != JsonValueType::NUMBER) || !reader.ReadNumber(value)) {
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+int32_t SkipValue(JsonStreamReader &reader)
+{
+    return reader.SkipValue() ? SUCCESS : ERROR;
+}
+
+bool ScaleCurveIntensity(double value, int32_t &intensity)
+{
+    // Truncates like the implicit conversion in the reference decoder, without its overflow.
+    double scaled = value * CURVE_INTENSITY_SCALE;
+    if (!(scaled > static_cast<double>(INT_MIN) - 1.0) || !(scaled < static_cast<double>(INT_MAX) + 1.0)) {
+        return false;
+    }
+    intensity = static_cast<int32_t>(scaled);
+    return true;
+}
+}  // namespace
+
+int32_t DefaultVibratorStreamDecoder::DecodeEffect(const RawFileDescriptor &rawFd, VibratePackage &patternPackage)
+{
+    if ((rawFd.fd < 0) || (rawFd.offset < 0) || (rawFd.length <= 0) || (rawFd.length > MAX_JSON_FILE_SIZE)) {
+        MISC_HILOGE("Invalid file descriptor, fd:%{public}d, offset:%{public}" PRId64 ", length:%{public}" PRId64,
+            rawFd.fd, rawFd.offset, rawFd.length);
+        return PARAMETER_ERROR;
+    }
+    MappedFileView view;
+    if (view.Map(rawFd, trustedFd_) != SUCCESS) {
+        MISC_HILOGE("Map fd fail");
+        return ERROR;
+    }
+    return DecodeBuffer(view.GetData(), patternPackage);
+}
+
+int32_t DefaultVibratorStreamDecoder::DecodeBuffer(std::string_view data, VibratePackage &patternPackage)
+{
+    channelNumber_ = 0;
+    channelSize_ = 0;
+    version_ = 0.0;
+    JsonStreamReader reader(data);
+    bool hasMetadata = false;
+    bool hasChannels = false;
+    VibratePattern originPattern;
+    int32_t packageDuration = 0;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasMetadata && JsonStreamReader::KeyEquals(key, "MetaData")) {
+            hasMetadata = true;
+            return ParseMetadata(reader);
+        }
+        if (!hasChannels && JsonStreamReader::KeyEquals(key, "Channels")) {
+            hasChannels = true;
+            return ParseChannels(reader, originPattern, packageDuration);
+        }
+        return SkipValue(reader);
+    });
+    if (ret != SUCCESS) {
+        MISC_HILOGE("Parse json fail");
+        return ret;
+    }
+    if (!hasMetadata || !hasChannels) {
+        MISC_HILOGE("MetaData or Channels is missing");
+        return ERROR;
+    }
+    if (channelSize_ != channelNumber_) {
+        MISC_HILOGE("The size of channels conflicts with channelNumber, size:%{public}d", channelSize_);
+        return ERROR;
+    }
+    patternPackage.packageDuration = packageDuration;
+    MISC_HILOGD("packageDuration:%{public}d", patternPackage.packageDuration);
+    std::sort(originPattern.events.begin(), originPattern.events.end());
+    DefaultVibratorDecoder::PatternSplit(originPattern, patternPackage);
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseMetadata(JsonStreamReader &reader)
+{
+    bool hasVersion = false;
+    bool hasChannelNumber = false;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasVersion && JsonStreamReader::KeyEquals(key, "Version")) {
+            hasVersion = true;
+            if ((ReadDouble(reader, version_) != SUCCESS) || (version_ != SUPPORT_JSON_VERSION)) {
+                MISC_HILOGE("Json file version is not supported, version:%{public}f", version_);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        if (!hasChannelNumber && JsonStreamReader::KeyEquals(key, "ChannelNumber")) {
+            hasChannelNumber = true;
+            if ((ReadInt(reader, channelNumber_) != SUCCESS) || (channelNumber_ <= 0) ||
+                (channelNumber_ >= SUPPORT_CHANNEL_NUMBER)) {
+                MISC_HILOGE("Json file channelNumber is not supported, channelNumber:%{public}d", channelNumber_);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse metadata fail");
+    CHKCR((hasVersion && hasChannelNumber), ERROR, "metadata is incomplete");
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseChannels(JsonStreamReader &reader, VibratePattern &originPattern,
+    int32_t &packageDuration)
+{
+    if (reader.PeekType() != JsonValueType::ARRAY) {
+        MISC_HILOGE("The value of channels is not array");
+        return ERROR;
+    }
+    return reader.ForEachElement([&](size_t index) -> int32_t {
+        // A valid channelNumber is below SUPPORT_CHANNEL_NUMBER, so any further channel cannot match it.
+        if (index >= static_cast<size_t>(SUPPORT_CHANNEL_NUMBER - 1)) {
+            MISC_HILOGE("The size of channels is out of bounds");
+            return ERROR;
+        }
+        ++channelSize_;
+        int32_t patternDuration = 0;
+        int32_t ret = ParseChannel(reader, originPattern, patternDuration);
+        CHKCR((ret == SUCCESS), ERROR, "parse channel fail");
+        packageDuration += patternDuration;
+        return SUCCESS;
+    });
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseChannel(JsonStreamReader &reader, VibratePattern &originPattern,
+    int32_t &patternDuration)
+{
+    bool hasParameters = false;
+    bool hasPattern = false;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasParameters && JsonStreamReader::KeyEquals(key, "Parameters")) {
+            hasParameters = true;
+            return ParseChannelParameters(reader);
+        }
+        if (!hasPattern && JsonStreamReader::KeyEquals(key, "Pattern")) {
+            hasPattern = true;
+            return ParsePattern(reader, originPattern, patternDuration);
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse channel members fail");
+    CHKCR((hasParameters && hasPattern), ERROR, "channel is incomplete");
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseChannelParameters(JsonStreamReader &reader)
+{
+    bool hasIndex = false;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasIndex && JsonStreamReader::KeyEquals(key, "Index")) {
+            hasIndex = true;
+            int32_t indexVal = 0;
+            CHKCR((ReadInt(reader, indexVal) == SUCCESS), ERROR, "invalid channel index");
+            CHKCR((indexVal >= 0) && (indexVal < SUPPORT_CHANNEL_NUMBER), ERROR, "invalid channel index");
+            return SUCCESS;
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS) && hasIndex, ERROR, "parse channel parameters fail");
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::ParsePattern(JsonStreamReader &reader, VibratePattern &originPattern,
+    int32_t &patternDuration)
+{
+    if (reader.PeekType() != JsonValueType::ARRAY) {
+        MISC_HILOGE("The value of pattern is not array");
+        return ERROR;
+    }
+    return reader.ForEachElement([&](size_t index) -> int32_t {
+        if (index >= EVENT_NUM_MAX) {
+            MISC_HILOGE("The size of pattern is out of bounds");
+            return ERROR;
+        }
+        bool hasEvent = false;
+        VibrateEvent event;
+        int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+            if (!hasEvent && JsonStreamReader::KeyEquals(key, "Event")) {
+                hasEvent = true;
+                return ParseEvent(reader, event);
+            }
+            return SkipValue(reader);
+        });
+        CHKCR((ret == SUCCESS) && hasEvent, ERROR, "parse event fail");
+        patternDuration += event.duration;
+        originPattern.events.emplace_back(std::move(event));
+        return SUCCESS;
+    });
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseEvent(JsonStreamReader &reader, VibrateEvent &event)
+{
+    EventFields fields;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        return ParseEventMember(reader, key, event, fields);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse event members fail");
+    return CheckEvent(event, fields);
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseEventMember(JsonStreamReader &reader, const std::string &key,
+    VibrateEvent &event, EventFields &fields)
+{
+    if (!fields.hasType && JsonStreamReader::KeyEquals(key, "Type")) {
+        fields.hasType = true;
+        std::string type;
+        if ((reader.PeekType() != JsonValueType::STRING) || !reader.ReadString(type)) {
+            MISC_HILOGE("The event type is not string");
+            return ERROR;
+        }
+        if (type == "continuous") {
+            event.tag = EVENT_TAG_CONTINUOUS;
+        } else if (type == "transient") {
+            event.tag = EVENT_TAG_TRANSIENT;
+        } else {
+            MISC_HILOGE("Unknown event type, curType:%{public}s", type.c_str());
+            return ERROR;
+        }
+        return SUCCESS;
+    }
+    if (!fields.hasDuration && JsonStreamReader::KeyEquals(key, "Duration")) {
+        fields.hasDuration = true;
+        // A transient event ignores its duration, so the type is only enforced once the event is complete.
+        if (reader.PeekType() != JsonValueType::NUMBER) {
+            return SkipValue(reader);
+        }
+        fields.isDurationNumber = true;
+        return ReadInt(reader, event.duration);
+    }
+    if (!fields.hasStartTime && JsonStreamReader::KeyEquals(key, "StartTime")) {
+        fields.hasStartTime = true;
+        return ReadInt(reader, event.time);
+    }
+    if (!fields.hasParameters && JsonStreamReader::KeyEquals(key, "Parameters")) {
+        fields.hasParameters = true;
+        return ParseEventParameters(reader, event, fields);
+    }
+    return SkipValue(reader);
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseEventParameters(JsonStreamReader &reader, VibrateEvent &event,
+    EventFields &fields)
+{
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!fields.hasIntensity && JsonStreamReader::KeyEquals(key, "Intensity")) {
+            fields.hasIntensity = true;
+            return ReadInt(reader, event.intensity);
+        }
+        if (!fields.hasFrequency && JsonStreamReader::KeyEquals(key, "Frequency")) {
+            fields.hasFrequency = true;
+            return ReadInt(reader, event.frequency);
+        }
+        if (!fields.hasCurve && JsonStreamReader::KeyEquals(key, "Curve")) {
+            fields.hasCurve = true;
+            if (!fields.hasType) {
+                fields.curveDepth = reader.GetDepth();
+                return reader.CaptureValue(fields.rawCurve) ? SUCCESS : ERROR;
+            }
+            return (event.tag == EVENT_TAG_CONTINUOUS) ? ParseCurve(reader, event) : SkipValue(reader);
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse event parameters fail");
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::CheckEvent(VibrateEvent &event, const EventFields &fields)
+{
+    if (!fields.hasType || !fields.hasStartTime || !fields.hasParameters || !fields.hasIntensity ||
+        !fields.hasFrequency) {
+        MISC_HILOGE("The event is incomplete");
+        return ERROR;
+    }
+    if (event.tag == EVENT_TAG_TRANSIENT) {
+        event.duration = TRANSIENT_VIBRATION_DURATION;
+        event.points.clear();
+    } else if (!fields.isDurationNumber) {
+        MISC_HILOGE("The duration of continuous event is missing");
+        return ERROR;
+    }
+    if (!DefaultVibratorDecoder::CheckEventParameters(event)) {
+        MISC_HILOGE("Parameter check of vibration event failed, startTime:%{public}d", event.time);
+        return ERROR;
+    }
+    if ((event.tag != EVENT_TAG_CONTINUOUS) || !fields.hasCurve) {
+        return SUCCESS;
+    }
+    if (!fields.rawCurve.empty()) {
+        JsonStreamReader curveReader(fields.rawCurve, fields.curveDepth);
+        CHKCR((ParseCurve(curveReader, event) == SUCCESS), ERROR, "parse curve fail");
+    }
+    // The duration may follow the curve in the file, so this is the only check that waits for the whole event.
+    for (const auto &point : event.points) {
+        if (point.time > event.duration) {
+            MISC_HILOGE("The time of curve point is out of bounds, time:%{public}d", point.time);
+            return ERROR;
+        }
+    }
+    std::sort(event.points.begin(), event.points.end());
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseCurve(JsonStreamReader &reader, VibrateEvent &event)
+{
+    if (reader.PeekType() != JsonValueType::ARRAY) {
+        MISC_HILOGE("The value of curve is not array");
+        return ERROR;
+    }
+    int32_t ret = reader.ForEachElement([&](size_t index) -> int32_t {
+        if (index >= CURVE_POINT_MAX) {
+            MISC_HILOGE("The size of curve point is out of bounds");
+            return ERROR;
+        }
+        VibrateCurvePoint point;
+        CHKCR((ParseCurvePoint(reader, point) == SUCCESS), ERROR, "parse curve point fail");
+        event.points.emplace_back(point);
+        return SUCCESS;
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse curve fail");
+    if (event.points.size() < CURVE_POINT_MIN) {
+        MISC_HILOGE("The size of curve point is out of bounds, size:%{public}zu", event.points.size());
+        return ERROR;
+    }
+    return SUCCESS;
+}
+
+int32_t DefaultVibratorStreamDecoder::ParseCurvePoint(JsonStreamReader &reader, VibrateCurvePoint &point)
+{
+    bool hasTime = false;
+    bool hasIntensity = false;
+    bool hasFrequency = false;
+    int32_t ret = reader.ForEachMember([&](const std::string &key) -> int32_t {
+        if (!hasTime && JsonStreamReader::KeyEquals(key, "Time")) {
+            hasTime = true;
+            if ((ReadInt(reader, point.time) != SUCCESS) || (point.time < 0)) {
+                MISC_HILOGE("The time of curve point is out of bounds, time:%{public}d", point.time);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        if (!hasIntensity && JsonStreamReader::KeyEquals(key, "Intensity")) {
+            hasIntensity = true;
+            double intensity = 0.0;
+            if ((ReadDouble(reader, intensity) != SUCCESS) || !ScaleCurveIntensity(intensity, point.intensity) ||
+                (point.intensity < CURVE_INTENSITY_MIN) || (point.intensity > CURVE_INTENSITY_MAX)) {
+                MISC_HILOGE("The intensity of curve point is out of bounds, intensity:%{public}d", point.intensity);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        if (!hasFrequency && JsonStreamReader::KeyEquals(key, "Frequency")) {
+            hasFrequency = true;
+            if ((ReadInt(reader, point.frequency) != SUCCESS) || (point.frequency < CURVE_FREQUENCY_MIN) ||
+                (point.frequency > CURVE_FREQUENCY_MAX)) {
+                MISC_HILOGE("The frequency of curve point is out of bounds, frequency:%{public}d", point.frequency);
+                return ERROR;
+            }
+            return SUCCESS;
+        }
+        return SkipValue(reader);
+    });
+    CHKCR((ret == SUCCESS), ERROR, "parse curve point members fail");
+    CHKCR((hasTime && hasIntensity && hasFrequency), ERROR, "curve point is incomplete");
+    return SUCCESS;
+}
+}  // namespace Sensors
+}  // namespace OHOS
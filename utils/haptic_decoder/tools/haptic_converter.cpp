@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "binary_haptic_format.h"
+#include "default_vibrator_stream_decoder.h"
+#include "file_utils.h"
+#include "he_vibrator_stream_decoder.h"
+#include "sensors_errors.h"
+
+#undef LOG_TAG
+#define LOG_TAG "HapticConverter"
+
+using namespace OHOS::Sensors;
+
+namespace {
+constexpr int32_t ARG_COUNT = 3;
+constexpr int32_t ARG_INPUT = 1;
+constexpr int32_t ARG_OUTPUT = 2;
+constexpr mode_t OUTPUT_FILE_MODE = 0644;
+
+int32_t DecodeTextFile(const std::string &path, VibratePackage &pkg)
+{
+    int32_t fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Open %s fail\n", path.c_str());
+        return ERROR;
+    }
+    RawFileDescriptor rawFd = { .fd = fd, .offset = 0, .length = GetFileSize(fd) };
+    std::string data = ReadFd(rawFd);
+    close(fd);
+    if (data.empty()) {
+        fprintf(stderr, "Read %s fail\n", path.c_str());
+        return ERROR;
+    }
+    if (CheckFileExtendName(path, "he")) {
+        HEVibratorStreamDecoder decoder;
+        return decoder.DecodeBuffer(data, pkg);
+    }
+    if (CheckFileExtendName(path, "json")) {
+        DefaultVibratorStreamDecoder decoder;
+        return decoder.DecodeBuffer(data, pkg);
+    }
+    fprintf(stderr, "Unsupported input %s, expect .json or .he\n", path.c_str());
+    return ERROR;
+}
+
+int32_t WriteFile(const std::string &path, const std::vector<uint8_t> &buffer)
+{
+    int32_t fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, OUTPUT_FILE_MODE);
+    if (fd < 0) {
+        fprintf(stderr, "Open %s fail\n", path.c_str());
+        return ERROR;
+    }
+    size_t written = 0;
+    while (written < buffer.size()) {
+        ssize_t ret = write(fd, buffer.data() + written, buffer.size() - written);
+        if (ret <= 0) {
+            fprintf(stderr, "Write %s fail\n", path.c_str());
+            close(fd);
+            return ERROR;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return (close(fd) == 0) ? SUCCESS : ERROR;
+}
+}  // namespace
+
+/*
+ * Compiles a .json or .he effect into the .ohb container read by BinaryVibratorDecoder:
+ *   haptic_converter <input.json|input.he> <output.ohb>
+ * The input goes through the same decoders the service uses, so a converted file plays
+ * exactly like its source. Inputs outside the container bounds, such as .he patterns that
+ * start after 1800000 ms, are rejected instead of written.
+ */
+int main(int argc, char *argv[])
+{
+    if (argc != ARG_COUNT) {
+        fprintf(stderr, "Usage: %s <input.json|input.he> <output.%s>\n", argv[0], BINARY_HAPTIC_EXTENSION.c_str());
+        return 1;
+    }
+    VibratePackage pkg;
+    if (DecodeTextFile(argv[ARG_INPUT], pkg) != SUCCESS) {
+        fprintf(stderr, "Decode %s fail\n", argv[ARG_INPUT]);
+        return 1;
+    }
+    std::vector<uint8_t> buffer;
+    if (EncodeBinaryHaptic(pkg, buffer) != SUCCESS) {
+        fprintf(stderr, "Encode %s fail, the effect is outside the %s bounds\n", argv[ARG_INPUT],
+            BINARY_HAPTIC_EXTENSION.c_str());
+        return 1;
+    }
+    if (WriteFile(argv[ARG_OUTPUT], buffer) != SUCCESS) {
+        return 1;
+    }
+    return 0;
+}